@@ -165,6 +165,25 @@ void fact_set_operation_timeout (fact_reasoning_kernel *k,
 	k->p->setOperationTimeout(timeout);
 }
 
+int fact_get_statistic_size (void)
+{
+	return TReasoningStatistic::size();
+}
+const char *fact_get_statistic_name (int n)
+{
+	return n < 0 ? NULL : TReasoningStatistic::getName(n);
+}
+int fact_is_statistic_timer (int n)
+{
+	return n >= 0 && TReasoningStatistic::isTimer(n);
+}
+void fact_get_statistic (fact_reasoning_kernel *k, double *values, int last_query)
+{
+	TReasoningStatistic stat = last_query ? k->p->getLastQueryStatistic() : k->p->getReasoningStatistic();
+	for ( unsigned int i = 0; i < TReasoningStatistic::size(); ++i )
+		values[i] = stat[i];
+}
+
 int fact_new_kb (fact_reasoning_kernel *k)
 {
 	return k->p->newKB();
@@ -447,6 +466,19 @@ int fact_is_subsumed_by (fact_reasoning_kernel *k, fact_concept_expression *c,
 {
 	return k->p->isSubsumedBy(c->p,d->p);
 }
+void fact_is_subsumed_by_batch (fact_reasoning_kernel *k,
+		fact_concept_expression **c,
+		fact_concept_expression **d, int n, int *results)
+{
+	ReasoningKernel::TConceptExprPairVec queries;
+	queries.reserve(n);
+	for ( int i = 0; i < n; ++i )
+		queries.push_back(std::make_pair(c[i]->p,d[i]->p));
+	std::vector<bool> answers;
+	k->p->isSubsumedBy ( queries, answers );
+	for ( int i = 0; i < n; ++i )
+		results[i] = answers[i];
+}
 int fact_is_disjoint (fact_reasoning_kernel *k, fact_concept_expression *c,
 		fact_concept_expression *d)
 {
@@ -85,6 +85,14 @@ void fact_set_top_bottom_role_names (fact_reasoning_kernel *,
 void fact_set_operation_timeout (fact_reasoning_kernel *,
 		unsigned long timeout);
 
+/* reasoning statistic: named counters and timers (in seconds) */
+int fact_get_statistic_size (void);
+const char *fact_get_statistic_name (int n);
+int fact_is_statistic_timer (int n);
+/* fill VALUES (of size fact_get_statistic_size()) with the values gathered
+   since the KB was loaded or during the last query if LAST_QUERY is non-zero */
+void fact_get_statistic (fact_reasoning_kernel *, double *values, int last_query);
+
 int fact_new_kb (fact_reasoning_kernel *);
 int fact_release_kb (fact_reasoning_kernel *);
 int fact_clear_kb (fact_reasoning_kernel *);
@@ -199,6 +207,10 @@ int fact_is_sub_chain (fact_reasoning_kernel *, fact_o_role_expression *r);
 int fact_is_satisfiable (fact_reasoning_kernel *, fact_concept_expression *c);
 int fact_is_subsumed_by (fact_reasoning_kernel *, fact_concept_expression *c,
 		fact_concept_expression *d);
+/* answer N queries C[i] [= D[i] at once; RESULTS[i] gets the answer to the i-th one */
+void fact_is_subsumed_by_batch (fact_reasoning_kernel *,
+		fact_concept_expression **c,
+		fact_concept_expression **d, int n, int *results);
 int fact_is_disjoint (fact_reasoning_kernel *, fact_concept_expression *c,
 		fact_concept_expression *d);
 int fact_is_equivalent (fact_reasoning_kernel *, fact_concept_expression *c,
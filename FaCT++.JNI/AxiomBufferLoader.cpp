@@ -0,0 +1,457 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <cstring>
+
+#include "AxiomBufferLoader.h"
+
+TDLDataExpression*
+getBuiltInDataType ( TExpressionManager* EM, const std::string& DTName )
+{
+	if ( DTName == "http://www.w3.org/2000/01/rdf-schema#Literal" ||
+		 DTName == "http://www.w3.org/2000/01/rdf-schema#anySimpleType" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#anyType" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#anySimpleType" )
+		return EM->DataTop();
+
+	if ( DTName == "http://www.w3.org/1999/02/22-rdf-syntax-ns#PlainLiteral" ||
+		 DTName == "http://www.w3.org/1999/02/22-rdf-syntax-ns#XMLLiteral" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#string" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#anyURI" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#ID" )
+		return EM->getStrDataType();
+
+	if ( DTName == "http://www.w3.org/2001/XMLSchema#integer" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#int" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#long" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#nonNegativeInteger" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#positiveInteger" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#negativeInteger" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#short" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#byte" )
+		return EM->getIntDataType();
+
+	if ( DTName == "http://www.w3.org/2001/XMLSchema#float" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#double" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#real" ||
+		 DTName == "http://www.w3.org/2001/XMLSchema#decimal" )
+		return EM->getRealDataType();
+
+	if ( DTName == "http://www.w3.org/2001/XMLSchema#boolean" )
+		return EM->getBoolDataType();
+
+	if ( DTName == "http://www.w3.org/2001/XMLSchema#dateTimeAsLong" )
+		return EM->getTimeDataType();
+
+	return NULL;
+}
+
+void
+TAxiomBufferLoader :: malformed ( const char* reason )
+{
+	throw EFaCTPlusPlus(reason);
+}
+
+int
+TAxiomBufferLoader :: readInt ( void )
+{
+	if ( unlikely(end - cur < (long)sizeof(int)) )
+		malformed("Unexpected end of axiom buffer");
+	int ret;
+	memcpy ( &ret, cur, sizeof(int) );
+	cur += sizeof(int);
+	return ret;
+}
+
+unsigned int
+TAxiomBufferLoader :: readNumber ( void )
+{
+	int n = readInt();
+	if ( unlikely(n < 0) )
+		malformed("Negative number in axiom buffer");
+	return (unsigned int)n;
+}
+
+std::string
+TAxiomBufferLoader :: readString ( void )
+{
+	unsigned int len = readNumber();
+	if ( unlikely((unsigned long)(end - cur) < len) )
+		malformed("Unexpected end of axiom buffer");
+	std::string ret ( cur, len );
+	cur += len;
+	return ret;
+}
+
+TAxiomBufferLoader::TExpr*
+TAxiomBufferLoader :: readExpr ( void )
+{
+	unsigned int n = readNumber();
+	if ( unlikely(n >= nExprs) )
+		malformed("Forward or dangling expression reference in axiom buffer");
+	return Exprs[n];
+}
+
+TAxiomBufferLoader::TExpr*
+TAxiomBufferLoader :: loadExpr ( unsigned char op )
+{
+	typedef const TDLConceptExpression CE;
+	typedef const TDLIndividualExpression IE;
+	typedef const TDLObjectRoleExpression RE;
+	typedef const TDLDataRoleExpression DRE;
+	typedef const TDLDataExpression DE;
+	typedef const TDLDataValue DV;
+
+	switch ( op )
+	{
+	// concept expressions
+	case opTop:
+		return EM->Top();
+	case opBottom:
+		return EM->Bottom();
+	case opConcept:
+		return EM->Concept(readString());
+	case opNot:
+		return EM->Not(read<CE>());
+	case opAnd:
+		readArgList<CE>();
+		return EM->And();
+	case opOr:
+		readArgList<CE>();
+		return EM->Or();
+	case opOneOf:
+		readArgList<const TDLIndividualName>();
+		return EM->OneOf();
+	case opObjectSome:
+	{
+		RE* R = read<RE>();
+		return EM->Exists ( R, read<CE>() );
+	}
+	case opObjectAll:
+	{
+		RE* R = read<RE>();
+		return EM->Forall ( R, read<CE>() );
+	}
+	case opObjectValue:
+	{
+		RE* R = read<RE>();
+		return EM->Value ( R, read<IE>() );
+	}
+	case opSelf:
+		return EM->SelfReference(read<RE>());
+	case opObjectMin:
+	case opObjectMax:
+	case opObjectExact:
+	{
+		unsigned int n = readNumber();
+		RE* R = read<RE>();
+		CE* C = read<CE>();
+		if ( op == opObjectMin )
+			return EM->MinCardinality ( n, R, C );
+		if ( op == opObjectMax )
+			return EM->MaxCardinality ( n, R, C );
+		return EM->Cardinality ( n, R, C );
+	}
+	case opDataSome:
+	{
+		DRE* A = read<DRE>();
+		return EM->Exists ( A, read<DE>() );
+	}
+	case opDataAll:
+	{
+		DRE* A = read<DRE>();
+		return EM->Forall ( A, read<DE>() );
+	}
+	case opDataHasValue:
+	{
+		DRE* A = read<DRE>();
+		return EM->Value ( A, read<DV>() );
+	}
+	case opDataMin:
+	case opDataMax:
+	case opDataExact:
+	{
+		unsigned int n = readNumber();
+		DRE* A = read<DRE>();
+		DE* E = read<DE>();
+		if ( op == opDataMin )
+			return EM->MinCardinality ( n, A, E );
+		if ( op == opDataMax )
+			return EM->MaxCardinality ( n, A, E );
+		return EM->Cardinality ( n, A, E );
+	}
+
+	// individual and role expressions
+	case opIndividual:
+		return EM->Individual(readString());
+	case opObjectRole:
+		return EM->ObjectRole(readString());
+	case opInverse:
+		return EM->Inverse(read<RE>());
+	case opCompose:
+		readArgList<RE>();
+		return EM->Compose();
+	case opDataRole:
+		return EM->DataRole(readString());
+
+	// data expressions
+	case opDataTop:
+		return EM->DataTop();
+	case opBuiltInDataType:
+	{
+		TDLDataExpression* ret = getBuiltInDataType ( EM, readString() );
+		if ( unlikely(ret == NULL) )
+			malformed("Unsupported datatype in axiom buffer");
+		return ret;
+	}
+	case opDataValue:
+	{
+		std::string value = readString();
+		return EM->DataValue ( value, readDataType() );
+	}
+	case opDataNot:
+		return EM->DataNot(read<DE>());
+	case opDataAnd:
+		readArgList<DE>();
+		return EM->DataAnd();
+	case opDataOr:
+		readArgList<DE>();
+		return EM->DataOr();
+	case opDataOneOf:
+		readArgList<DV>();
+		return EM->DataOneOf();
+	case opRestrictedType:
+	{
+		TDLDataTypeExpression* T = readDataType();
+		return EM->RestrictedType ( T, read<const TDLFacetExpression>() );
+	}
+	case opFacetMinExclusive:
+		return EM->FacetMinExclusive(read<DV>());
+	case opFacetMaxExclusive:
+		return EM->FacetMaxExclusive(read<DV>());
+	case opFacetMinInclusive:
+		return EM->FacetMinInclusive(read<DV>());
+	case opFacetMaxInclusive:
+		return EM->FacetMaxInclusive(read<DV>());
+
+	default:	// not an expression
+		return NULL;
+	}
+}
+
+TDLAxiom*
+TAxiomBufferLoader :: loadAxiom ( unsigned char op )
+{
+	typedef ReasoningKernel::TConceptExpr CE;
+	typedef ReasoningKernel::TIndividualExpr IE;
+	typedef ReasoningKernel::TORoleExpr RE;
+	typedef ReasoningKernel::TDRoleExpr DRE;
+
+// all the arguments should be read before; the axiom is told only if the record is not just checked
+#	define TELL(axiom) return checkOnly ? NULL : Kernel->axiom
+
+	switch ( op )
+	{
+	case opDeclaration:
+	{
+		TExpr* X = readExpr();
+		TELL(declare(X));
+	}
+	case opSubClassOf:
+	{
+		CE* C = read<CE>();
+		CE* D = read<CE>();
+		TELL(impliesConcepts ( C, D ));
+	}
+	case opEquivalentClasses:
+		readArgList<CE>();
+		TELL(equalConcepts());
+	case opDisjointClasses:
+		readArgList<CE>();
+		TELL(disjointConcepts());
+	case opDisjointUnion:
+	{
+		CE* C = read<CE>();
+		readArgList<CE>();
+		TELL(disjointUnion(C));
+	}
+	case opSubObjectProperty:
+	{
+		ReasoningKernel::TORoleComplexExpr* R = read<ReasoningKernel::TORoleComplexExpr>();
+		RE* S = read<RE>();
+		TELL(impliesORoles ( R, S ));
+	}
+	case opEquivalentObjectProperties:
+		readArgList<RE>();
+		TELL(equalORoles());
+	case opDisjointObjectProperties:
+		readArgList<RE>();
+		TELL(disjointORoles());
+	case opInverseProperties:
+	{
+		RE* R = read<RE>();
+		RE* S = read<RE>();
+		TELL(setInverseRoles ( R, S ));
+	}
+	case opObjectDomain:
+	{
+		RE* R = read<RE>();
+		CE* C = read<CE>();
+		TELL(setODomain ( R, C ));
+	}
+	case opObjectRange:
+	{
+		RE* R = read<RE>();
+		CE* C = read<CE>();
+		TELL(setORange ( R, C ));
+	}
+	case opFunctional:
+	case opInverseFunctional:
+	case opSymmetric:
+	case opAsymmetric:
+	case opReflexive:
+	case opIrreflexive:
+	case opTransitive:
+	{
+		RE* R = read<RE>();
+		if ( checkOnly )
+			return NULL;
+		switch ( op )
+		{
+		case opFunctional:
+			return Kernel->setOFunctional(R);
+		case opInverseFunctional:
+			return Kernel->setInverseFunctional(R);
+		case opSymmetric:
+			return Kernel->setSymmetric(R);
+		case opAsymmetric:
+			return Kernel->setAsymmetric(R);
+		case opReflexive:
+			return Kernel->setReflexive(R);
+		case opIrreflexive:
+			return Kernel->setIrreflexive(R);
+		default:
+			return Kernel->setTransitive(R);
+		}
+	}
+	case opSubDataProperty:
+	{
+		DRE* A = read<DRE>();
+		DRE* B = read<DRE>();
+		TELL(impliesDRoles ( A, B ));
+	}
+	case opEquivalentDataProperties:
+		readArgList<DRE>();
+		TELL(equalDRoles());
+	case opDisjointDataProperties:
+		readArgList<DRE>();
+		TELL(disjointDRoles());
+	case opDataDomain:
+	{
+		DRE* A = read<DRE>();
+		CE* C = read<CE>();
+		TELL(setDDomain ( A, C ));
+	}
+	case opDataRange:
+	{
+		DRE* A = read<DRE>();
+		ReasoningKernel::TDataExpr* E = read<ReasoningKernel::TDataExpr>();
+		TELL(setDRange ( A, E ));
+	}
+	case opDataFunctional:
+	{
+		DRE* A = read<DRE>();
+		TELL(setDFunctional(A));
+	}
+	case opInstanceOf:
+	{
+		IE* I = read<IE>();
+		CE* C = read<CE>();
+		TELL(instanceOf ( I, C ));
+	}
+	case opRelated:
+	case opNotRelated:
+	{
+		IE* I = read<IE>();
+		RE* R = read<RE>();
+		IE* J = read<IE>();
+		if ( op == opRelated )
+			TELL(relatedTo ( I, R, J ));
+		TELL(relatedToNot ( I, R, J ));
+	}
+	case opValueOf:
+	case opNotValueOf:
+	{
+		IE* I = read<IE>();
+		DRE* A = read<DRE>();
+		ReasoningKernel::TDataValueExpr* V = read<ReasoningKernel::TDataValueExpr>();
+		if ( op == opValueOf )
+			TELL(valueOf ( I, A, V ));
+		TELL(valueOfNot ( I, A, V ));
+	}
+	case opSameIndividuals:
+		readArgList<IE>();
+		TELL(processSame());
+	case opDifferentIndividuals:
+		readArgList<IE>();
+		TELL(processDifferent());
+
+	default:
+		malformed("Unknown opcode in axiom buffer");
+		return NULL;
+	}
+
+#	undef TELL
+}
+
+void
+TAxiomBufferLoader :: load ( const void* buf, size_t len, AxiomVector& axioms )
+{
+	const char* begin = static_cast<const char*>(buf);
+	end = begin + len;
+	Exprs.clear();
+	AxiomRecords.clear();
+
+	// first pass: build all the expressions and check the axiom records
+	for ( cur = begin; cur < end; )
+	{
+		const char* start = cur;
+		nExprs = Exprs.size();
+		unsigned char op = static_cast<unsigned char>(*cur++);
+		checkOnly = false;
+		TExpr* expr = loadExpr(op);
+		if ( expr != NULL )
+			Exprs.push_back(expr);
+		else
+		{
+			AxiomRecords.push_back(std::make_pair(start,nExprs));
+			checkOnly = true;
+			loadAxiom(op);
+		}
+	}
+
+	// second pass: the buffer is correct, so tell all the axioms
+	checkOnly = false;
+	for ( std::vector<AxiomRecord>::const_iterator p = AxiomRecords.begin(), p_end = AxiomRecords.end(); p != p_end; ++p )
+	{
+		cur = p->first;
+		nExprs = p->second;
+		unsigned char op = static_cast<unsigned char>(*cur++);
+		axioms.push_back(loadAxiom(op));
+	}
+}
@@ -0,0 +1,219 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef AXIOMBUFFERLOADER_H
+#define AXIOMBUFFERLOADER_H
+
+#include <string>
+#include <vector>
+
+#include "Kernel.h"
+
+/// get a built-in datatype by its NAME; @return NULL if the datatype is not supported
+TDLDataExpression* getBuiltInDataType ( TExpressionManager* EM, const std::string& name );
+
+/**
+ *	Loader of the expressions and axioms from a compact binary buffer.
+ *
+ *	The buffer is a sequence of records; every record starts with a 1-byte
+ *	opcode followed by its operands. All operands are 32-bit integers in the
+ *	native byte order: an expression reference is an index of an expression
+ *	record in the buffer (counting from 0), a string is its byte length
+ *	followed by UTF-8 bytes, a list is its length followed by references.
+ *	Every expression record defines the next expression index; every axiom
+ *	record adds the created axiom to the result. The whole buffer is checked
+ *	before the first axiom is told, so a malformed buffer adds no axioms;
+ *	the expressions (and names) built before the error stay in the
+ *	expression manager.
+ *
+ *	The opcode values are shared with uk.ac.manchester.cs.factplusplus.AxiomBuffer
+ *	and should never be renumbered.
+ */
+class TAxiomBufferLoader
+{
+public:		// types
+		/// record opcodes
+	enum OpCode
+	{
+		// concept expressions
+		opTop = 1,					// -
+		opBottom = 2,				// -
+		opConcept = 3,				// name
+		opNot = 4,					// C
+		opAnd = 5,					// [C]
+		opOr = 6,					// [C]
+		opOneOf = 7,				// [I]
+		opObjectSome = 8,			// R C
+		opObjectAll = 9,			// R C
+		opObjectValue = 10,			// R I
+		opSelf = 11,				// R
+		opObjectMin = 12,			// n R C
+		opObjectMax = 13,			// n R C
+		opObjectExact = 14,			// n R C
+		opDataSome = 15,			// A E
+		opDataAll = 16,				// A E
+		opDataHasValue = 17,		// A V
+		opDataMin = 18,				// n A E
+		opDataMax = 19,				// n A E
+		opDataExact = 20,			// n A E
+
+		// individual and role expressions
+		opIndividual = 21,			// name
+		opObjectRole = 22,			// name
+		opInverse = 23,				// R
+		opCompose = 24,				// [R]
+		opDataRole = 25,			// name
+
+		// data expressions
+		opDataTop = 26,				// -
+		opBuiltInDataType = 27,		// name
+		opDataValue = 28,			// value T
+		opDataNot = 29,				// E
+		opDataAnd = 30,				// [E]
+		opDataOr = 31,				// [E]
+		opDataOneOf = 32,			// [V]
+		opRestrictedType = 33,		// T F
+		opFacetMinExclusive = 34,	// V
+		opFacetMaxExclusive = 35,	// V
+		opFacetMinInclusive = 36,	// V
+		opFacetMaxInclusive = 37,	// V
+
+		// axioms
+		opDeclaration = 64,			// X
+		opSubClassOf = 65,			// C D
+		opEquivalentClasses = 66,	// [C]
+		opDisjointClasses = 67,		// [C]
+		opDisjointUnion = 68,		// C [C]
+		opSubObjectProperty = 69,	// R S, R might be a chain
+		opEquivalentObjectProperties = 70,	// [R]
+		opDisjointObjectProperties = 71,	// [R]
+		opInverseProperties = 72,	// R S
+		opObjectDomain = 73,		// R C
+		opObjectRange = 74,			// R C
+		opFunctional = 75,			// R
+		opInverseFunctional = 76,	// R
+		opSymmetric = 77,			// R
+		opAsymmetric = 78,			// R
+		opReflexive = 79,			// R
+		opIrreflexive = 80,			// R
+		opTransitive = 81,			// R
+		opSubDataProperty = 82,		// A B
+		opEquivalentDataProperties = 83,	// [A]
+		opDisjointDataProperties = 84,	// [A]
+		opDataDomain = 85,			// A C
+		opDataRange = 86,			// A E
+		opDataFunctional = 87,		// A
+		opInstanceOf = 88,			// I C
+		opRelated = 89,				// I R J
+		opNotRelated = 90,			// I R J
+		opValueOf = 91,				// I A V
+		opNotValueOf = 92,			// I A V
+		opSameIndividuals = 93,		// [I]
+		opDifferentIndividuals = 94		// [I]
+	};
+		/// vector of created axioms
+	typedef std::vector<TDLAxiom*> AxiomVector;
+
+protected:	// types
+		/// general expression
+	typedef ReasoningKernel::TExpr TExpr;
+		/// axiom record: its start and the number of expressions defined before it
+	typedef std::pair<const char*, size_t> AxiomRecord;
+
+protected:	// members
+		/// kernel to load axioms to
+	ReasoningKernel* Kernel;
+		/// expression manager of the kernel
+	TExpressionManager* EM;
+		/// expressions defined in the buffer so far
+	std::vector<TExpr*> Exprs;
+		/// axiom records of the buffer
+	std::vector<AxiomRecord> AxiomRecords;
+		/// arguments of the list being read
+	std::vector<const TDLExpression*> Args;
+		/// number of expressions that could be referenced from the current record
+	size_t nExprs;
+		/// true if the axiom records are only checked, but not told
+	bool checkOnly;
+		/// current reading position
+	const char* cur;
+		/// end of the buffer
+	const char* end;
+
+protected:	// methods
+		/// throw an exception about the malformed buffer
+	static void malformed ( const char* reason );
+
+		/// read a raw 32-bit integer
+	int readInt ( void );
+		/// read a non-negative number
+	unsigned int readNumber ( void );
+		/// read a string
+	std::string readString ( void );
+		/// read an expression reference
+	TExpr* readExpr ( void );
+		/// read an expression reference of the type T
+	template<class T>
+	T* read ( void )
+	{
+		T* ret = dynamic_cast<T*>(readExpr());
+		if ( unlikely(ret == NULL) )
+			malformed("Unexpected expression type in axiom buffer");
+		return ret;
+	}
+		/// read a datatype expression reference
+	TDLDataTypeExpression* readDataType ( void )
+		{ return const_cast<TDLDataTypeExpression*>(read<const TDLDataTypeExpression>()); }
+		/// read a list of references of the type T into the new expression manager's arg-list (if not only checking)
+	template<class T>
+	void readArgList ( void )
+	{
+		// read all the arguments first to keep the arg-list queue intact if some of them is wrong
+		Args.clear();
+		for ( unsigned int n = readNumber(); n > 0; --n )
+			Args.push_back(read<T>());
+		if ( checkOnly )
+			return;
+		EM->newArgList();
+		for ( std::vector<const TDLExpression*>::const_iterator p = Args.begin(), p_end = Args.end(); p != p_end; ++p )
+			EM->addArg(*p);
+	}
+
+		/// build an expression by the opcode OP; @return NULL if OP is not an expression one
+	TExpr* loadExpr ( unsigned char op );
+		/// build an axiom by the opcode OP; @return NULL if the record is only checked
+	TDLAxiom* loadAxiom ( unsigned char op );
+
+public:		// interface
+		/// init c'tor
+	TAxiomBufferLoader ( ReasoningKernel* kernel )
+		: Kernel(kernel)
+		, EM(kernel->getExpressionManager())
+		, nExprs(0)
+		, checkOnly(false)
+		, cur(NULL)
+		, end(NULL)
+		{}
+		/// empty d'tor
+	~TAxiomBufferLoader ( void ) {}
+
+		/// load all the records of the buffer [BUF,BUF+LEN); put created axioms into AXIOMS
+	void load ( const void* buf, size_t len, AxiomVector& axioms );
+}; // TAxiomBufferLoader
+
+#endif
@@ -21,6 +21,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "uk_ac_manchester_cs_factplusplus_FaCTPlusPlus.h"
 #include "Kernel.h"
 #include "tJNICache.h"
+#include "AxiomBufferLoader.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -460,6 +461,57 @@ JNIEXPORT void JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_retrac
 	getK(env,obj)->retract(getAxiom(env,axiom));
 }
 
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    loadAxioms
+ * Signature: (Ljava/nio/ByteBuffer;I)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_loadAxioms
+  (JNIEnv * env, jobject obj, jobject buffer, jint length)
+{
+	TRACE_JNI("loadAxioms");
+	const void* buf = env->GetDirectBufferAddress(buffer);
+	if ( unlikely(buf == NULL) )
+	{
+		Throw ( env, "FaCT++ Kernel: axiom buffer is not a direct one" );
+		return NULL;
+	}
+	if ( unlikely(length < 0 || length > env->GetDirectBufferCapacity(buffer)) )
+	{
+		Throw ( env, "FaCT++ Kernel: incorrect axiom buffer length" );
+		return NULL;
+	}
+
+	TJNICache* J = getJ(env,obj);
+	TAxiomBufferLoader::AxiomVector axioms;
+	try
+	{
+		TAxiomBufferLoader(J->K).load ( buf, (size_t)length, axioms );
+	}
+	catch ( const EFPPInconsistentKB& )
+	{ ThrowICO(J->env); return NULL; }
+	catch ( const EFPPNonSimpleRole& nsr )
+	{ ThrowNSR ( J->env, nsr.getRoleName() ); return NULL; }
+	catch ( const EFPPCycleInRIA& cir )
+	{ ThrowRIC ( J->env, cir.getRoleName() ); return NULL; }
+	catch ( const EFaCTPlusPlus& fpp )
+	{ Throw ( J->env, fpp.what() ); return NULL; }
+	catch ( const std::exception& ex )
+	{ Throw ( J->env, ex.what() ); return NULL; }
+
+	// axiom handles are the same values the AxiomPointer objects keep in their 'node' field
+	jlongArray ret = env->NewLongArray(axioms.size());
+	if ( unlikely(ret == NULL) )
+		return NULL;
+	std::vector<jlong> handles;
+	handles.reserve(axioms.size());
+	for ( TAxiomBufferLoader::AxiomVector::const_iterator p = axioms.begin(), p_end = axioms.end(); p != p_end; ++p )
+		handles.push_back((jlong)*p);
+	if ( !handles.empty() )
+		env->SetLongArrayRegion ( ret, 0, handles.size(), &handles[0] );
+	return ret;
+}
+
 #undef PROCESS_QUERY
 
 #ifdef __cplusplus
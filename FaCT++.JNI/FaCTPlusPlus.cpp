@@ -33,6 +33,8 @@ extern "C" {
 
 /// field for Kernel's ID
 jfieldID KernelFID;
+/// field for the Pointer's node
+jfieldID NodeFID;
 
 /*
  * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
@@ -49,6 +51,19 @@ JNIEXPORT void JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_initMe
 		Throw ( env, "Can't get 'KernelId' field" );
 		return;
 	}
+
+	jclass pointer = env->FindClass("uk/ac/manchester/cs/factplusplus/Pointer");
+	if ( pointer == 0 )
+	{
+		Throw ( env, "Can't get class for Pointer" );
+		return;
+	}
+	NodeFID = env->GetFieldID ( pointer, "node", "J" );
+	if ( NodeFID == 0 )
+	{
+		Throw ( env, "Can't get 'node' field" );
+		return;
+	}
 	MemoryStatistics MS("init JNI");
 }
 
@@ -238,6 +253,47 @@ JNIEXPORT jobjectArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlu
 	return J->buildArray ( J->K->getTrace(), J->AxiomPointer );
 }
 
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    getStatisticNames
+ * Signature: ()[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_getStatisticNames
+  (JNIEnv * env, jobject obj ATTR_UNUSED)
+{
+	TRACE_JNI("getStatisticNames");
+	unsigned int sz = TReasoningStatistic::size();
+	jobjectArray ret = env->NewObjectArray ( sz, env->FindClass("java/lang/String"), NULL );
+	for ( unsigned int i = 0; i < sz; ++i )
+	{
+		jstring name = env->NewStringUTF(TReasoningStatistic::getName(i));
+		env->SetObjectArrayElement ( ret, i, name );
+		env->DeleteLocalRef(name);
+	}
+	return ret;
+}
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    getStatistic
+ * Signature: (Z)[D
+ */
+JNIEXPORT jdoubleArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_getStatistic
+  (JNIEnv * env, jobject obj, jboolean lastQuery)
+{
+	TRACE_JNI("getStatistic");
+	ReasoningKernel* K = getK(env,obj);
+	TReasoningStatistic stat = lastQuery ? K->getLastQueryStatistic() : K->getReasoningStatistic();
+	unsigned int sz = TReasoningStatistic::size();
+	jdouble* buf = new jdouble[sz];
+	for ( unsigned int i = 0; i < sz; ++i )
+		buf[i] = stat[i];
+	jdoubleArray ret = env->NewDoubleArray(sz);
+	env->SetDoubleArrayRegion ( ret, 0, sz, buf );
+	delete [] buf;
+	return ret;
+}
+
 #ifdef __cplusplus
 }
 #endif
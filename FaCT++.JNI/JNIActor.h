@@ -76,6 +76,25 @@ public:		// interface
 		return ret;
 	}
 
+	// return values as native handles
+
+		/// get single vector of synonyms as handles
+	jlongArray getSynonymHandles ( void ) const { return J->buildHandles ( acc.empty() ? SynVector() : acc[0] ); }
+		/// get all required elements of the taxonomy as handles; every group is preceded by its size unless plain
+	jlongArray getElementHandles ( void ) const
+	{
+		if ( AccessPolicy::needPlain() )
+			return J->buildHandles(plain);
+		std::vector<jlong> handles;
+		for ( typename SetOfNodes::const_iterator p = acc.begin(), p_end = acc.end(); p != p_end; ++p )
+		{
+			handles.push_back((jlong)p->size());
+			for ( typename SynVector::const_iterator q = p->begin(), q_end = p->end(); q != q_end; ++q )
+				handles.push_back((jlong)*q);
+		}
+		return J->buildHandles(handles);
+	}
+
 		/// taxonomy walking method.
 		/// @return true if node was processed, and there is no need to go further
 		/// @return false if node can not be processed in current settings
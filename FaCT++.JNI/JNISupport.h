@@ -186,27 +186,16 @@ ReasoningKernel* getK ( JNIEnv * env, jobject obj )
 	return (ReasoningKernel*)id;
 }
 
+/// field for the 'node' field of the Pointer class; valid for all its descendants
+extern "C" jfieldID NodeFID;
+
 // helper for getTree which extracts a JLONG from a given object
 inline
 jlong getPointer ( JNIEnv * env, jobject obj )
 {
-	jclass classThis = env->GetObjectClass(obj);
-
-	if ( unlikely(classThis == 0) )
-	{
-		Throw ( env, "Can't get class of 'this'" );
+	if ( unlikely(obj == 0) )
 		return 0;
-	}
-
-	jfieldID fid = env->GetFieldID ( classThis, "node", "J" );
-
-	if ( unlikely(fid == 0) )
-	{
-		Throw ( env, "Can't get 'node' field" );
-		return 0;
-	}
-
-	return env->GetLongField ( obj, fid );
+	return env->GetLongField ( obj, NodeFID );
 }
 
 // macro to expand into the accessor function that transforms pointer into appropriate type
@@ -256,6 +245,18 @@ inline TCGNode* getRONode ( JNIEnv * env, jobject obj )
 
 #undef ACCESSOR
 
+// macro to expand into the RO accessor function that transforms a handle into appropriate type
+#define ACCESSOR(Name)	\
+inline const T ## Name* getRO ## Name ( jlong handle ) {	\
+	return dynamic_cast<const T ## Name*>((const TExpr*)handle); }
+
+// accessors for the expression handles used by the primitive-array queries
+ACCESSOR(ConceptExpr)
+ACCESSOR(IndividualExpr)
+ACCESSOR(ORoleExpr)
+
+#undef ACCESSOR
+
 inline
 TDLAxiom* getAxiom ( JNIEnv * env, jobject obj )
 {
@@ -50,6 +50,12 @@ extern "C" {
 
 #define PROCESS_QUERY(Action) ASK_START Action; ASK_END
 #define PROCESS_SIMPLE_QUERY(Action) ASK_START TJNICache* J = getJ(env,obj); Action; ASK_END
+// get an expression of the type Name from the live HANDLE into VAR; return NULL if the expression is of a wrong type
+#define GET_HANDLE(Name,Var,Handle)	\
+	const T ## Name* Var = getRO ## Name(Handle);	\
+	if ( unlikely(Var == NULL) )	\
+	{ Throw ( env, "FaCT++ Kernel: wrong handle type" ); return NULL; }
+
 /*
  * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
  * Method:    isKBConsistent
@@ -137,6 +143,45 @@ JNIEXPORT jboolean JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_is
 	return ret;
 }
 
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    areClassesSubsumedBy
+ * Signature: ([Luk/ac/manchester/cs/factplusplus/ClassPointer;[Luk/ac/manchester/cs/factplusplus/ClassPointer;)[Z
+ */
+JNIEXPORT jbooleanArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_areClassesSubsumedBy
+  (JNIEnv * env, jobject obj, jobjectArray arg1, jobjectArray arg2)
+{
+	MemoryStatistics MS("areClassesSubsumedBy");
+	TRACE_JNI("areClassesSubsumedBy");
+	jsize n = env->GetArrayLength(arg1);
+	if ( env->GetArrayLength(arg2) != n )
+	{
+		Throw ( env, "Arrays of different size in areClassesSubsumedBy()" );
+		return NULL;
+	}
+	ReasoningKernel::TConceptExprPairVec queries;
+	queries.reserve(n);
+	for ( jsize i = 0; i < n; ++i )
+	{
+		jobject c = env->GetObjectArrayElement ( arg1, i );
+		jobject d = env->GetObjectArrayElement ( arg2, i );
+		queries.push_back(std::make_pair(getROConceptExpr(env,c),getROConceptExpr(env,d)));
+		env->DeleteLocalRef(c);
+		env->DeleteLocalRef(d);
+	}
+	std::vector<bool> results;
+	PROCESS_SIMPLE_QUERY ( J->K->isSubsumedBy ( queries, results ) );
+	if ( results.size() != static_cast<size_t>(n) )	// exception was thrown
+		return NULL;
+	jboolean* buf = new jboolean[n];
+	for ( jsize i = 0; i < n; ++i )
+		buf[i] = results[i];
+	jbooleanArray ret = env->NewBooleanArray(n);
+	env->SetBooleanArrayRegion ( ret, 0, n, buf );
+	delete [] buf;
+	return ret;
+}
+
 /*
  * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
  * Method:    isClassEquivalentTo
@@ -837,9 +882,130 @@ JNIEXPORT jobjectArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlu
 
 }
 
+//-------------------------------------------------------------
+// queries with handle arguments returning handle arrays
+//-------------------------------------------------------------
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askSubClassesHandles
+ * Signature: (JZ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askSubClassesHandles
+  (JNIEnv * env, jobject obj, jlong arg, jboolean direct)
+{
+	TRACE_JNI("askSubClassesHandles");
+	TJNICache* J = getJ(env,obj);
+	JTaxonomyActor<ClassPolicy> actor(J);
+	GET_HANDLE(ConceptExpr,C,arg);
+	PROCESS_QUERY ( J->K->getSubConcepts(C,direct,actor) );
+	return actor.getElementHandles();
+}
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askSuperClassesHandles
+ * Signature: (JZ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askSuperClassesHandles
+  (JNIEnv * env, jobject obj, jlong arg, jboolean direct)
+{
+	TRACE_JNI("askSuperClassesHandles");
+	TJNICache* J = getJ(env,obj);
+	JTaxonomyActor<ClassPolicy> actor(J);
+	GET_HANDLE(ConceptExpr,C,arg);
+	PROCESS_QUERY ( J->K->getSupConcepts(C,direct,actor) );
+	return actor.getElementHandles();
+}
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askEquivalentClassesHandles
+ * Signature: (J)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askEquivalentClassesHandles
+  (JNIEnv * env, jobject obj, jlong arg)
+{
+	TRACE_JNI("askEquivalentClassesHandles");
+	TJNICache* J = getJ(env,obj);
+	JTaxonomyActor<ClassPolicy> actor(J);
+	GET_HANDLE(ConceptExpr,C,arg);
+	PROCESS_QUERY ( J->K->getEquivalentConcepts ( C, actor ) );
+	return actor.getSynonymHandles();
+}
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askIndividualTypesHandles
+ * Signature: (JZ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askIndividualTypesHandles
+  (JNIEnv * env, jobject obj, jlong arg, jboolean direct)
+{
+	TRACE_JNI("askIndividualTypesHandles");
+	TJNICache* J = getJ(env,obj);
+	JTaxonomyActor<ClassPolicy> actor(J);
+	GET_HANDLE(IndividualExpr,I,arg);
+	PROCESS_QUERY ( J->K->getTypes(I,direct,actor) );
+	return actor.getElementHandles();
+}
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askInstancesHandles
+ * Signature: (JZ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askInstancesHandles
+  (JNIEnv * env, jobject obj, jlong arg, jboolean direct)
+{
+	TRACE_JNI("askInstancesHandles");
+	TJNICache* J = getJ(env,obj);
+	JTaxonomyActor<IndividualPolicy</*plain=*/true> > actor(J);
+	GET_HANDLE(ConceptExpr,C,arg);
+	PROCESS_QUERY ( direct ? J->K->getDirectInstances(C,actor) : J->K->getInstances(C,actor) );
+	return actor.getElementHandles();
+}
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askSameAsHandles
+ * Signature: (J)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askSameAsHandles
+  (JNIEnv * env, jobject obj, jlong arg)
+{
+	TRACE_JNI("askSameAsHandles");
+	TJNICache* J = getJ(env,obj);
+	JTaxonomyActor<IndividualPolicy</*plain=*/true> > actor(J);
+	GET_HANDLE(IndividualExpr,I,arg);
+	PROCESS_QUERY ( J->K->getSameAs ( I, actor ) );
+	return actor.getSynonymHandles();
+}
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askRelatedIndividualsHandles
+ * Signature: (JJ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askRelatedIndividualsHandles
+  (JNIEnv * env, jobject obj, jlong arg1, jlong arg2)
+{
+	TRACE_JNI("askRelatedIndividualsHandles");
+	GET_HANDLE(IndividualExpr,I,arg1);
+	GET_HANDLE(ORoleExpr,R,arg2);
+	TJNICache* J = getJ(env,obj);
+	ReasoningKernel::NamesVector Js;
+	PROCESS_QUERY ( J->K->getRoleFillers ( I, R, Js ) );
+	std::vector<TExpr*> acc;
+	for ( ReasoningKernel::NamesVector::const_iterator p = Js.begin(), p_end = Js.end(); p < p_end; ++p )
+		acc.push_back(J->getIName((*p)->getName()));
+	return J->buildHandles(acc);
+}
+
 
 #undef PROCESS_QUERY
 #undef PROCESS_SIMPLE_QUERY
+#undef GET_HANDLE
 
 #ifdef __cplusplus
 }
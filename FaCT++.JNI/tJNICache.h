@@ -182,13 +182,8 @@ public:		// members
 		/// d'tor: release all names
 	~TJNICache ( void ) { /*fini();*/ }
 
-		/// switch the env to a new one E
-	void reset ( JNIEnv* e )
-	{
-//		fini();
-		env = e;
-		init();
-	}
+		/// switch the env to a new one E; class global refs and field/method IDs stay valid
+	void reset ( JNIEnv* e ) { env = e; }
 
 		/// object for class expression
 	jobject Class ( TConceptExpr* expr ) { return retObject ( expr, ClassPointer ); }
@@ -214,6 +209,27 @@ public:		// members
 		return ret;
 	}
 
+		/// create an array of native handles (the values of the 'node' fields) from given VEC
+	template<class T>
+	jlongArray buildHandles ( const std::vector<T*>& vec )
+	{
+		std::vector<jlong> handles;
+		handles.reserve(vec.size());
+		for ( typename std::vector<T*>::const_iterator p = vec.begin(), p_end = vec.end(); p != p_end; ++p )
+			handles.push_back((jlong)*p);
+		return buildHandles(handles);
+	}
+		/// create a Java array of given HANDLES
+	jlongArray buildHandles ( const std::vector<jlong>& handles )
+	{
+		jlongArray ret = env->NewLongArray(handles.size());
+		if ( unlikely(ret == 0) )
+			Throw ( env, "Can't create long[] array" );
+		else if ( !handles.empty() )
+			env->SetLongArrayRegion ( ret, 0, handles.size(), &handles[0] );
+		return ret;
+	}
+
 	// get expressions for the names in the unified way
 
 		/// get expression for the class name
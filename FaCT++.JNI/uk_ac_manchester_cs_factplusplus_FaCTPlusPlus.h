@@ -768,6 +768,14 @@ JNIEXPORT jobject JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_tel
 JNIEXPORT void JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_retract
   (JNIEnv *, jobject, jobject);
 
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    loadAxioms
+ * Signature: (Ljava/nio/ByteBuffer;I)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_loadAxioms
+  (JNIEnv *, jobject, jobject, jint);
+
 /*
  * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
  * Method:    isKBConsistent
@@ -792,6 +800,14 @@ JNIEXPORT jboolean JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_is
 JNIEXPORT jboolean JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_isClassSubsumedBy
   (JNIEnv *, jobject, jobject, jobject);
 
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    areClassesSubsumedBy
+ * Signature: ([Luk/ac/manchester/cs/factplusplus/ClassPointer;[Luk/ac/manchester/cs/factplusplus/ClassPointer;)[Z
+ */
+JNIEXPORT jbooleanArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_areClassesSubsumedBy
+  (JNIEnv *, jobject, jobjectArray, jobjectArray);
+
 /*
  * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
  * Method:    isClassEquivalentTo
@@ -1208,6 +1224,22 @@ JNIEXPORT void JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_needTr
 JNIEXPORT jobjectArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_getTrace
   (JNIEnv *, jobject);
 
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    getStatisticNames
+ * Signature: ()[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_getStatisticNames
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    getStatistic
+ * Signature: (Z)[D
+ */
+JNIEXPORT jdoubleArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_getStatistic
+  (JNIEnv *, jobject, jboolean);
+
 /*
  * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
  * Method:    buildCompletionTree
@@ -1352,6 +1384,62 @@ JNIEXPORT jboolean JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_se
 JNIEXPORT jboolean JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_clearSaveLoadContext
   (JNIEnv *, jobject, jstring);
 
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askSubClassesHandles
+ * Signature: (JZ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askSubClassesHandles
+  (JNIEnv *, jobject, jlong, jboolean);
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askSuperClassesHandles
+ * Signature: (JZ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askSuperClassesHandles
+  (JNIEnv *, jobject, jlong, jboolean);
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askEquivalentClassesHandles
+ * Signature: (J)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askEquivalentClassesHandles
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askIndividualTypesHandles
+ * Signature: (JZ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askIndividualTypesHandles
+  (JNIEnv *, jobject, jlong, jboolean);
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askInstancesHandles
+ * Signature: (JZ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askInstancesHandles
+  (JNIEnv *, jobject, jlong, jboolean);
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askSameAsHandles
+ * Signature: (J)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askSameAsHandles
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    askRelatedIndividualsHandles
+ * Signature: (JJ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_askRelatedIndividualsHandles
+  (JNIEnv *, jobject, jlong, jlong);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,293 @@
+package uk.ac.manchester.cs.factplusplus;
+
+/*
+ * Copyright (C) 2003-2013 by Dmitry Tsarkov
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.Charset;
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * Encoder of expressions and axioms for FaCTPlusPlus.loadAxioms().
+ * <p/>
+ * Every expression method writes an expression record and returns its index;
+ * the index is used to refer to the expression in the later records of the
+ * same buffer. Named entities are written once per buffer. Every axiom method
+ * writes an axiom record; loadAxioms() returns one handle per axiom record in
+ * the order they were written. Opcodes and the layout must be kept in sync
+ * with FaCT++.JNI/AxiomBufferLoader.h.
+ */
+public class AxiomBuffer {
+	private static final Charset UTF8 = Charset.forName("UTF-8");
+
+	private ByteBuffer buffer;
+	private int nExpressions = 0;
+	private int nAxioms = 0;
+	private final Map<String, Integer> names = new HashMap<String, Integer>();
+
+	public AxiomBuffer() {
+		this(1 << 16);
+	}
+
+	public AxiomBuffer(int capacity) {
+		buffer = ByteBuffer.allocateDirect(capacity).order(ByteOrder.nativeOrder());
+	}
+
+	/** @return the underlying direct buffer */
+	public ByteBuffer getBuffer() {
+		return buffer;
+	}
+
+	/** @return number of bytes written */
+	public int size() {
+		return buffer.position();
+	}
+
+	/** @return number of axiom records written */
+	public int getAxiomCount() {
+		return nAxioms;
+	}
+
+	/** drop all the records to reuse the buffer */
+	public void clear() {
+		buffer.clear();
+		nExpressions = 0;
+		nAxioms = 0;
+		names.clear();
+	}
+
+	// ------------------------------------------------------------------------
+	// Low-level writing
+	// ------------------------------------------------------------------------
+
+	private void ensure(int n) {
+		if (buffer.remaining() >= n) {
+			return;
+		}
+		int capacity = buffer.capacity();
+		while (capacity - buffer.position() < n) {
+			capacity *= 2;
+		}
+		ByteBuffer b = ByteBuffer.allocateDirect(capacity).order(ByteOrder.nativeOrder());
+		buffer.flip();
+		b.put(buffer);
+		buffer = b;
+	}
+
+	private void op(int code) {
+		ensure(1);
+		buffer.put((byte) code);
+	}
+
+	private void putInt(int n) {
+		ensure(4);
+		buffer.putInt(n);
+	}
+
+	private void putString(String s) {
+		byte[] bytes = s.getBytes(UTF8);
+		putInt(bytes.length);
+		ensure(bytes.length);
+		buffer.put(bytes);
+	}
+
+	private void putList(int... args) {
+		putInt(args.length);
+		for (int arg : args) {
+			putInt(arg);
+		}
+	}
+
+	private int expr() {
+		return nExpressions++;
+	}
+
+	private void axiom() {
+		nAxioms++;
+	}
+
+	private int named(int code, String name) {
+		String key = code + " " + name;
+		Integer id = names.get(key);
+		if (id == null) {
+			op(code);
+			putString(name);
+			id = expr();
+			names.put(key, id);
+		}
+		return id;
+	}
+
+	private int expr1(int code, int a) {
+		op(code);
+		putInt(a);
+		return expr();
+	}
+
+	private int expr2(int code, int a, int b) {
+		op(code);
+		putInt(a);
+		putInt(b);
+		return expr();
+	}
+
+	private int exprN(int code, int n, int a, int b) {
+		op(code);
+		putInt(n);
+		putInt(a);
+		putInt(b);
+		return expr();
+	}
+
+	private int exprList(int code, int... args) {
+		op(code);
+		putList(args);
+		return expr();
+	}
+
+	private void axiom1(int code, int a) {
+		op(code);
+		putInt(a);
+		axiom();
+	}
+
+	private void axiom2(int code, int a, int b) {
+		op(code);
+		putInt(a);
+		putInt(b);
+		axiom();
+	}
+
+	private void axiom3(int code, int a, int b, int c) {
+		op(code);
+		putInt(a);
+		putInt(b);
+		putInt(c);
+		axiom();
+	}
+
+	private void axiomList(int code, int... args) {
+		op(code);
+		putList(args);
+		axiom();
+	}
+
+	// ------------------------------------------------------------------------
+	// Concept expressions
+	// ------------------------------------------------------------------------
+
+	public int thing() { op(1); return expr(); }
+	public int nothing() { op(2); return expr(); }
+	public int namedClass(String name) { return named(3, name); }
+	public int not(int c) { return expr1(4, c); }
+	public int and(int... c) { return exprList(5, c); }
+	public int or(int... c) { return exprList(6, c); }
+	public int oneOf(int... i) { return exprList(7, i); }
+	public int objectSome(int r, int c) { return expr2(8, r, c); }
+	public int objectAll(int r, int c) { return expr2(9, r, c); }
+	public int objectValue(int r, int i) { return expr2(10, r, i); }
+	public int self(int r) { return expr1(11, r); }
+	public int objectAtLeast(int n, int r, int c) { return exprN(12, n, r, c); }
+	public int objectAtMost(int n, int r, int c) { return exprN(13, n, r, c); }
+	public int objectExact(int n, int r, int c) { return exprN(14, n, r, c); }
+	public int dataSome(int a, int e) { return expr2(15, a, e); }
+	public int dataAll(int a, int e) { return expr2(16, a, e); }
+	public int dataHasValue(int a, int v) { return expr2(17, a, v); }
+	public int dataAtLeast(int n, int a, int e) { return exprN(18, n, a, e); }
+	public int dataAtMost(int n, int a, int e) { return exprN(19, n, a, e); }
+	public int dataExact(int n, int a, int e) { return exprN(20, n, a, e); }
+
+	// ------------------------------------------------------------------------
+	// Individual and role expressions
+	// ------------------------------------------------------------------------
+
+	public int individual(String name) { return named(21, name); }
+	public int objectProperty(String name) { return named(22, name); }
+	public int inverse(int r) { return expr1(23, r); }
+	public int propertyComposition(int... r) { return exprList(24, r); }
+	public int dataProperty(String name) { return named(25, name); }
+
+	// ------------------------------------------------------------------------
+	// Data expressions
+	// ------------------------------------------------------------------------
+
+	public int dataTop() { op(26); return expr(); }
+	public int builtInDataType(String name) { return named(27, name); }
+
+	public int dataValue(String value, int type) {
+		op(28);
+		putString(value);
+		putInt(type);
+		return expr();
+	}
+
+	public int dataNot(int e) { return expr1(29, e); }
+	public int dataIntersectionOf(int... e) { return exprList(30, e); }
+	public int dataUnionOf(int... e) { return exprList(31, e); }
+	public int dataEnumeration(int... v) { return exprList(32, v); }
+	public int restrictedDataType(int type, int facet) { return expr2(33, type, facet); }
+	public int minExclusiveFacet(int v) { return expr1(34, v); }
+	public int maxExclusiveFacet(int v) { return expr1(35, v); }
+	public int minInclusiveFacet(int v) { return expr1(36, v); }
+	public int maxInclusiveFacet(int v) { return expr1(37, v); }
+
+	// ------------------------------------------------------------------------
+	// Axioms
+	// ------------------------------------------------------------------------
+
+	public void declaration(int x) { axiom1(64, x); }
+	public void subClassOf(int c, int d) { axiom2(65, c, d); }
+	public void equivalentClasses(int... c) { axiomList(66, c); }
+	public void disjointClasses(int... c) { axiomList(67, c); }
+
+	public void disjointUnion(int c, int... d) {
+		op(68);
+		putInt(c);
+		putList(d);
+		axiom();
+	}
+
+	public void subObjectProperties(int r, int s) { axiom2(69, r, s); }
+	public void equivalentObjectProperties(int... r) { axiomList(70, r); }
+	public void disjointObjectProperties(int... r) { axiomList(71, r); }
+	public void inverseProperties(int r, int s) { axiom2(72, r, s); }
+	public void objectPropertyDomain(int r, int c) { axiom2(73, r, c); }
+	public void objectPropertyRange(int r, int c) { axiom2(74, r, c); }
+	public void functionalObjectProperty(int r) { axiom1(75, r); }
+	public void inverseFunctionalObjectProperty(int r) { axiom1(76, r); }
+	public void symmetricObjectProperty(int r) { axiom1(77, r); }
+	public void asymmetricObjectProperty(int r) { axiom1(78, r); }
+	public void reflexiveObjectProperty(int r) { axiom1(79, r); }
+	public void irreflexiveObjectProperty(int r) { axiom1(80, r); }
+	public void transitiveObjectProperty(int r) { axiom1(81, r); }
+	public void subDataProperties(int a, int b) { axiom2(82, a, b); }
+	public void equivalentDataProperties(int... a) { axiomList(83, a); }
+	public void disjointDataProperties(int... a) { axiomList(84, a); }
+	public void dataPropertyDomain(int a, int c) { axiom2(85, a, c); }
+	public void dataPropertyRange(int a, int e) { axiom2(86, a, e); }
+	public void functionalDataProperty(int a) { axiom1(87, a); }
+	public void individualType(int i, int c) { axiom2(88, i, c); }
+	public void relatedIndividuals(int i, int r, int j) { axiom3(89, i, r, j); }
+	public void notRelatedIndividuals(int i, int r, int j) { axiom3(90, i, r, j); }
+	public void relatedIndividualValue(int i, int a, int v) { axiom3(91, i, a, v); }
+	public void notRelatedIndividualValue(int i, int a, int v) { axiom3(92, i, a, v); }
+	public void sameIndividuals(int... i) { axiomList(93, i); }
+	public void differentIndividuals(int... i) { axiomList(94, i); }
+}
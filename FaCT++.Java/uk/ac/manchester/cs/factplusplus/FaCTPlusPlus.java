@@ -1,5 +1,6 @@
 package uk.ac.manchester.cs.factplusplus;
 
+import java.nio.ByteBuffer;
 import java.util.concurrent.atomic.AtomicBoolean;
 
 /**
@@ -429,6 +430,39 @@ public class FaCTPlusPlus {
 
 	public native void retract(AxiomPointer a) throws FaCTPlusPlusException;
 
+	// ------------------------------------------------------------------------
+	// Bulk loading
+	// ------------------------------------------------------------------------
+
+	/**
+	 * Builds all the expressions and axioms encoded in the first length bytes
+	 * of a direct buffer in a single native call. See AxiomBuffer for the
+	 * encoding. The whole buffer is checked first, so no axioms are added if
+	 * it is malformed. The entities named in the buffer before the error are
+	 * still registered in the reasoner's expression manager.
+	 * 
+	 * @return handles of the created axioms, one per axiom record, in order
+	 */
+	public native long[] loadAxioms(ByteBuffer buffer, int length) throws FaCTPlusPlusException;
+
+	/**
+	 * Builds all the expressions and axioms written to the given buffer.
+	 * 
+	 * @return handles of the created axioms, one per axiom record, in order
+	 */
+	public long[] loadAxioms(AxiomBuffer buffer) throws FaCTPlusPlusException {
+		return loadAxioms(buffer.getBuffer(), buffer.size());
+	}
+
+	/**
+	 * Wraps an axiom handle returned by loadAxioms, e.g. to retract the axiom.
+	 */
+	public static AxiomPointer getAxiomPointer(long handle) {
+		AxiomPointer p = new AxiomPointer();
+		p.setNode(handle);
+		return p;
+	}
+
 	// ------------------------------------------------------------------------
 	// ASK queries
 	// ------------------------------------------------------------------------
@@ -439,6 +473,11 @@ public class FaCTPlusPlus {
 
 	public native boolean isClassSubsumedBy(ClassPointer c, ClassPointer d) throws FaCTPlusPlusException;
 
+	/**
+	 * Answers all the queries c[i] [= d[i] at once
+	 */
+	public native boolean[] areClassesSubsumedBy(ClassPointer[] c, ClassPointer[] d) throws FaCTPlusPlusException;
+
 	public native boolean isClassEquivalentTo(ClassPointer c, ClassPointer d) throws FaCTPlusPlusException;
 
 	public native boolean isClassDisjointWith(ClassPointer c, ClassPointer d) throws FaCTPlusPlusException;
@@ -612,6 +651,23 @@ public class FaCTPlusPlus {
 	 */
 	public native AxiomPointer[] getTrace();
 
+	// ------------------------------------------------------------------------
+	// Reasoning statistic
+	// ------------------------------------------------------------------------
+
+	/**
+	 * get the names of the reasoning statistic elements; getStatistic() returns
+	 * the values in the same order
+	 */
+	public native String[] getStatisticNames();
+
+	/**
+	 * get the reasoning statistic: since the KB was loaded, or of the last query
+	 * if lastQuery is set. Tactic counters are gathered only if the option
+	 * gatherStatistics is set
+	 */
+	public native double[] getStatistic(boolean lastQuery);
+
 	// ------------------------------------------------------------------------
 	// Knowledge Exploration interface
 	// ------------------------------------------------------------------------
@@ -663,4 +719,34 @@ public class FaCTPlusPlus {
 	public native boolean setSaveLoadContext(String name);
 
 	public native boolean clearSaveLoadContext(String name);
+
+	// ------------------------------------------------------------------------
+	// Handle-based queries
+	//
+	// Arguments are Pointer.getNode() values and results are arrays of such
+	// values, so that no Java pointer objects are created per answer. Named
+	// entities always have the same handle within a reasoner, so the caller
+	// can map handles back to its entities. Grouped results are flattened:
+	// every group of equivalent entities is preceded by its size.
+	//
+	// Handles must be live values obtained from this reasoner: getNode() of
+	// its pointers or its own answers. A handle of an expression of a wrong
+	// kind (e.g. an individual passed as a class) raises an exception; any
+	// other value (a handle of a cleared or another reasoner, an arbitrary
+	// number) is not detected and might crash the JVM.
+	// ------------------------------------------------------------------------
+
+	public native long[] askSubClassesHandles(long c, boolean direct) throws FaCTPlusPlusException;
+
+	public native long[] askSuperClassesHandles(long c, boolean direct) throws FaCTPlusPlusException;
+
+	public native long[] askEquivalentClassesHandles(long c) throws FaCTPlusPlusException;
+
+	public native long[] askIndividualTypesHandles(long i, boolean direct) throws FaCTPlusPlusException;
+
+	public native long[] askInstancesHandles(long c, boolean direct) throws FaCTPlusPlusException;
+
+	public native long[] askSameAsHandles(long i) throws FaCTPlusPlusException;
+
+	public native long[] askRelatedIndividualsHandles(long i, long r) throws FaCTPlusPlusException;
 }
@@ -30,6 +30,11 @@ public class Pointer {
 		return node;
 	}
 
+	/** set the native handle; used to wrap handles returned as long values */
+	void setNode(long node) {
+		this.node = node;
+	}
+
 	@Override
 	public int hashCode() {
 		return (int) node;
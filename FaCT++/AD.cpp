@@ -74,7 +74,7 @@ sizeAD ( AOStructure* AOS )
 }
 
 void
-CreateAD ( TOntology* Ontology, bool useSem )
+CreateAD ( TOntology* Ontology, bool useSem, int nThreads )
 {
 	std::cerr << "\n";
 	// do the atomic decomposition
@@ -82,6 +82,7 @@ CreateAD ( TOntology* Ontology, bool useSem )
 	timer.Start();
 	TModularizer mod(useSem);
 	AtomicDecomposer* AD = new AtomicDecomposer(&mod);
+	AD->setNThreads(nThreads);
 	AD->setProgressIndicator(new CPPI());
 	AOStructure* AOS = AD->getAOS ( Ontology, M_BOT );
 	timer.Stop();
@@ -35,7 +35,7 @@ ReasoningKernel Kernel;
 std::ofstream Out;
 
 // defined in AD.cpp
-void CreateAD ( TOntology* O, bool useSem );
+void CreateAD ( TOntology* O, bool useSem, int nThreads );
 // defined in QA.cpp
 void doQueryAnswering ( ReasoningKernel& Kernel );
 
@@ -295,7 +295,7 @@ int main ( int argc, char *argv[] )
 
 	if ( Kernel.getOptions()->getBool("checkAD") )	// check atomic decomposition and exit
 	{
-		CreateAD(&Kernel.getOntology(), useSem);
+		CreateAD(&Kernel.getOntology(), useSem, Kernel.getOptions()->getInt("nThreads"));
 		return 0;
 	}
 
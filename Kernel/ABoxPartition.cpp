@@ -0,0 +1,82 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "ABoxPartition.h"
+#include "tRelated.h"
+
+void
+ABoxPartition :: addIndividual ( TIndividual* I )
+{
+	unsigned int n = static_cast<unsigned int>(I->getId());
+	if ( n >= Individuals.size() )
+	{
+		Individuals.resize ( n+1, NULL );
+		while ( Parent.size() <= n )
+			Parent.push_back(static_cast<unsigned int>(Parent.size()));
+	}
+	Individuals[n] = I;
+}
+
+void
+ABoxPartition :: connect ( const TIndividual* A, const TIndividual* B )
+{
+	unsigned int a = find(A->getId()), b = find(B->getId());
+	// keep the smallest id as a representative, so the partition doesn't depend on the order of connections
+	if ( a < b )
+		Parent[b] = a;
+	else if ( b < a )
+		Parent[a] = b;
+}
+
+void
+ABoxPartition :: finalise ( void )
+{
+	// components are numbered in the order of their first individuals
+	const unsigned int none = static_cast<unsigned int>(-1);
+	ComponentOf.assign ( Individuals.size(), none );
+	Components.clear();
+	for ( unsigned int n = 0; n < Individuals.size(); ++n )
+	{
+		if ( Individuals[n] == NULL )
+			continue;
+		unsigned int root = find(n);
+		if ( ComponentOf[root] == none )
+		{
+			ComponentOf[root] = size();
+			Components.push_back(IndVector());
+		}
+		ComponentOf[n] = ComponentOf[root];
+		if ( !Individuals[n]->isSynonym() )
+			Components[ComponentOf[n]].push_back(Individuals[n]);
+	}
+	Related.resize(size());
+	Different.resize(size());
+}
+
+void
+ABoxPartition :: addRelated ( const TRelated* rel )
+{
+	Related[getComponent(rel->a)].push_back(rel);
+}
+
+void
+ABoxPartition :: addDifferent ( const IndVector& diff )
+{
+	if ( !diff.empty() )
+		Different[getComponent(diff.front())].push_back(&diff);
+}
@@ -0,0 +1,107 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef ABOXPARTITION_H
+#define ABOXPARTITION_H
+
+#include <vector>
+
+#include "tIndividual.h"
+
+class TRelated;
+
+/**	partition of the individuals into the components connected by role assertions
+	and different-individuals axioms. If the TBox can't relate individuals by itself
+	(eg, there are no nominals), then every component could be reasoned about separately.
+**/
+class ABoxPartition
+{
+public:		// types
+		/// vector of individuals
+	typedef std::vector<TIndividual*> IndVector;
+		/// vector of role assertions
+	typedef std::vector<const TRelated*> RelatedVector;
+		/// vector of different-individuals axioms
+	typedef std::vector<const IndVector*> DifferentVector;
+
+protected:	// members
+		/// individuals by their id
+	IndVector Individuals;
+		/// parent of every individual in the union-find forest, indexed by the id
+	std::vector<unsigned int> Parent;
+		/// component of every individual, indexed by the id
+	std::vector<unsigned int> ComponentOf;
+		/// (non-synonym) individuals of every component
+	std::vector<IndVector> Components;
+		/// role assertions of every component
+	std::vector<RelatedVector> Related;
+		/// different-individuals axioms of every component
+	std::vector<DifferentVector> Different;
+
+protected:	// methods
+		/// @return id of the representative of the set containing an individual with id N
+	unsigned int find ( unsigned int n )
+	{
+		while ( Parent[n] != n )
+		{
+			Parent[n] = Parent[Parent[n]];
+			n = Parent[n];
+		}
+		return n;
+	}
+
+public:		// interface
+		/// empty c'tor
+	ABoxPartition ( void ) {}
+		/// empty d'tor
+	~ABoxPartition ( void ) {}
+
+	// building the partition
+
+		/// register an individual I
+	void addIndividual ( TIndividual* I );
+		/// put individuals A and B into the same component
+	void connect ( const TIndividual* A, const TIndividual* B );
+		/// build the components from the connections
+	void finalise ( void );
+		/// add role assertion REL to the component of its individuals
+	void addRelated ( const TRelated* rel );
+		/// add different-individuals axiom DIFF to the component of its individuals
+	void addDifferent ( const IndVector& diff );
+
+	// queries
+
+		/// @return number of the components
+	unsigned int size ( void ) const { return static_cast<unsigned int>(Components.size()); }
+		/// @return true iff the individual I was registered in the partition
+	bool contains ( const TIndividual* I ) const
+	{
+		unsigned int n = static_cast<unsigned int>(I->getId());
+		return n < Individuals.size() && Individuals[n] == I;
+	}
+		/// @return component of the (registered) individual I
+	unsigned int getComponent ( const TIndividual* I ) const { return ComponentOf[I->getId()]; }
+		/// @return (non-synonym) individuals of the N-th component
+	const IndVector& getMembers ( unsigned int n ) const { return Components[n]; }
+		/// @return role assertions of the N-th component
+	const RelatedVector& getRelated ( unsigned int n ) const { return Related[n]; }
+		/// @return different-individuals axioms of the N-th component
+	const DifferentVector& getDifferent ( unsigned int n ) const { return Different[n]; }
+}; // ABoxPartition
+
+#endif
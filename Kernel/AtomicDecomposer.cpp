@@ -16,15 +16,26 @@ License along with this library; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#include <algorithm>
+#include <thread>
+
 #include "AtomicDecomposer.h"
 #include "logging.h"
 #include "ProgressIndicatorInterface.h"
 
 //#define RKG_DEBUG_AD
 
+/// class to compare axioms by their ids (ie, by their order in the ontology)
+struct AxiomIdLess
+{
+	bool operator()(const TDLAxiom* a1, const TDLAxiom* a2) const
+		{ return a1->getId() < a2->getId(); }
+};
+
 /// d'tor
 AtomicDecomposer :: ~AtomicDecomposer ( void )
 {
+	clearWorkers();
 	delete AOS;
 	delete PI;
 }
@@ -51,13 +62,10 @@ AtomicDecomposer :: removeTautologies ( TOntology* O )
 		PI->setLimit(nAx);
 }
 
-/// build a module for given axiom AX; use parent atom's module as a base for the module search
+/// get an atom for the MODULE (which is sorted by the way); @return NULL if MODULE is empty, PARENT if it is the PARENT's module
 TOntologyAtom*
-AtomicDecomposer :: buildModule ( const TSignature& sig, TOntologyAtom* parent )
+AtomicDecomposer :: getAtomByModule ( AxiomVec& Module, TOntologyAtom* parent )
 {
-	// build a module for a given signature
-	pModularizer->extract ( parent->getModule().begin(), parent->getModule().end(), sig, type );
-	const AxiomVec& Module = pModularizer->getModule();
 	// if module is empty (empty bottom atom) -- do nothing
 	if ( Module.empty() )
 		return NULL;
@@ -67,21 +75,120 @@ AtomicDecomposer :: buildModule ( const TSignature& sig, TOntologyAtom* parent )
 	// check if the module corresponds to a PARENT one; modules are the same iff their sizes are the same
 	if ( parent != rootAtom && Module.size() == parent->getModule().size() )	// same module means same atom
 		return parent;
+	// keep the module in the ontology order, so the structure does not depend on the way the module was extracted
+	std::sort ( Module.begin(), Module.end(), AxiomIdLess() );
 	// create new atom with that module
 	TOntologyAtom* atom = AOS->newAtom();
 	atom->setModule(Module);
 	return atom;
 }
 
+/// build a module for given axiom AX; use parent atom's module as a base for the module search
+TOntologyAtom*
+AtomicDecomposer :: buildModule ( const TSignature& sig, TOntologyAtom* parent )
+{
+	// build a module for a given signature
+	pModularizer->extract ( parent->getModule().begin(), parent->getModule().end(), sig, type );
+	AxiomVec Module = pModularizer->getModule();
+	return getAtomByModule ( Module, parent );
+}
+
+/// thread body: preprocess O (if not NULL) and extract modules of AXIOMS with indices taken from NEXT using the modularizer MOD
+void
+AtomicDecomposer :: extractAxiomModules ( TModularizer* mod, TOntology* O, const AxiomVec* Axioms, std::atomic<size_t>* next, std::exception_ptr* error )
+{
+	// an exception can not leave the thread body, so pass it to the main thread
+	try
+	{
+		if ( O != NULL )
+			mod->preprocessOntology(O->getAxioms());
+		// the module of an axiom from the whole ontology is the same as the one from any module containing it
+		for ( size_t i = (*next)++; i < Axioms->size(); i = (*next)++ )
+		{
+			TDLAxiom* ax = (*Axioms)[i];
+			mod->extract ( ax->getSignature(), type );
+			AxiomModules[ax->getId()] = mod->getModule();
+		}
+	}
+	catch (...)
+	{
+		*error = std::current_exception();
+		// stop the other threads
+		*next = Axioms->size();
+	}
+}
+
+/// preprocess O (if not NULL) and extract modules of AXIOMS by the worker threads
+void
+AtomicDecomposer :: runWorkers ( TOntology* O, const AxiomVec& Axioms )
+{
+	typedef std::vector<std::thread> ThreadVector;
+	typedef std::vector<std::exception_ptr> ErrorVector;
+
+	// no need in more threads than the axioms; do not start a thread for a single module
+	unsigned int n = O != NULL || Axioms.size() > nThreads ? nThreads : static_cast<unsigned int>(Axioms.size());
+	std::atomic<size_t> next(0);
+	ErrorVector Errors(nThreads);
+	if ( n == 1 )
+		extractAxiomModules ( Workers[0], O, &Axioms, &next, &Errors[0] );
+	else
+	{
+		ThreadVector Threads;
+		for ( unsigned int i = 0; i < n; ++i )
+			Threads.push_back(std::thread(&AtomicDecomposer::extractAxiomModules,this,Workers[i],O,&Axioms,&next,&Errors[i]));
+		for ( ThreadVector::iterator q = Threads.begin(), q_end = Threads.end(); q != q_end; ++q )
+			q->join();
+	}
+
+	// re-throw the first exception of the workers
+	for ( ErrorVector::iterator q = Errors.begin(), q_end = Errors.end(); q != q_end; ++q )
+		if ( *q )
+		{
+			clearWorkers();
+			std::rethrow_exception(*q);
+		}
+}
+
+/// create worker modularizers for the ontology O
+void
+AtomicDecomposer :: initWorkers ( TOntology* O )
+{
+	unsigned int maxId = 0;
+	for ( TOntology::iterator p = O->begin(), p_end = O->end(); p != p_end; ++p )
+		maxId = std::max ( maxId, (*p)->getId() );
+	AxiomModules.resize(maxId+1);
+	// every thread has its own modularizer with its own marks and sig index
+	for ( unsigned int i = 0; i < nThreads; ++i )
+		Workers.push_back(new TModularizer(/*useSem=*/false));
+	runWorkers ( O, AxiomVec() );
+}
+
+/// add statistic of the worker modularizers to the main one and delete them; clear the extracted modules
+void
+AtomicDecomposer :: clearWorkers ( void )
+{
+	for ( ModularizerVec::iterator p = Workers.begin(), p_end = Workers.end(); p != p_end; ++p )
+	{
+		pModularizer->addStat(**p);
+		delete *p;
+	}
+	Workers.clear();
+	AxiomModules.clear();
+}
+
 /// create atom for given axiom AX; use parent atom's module as a base for the module search
 TOntologyAtom*
 AtomicDecomposer :: createAtom ( TDLAxiom* ax, TOntologyAtom* parent )
 {
+	// the module of the axiom might be extracted in a batch; take it (and free the memory) anyway
+	AxiomVec Module;
+	if ( !AxiomModules.empty() )
+		Module.swap(AxiomModules[ax->getId()]);
 	// check whether axiom already has an atom
 	if ( ax->getAtom() != NULL )
 		return const_cast<TOntologyAtom*>(ax->getAtom());
 	// build an atom: use a module to find atomic dependencies
-	TOntologyAtom* atom = buildModule( ax->getSignature(), parent );
+	TOntologyAtom* atom = Module.empty() ? buildModule ( ax->getSignature(), parent ) : getAtomByModule ( Module, parent );
 	// no empty modules should be here
 	fpp_assert ( atom != NULL );
 	// register axiom as a part of an atom
@@ -94,12 +201,17 @@ AtomicDecomposer :: createAtom ( TDLAxiom* ax, TOntologyAtom* parent )
 	// do cycle via set to keep the order
 	typedef std::set<TDLAxiom*> AxSet;
 	const AxSet M ( atom->getModule().begin(), atom->getModule().end() );
-	for ( AxSet::iterator q = M.begin(); q != M.end(); ++q )
+	for ( AxSet::iterator q = M.begin(), q_end = M.end(); q != q_end; ++q )
 #else
 	for ( TOntologyAtom::AxiomSet::const_iterator q = atom->getModule().begin(), q_end = atom->getModule().end(); q != q_end; ++q )
 #endif
 		if ( likely ( *q != ax ) )
+		{
+			// extract the modules of the rest of the atom's module in parallel before the recursion
+			if ( needModule(*q) )
+				buildAxiomModules ( q, q_end );
 			atom->addDepAtom ( createAtom ( *q, atom ) );
+		}
 	return atom;
 }
 
@@ -120,6 +232,10 @@ AtomicDecomposer :: getAOS ( TOntology* O, ModuleType t )
 	// we don't need tautologies here
 	removeTautologies(O);
 
+	// axioms might keep atoms of the previous decomposition
+	for ( TOntology::iterator p = O->begin(), p_end = O->end(); p != p_end; ++p )
+		(*p)->setAtom(NULL);
+
 	// init the root atom
 	rootAtom = new TOntologyAtom();
 	rootAtom -> setModule ( TOntologyAtom::AxiomSet ( O->begin(), O->end() ) );
@@ -130,10 +246,21 @@ AtomicDecomposer :: getAOS ( TOntology* O, ModuleType t )
 		for ( TOntologyAtom::AxiomSet::const_iterator q = BottomAtom->getModule().begin(), q_end = BottomAtom->getModule().end(); q != q_end; ++q )
 			BottomAtom->addAxiom(*q);
 
+	// extract the modules of the remaining axioms in parallel batches; only syntactic modules are extracted that way
+	if ( nThreads > 1 && !pModularizer->isSemantic() )
+		initWorkers(O);
+
 	// create atoms for all the axioms in the ontology
 	for ( TOntology::iterator p = O->begin(), p_end = O->end(); p != p_end; ++p )
-		if ( (*p)->isUsed() && (*p)->getAtom() == NULL )
+		if ( (*p)->isUsed() )
+		{
+			if ( needModule(*p) )
+				buildAxiomModules ( p, p_end );
 			createAtom ( *p, rootAtom );
+		}
+
+	// all the modules are used by now
+	clearWorkers();
 
 	// restore tautologies in the ontology
 	restoreTautologies();
@@ -19,6 +19,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef ATOMICDECOMPOSER_H
 #define ATOMICDECOMPOSER_H
 
+#include <atomic>
+#include <exception>
+
 #include "tOntologyAtom.h"
 #include "tSignature.h"
 #include "Modularity.h"
@@ -79,6 +82,16 @@ public:		// interface
 /// atomical decomposer of the ontology
 class AtomicDecomposer
 {
+protected:	// types
+		/// modules of the axioms, indexed by the axiom id
+	typedef std::vector<AxiomVec> ModuleVec;
+		/// modularizers of the worker threads
+	typedef std::vector<TModularizer*> ModularizerVec;
+
+protected:	// constants
+		/// number of axioms per thread whose modules are extracted in one batch
+	static const unsigned int batchSizePerThread = 64;
+
 protected:	// members
 		/// atomic structure to build
 	AOStructure* AOS;
@@ -92,6 +105,12 @@ protected:	// members
 	TOntologyAtom* rootAtom;
 		/// module type for current AOS creation
 	ModuleType type;
+		/// number of threads used to extract the modules
+	unsigned int nThreads;
+		/// modularizers of the worker threads; empty if there were no parallel extraction yet
+	ModularizerVec Workers;
+		/// modules of the axioms extracted in parallel, at most one batch per recursion level; empty entry means no module yet
+	ModuleVec AxiomModules;
 
 protected:	// methods
 		/// remove tautologies (axioms that are always local) from the ontology temporarily
@@ -102,14 +121,39 @@ protected:	// methods
 		for ( AxiomVec::iterator p = Tautologies.begin(), p_end = Tautologies.end(); p != p_end; ++p )
 			(*p)->setUsed(true);
 	}
+		/// get an atom for the MODULE (which is sorted by the way); @return NULL if MODULE is empty, PARENT if it is the PARENT's module
+	TOntologyAtom* getAtomByModule ( AxiomVec& Module, TOntologyAtom* parent );
 		/// build a module for given signature SIG; use parent atom's module as a base for the module search
 	TOntologyAtom* buildModule ( const TSignature& sig, TOntologyAtom* parent );
+		/// thread body: preprocess O (if not NULL) and extract modules of AXIOMS with indices taken from NEXT using the modularizer MOD;
+		/// save an exception (if any) into ERROR
+	void extractAxiomModules ( TModularizer* mod, TOntology* O, const AxiomVec* Axioms, std::atomic<size_t>* next, std::exception_ptr* error );
+		/// preprocess O (if not NULL) and extract modules of AXIOMS by the worker threads
+	void runWorkers ( TOntology* O, const AxiomVec& Axioms );
+		/// create worker modularizers for the ontology O
+	void initWorkers ( TOntology* O );
+		/// add statistic of the worker modularizers to the main one and delete them; clear the extracted modules
+	void clearWorkers ( void );
+		/// check whether the module of an axiom AX should be extracted by the workers
+	bool needModule ( const TDLAxiom* ax ) const
+		{ return !Workers.empty() && ax->getAtom() == NULL && AxiomModules[ax->getId()].empty(); }
+		/// extract in parallel the modules of the next batch of axioms in [P,P_END) that has no atoms
+	template<class Iterator>
+	void buildAxiomModules ( Iterator p, Iterator p_end )
+	{
+		AxiomVec Axioms;
+		const size_t batchSize = batchSizePerThread * nThreads;
+		for ( ; p != p_end && Axioms.size() < batchSize; ++p )
+			if ( (*p)->isUsed() && needModule(*p) )
+				Axioms.push_back(*p);
+		runWorkers ( NULL, Axioms );
+	}
 		/// create atom for given axiom AX; use parent atom's module as a base for the module search
 	TOntologyAtom* createAtom ( TDLAxiom* ax, TOntologyAtom* parent );
 
 public:		// interface
 		/// init c'tor; M would NOT be deleted in d'tor
-	AtomicDecomposer ( TModularizer* m ) : AOS(NULL), pModularizer(m), PI(NULL), rootAtom(NULL) {}
+	AtomicDecomposer ( TModularizer* m ) : AOS(NULL), pModularizer(m), PI(NULL), rootAtom(NULL), type(M_BOT), nThreads(1) {}
 		/// d'tor
 	~AtomicDecomposer ( void );
 
@@ -118,6 +162,8 @@ public:		// interface
 		/// get already created atomic structure
 	const AOStructure* getAOS ( void ) const { return AOS; }
 
+		/// set the number of threads that extract modules to N; syntactic modules only
+	void setNThreads ( int n ) { nThreads = n > 1 ? static_cast<unsigned int>(n) : 1; }
 		/// set progress indicator to be PI
 	void setProgressIndicator ( ProgressIndicatorInterface* pi ) { PI = pi; }
 		/// get number of performed locality checks
@@ -16,6 +16,8 @@ License along with this library; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#include <algorithm>
+
 #include "dlDag.h"
 #include "dlCompletionGraph.h"
 #include "Reasoner.h"
@@ -396,7 +398,7 @@ void DlCompletionGraph :: unblockNode ( DlCompletionTree* node, bool wasDBlocked
 	if ( node->isPBlocked() || !node->isBlockableNode() )
 		return;
 	if ( !wasDBlocked )	// if it was DBlocked -- findDBlocker() made it
-		saveRareCond(node->setUBlocked());
+		saveRareCond(node->setUBlocked(RareStack));
 	pReasoner->repeatUnblockedNode(node,wasDBlocked);
 	unblockNodeChildren(node);
 }
@@ -418,6 +420,7 @@ void DlCompletionGraph :: findDAncestorBlocker ( DlCompletionTree* node )
 		if ( !p->isBlockableNode() )
 			return;
 
+		++nBlockingTests;
 		if ( isBlockedBy ( node, p ) )
 		{
 			setNodeDBlocked ( node, p );
@@ -426,8 +429,59 @@ void DlCompletionGraph :: findDAncestorBlocker ( DlCompletionTree* node )
 	}
 }
 
+void
+DlCompletionGraph :: compactLabelIndexEntry ( LabelIndexEntry& entry, BipolarPointer bp )
+{
+	// keep only the nodes that are in use and still have BP in the label
+	std::vector<unsigned int>::iterator q = entry.ids.begin();
+	for ( std::vector<unsigned int>::const_iterator p = entry.ids.begin(), p_end = entry.ids.end(); p != p_end; ++p )
+		if ( *p < endUsed && NodeBase[*p]->label().contains(bp) )
+			*q++ = *p;
+	entry.ids.erase ( q, entry.ids.end() );
+	std::sort ( entry.ids.begin(), entry.ids.end() );
+	entry.ids.erase ( std::unique ( entry.ids.begin(), entry.ids.end() ), entry.ids.end() );
+	entry.sorted = true;
+}
+
+const std::vector<unsigned int>&
+DlCompletionGraph :: getIndexedNodes ( BipolarPointer bp )
+{
+	LabelIndexEntry& entry = LabelIndex[labelIndexKey(bp)];
+	if ( !entry.sorted )
+		compactLabelIndexEntry ( entry, bp );
+	return entry.ids;
+}
+
 void DlCompletionGraph :: findDAnywhereBlocker ( DlCompletionTree* node )
 {
+	// blocker should contain the Init concept of the node, so only the indexed nodes could block it
+	if ( node->Init != bpTOP )
+	{
+		if ( labelIndexKey(node->Init) >= LabelIndex.size() )	// no node has Init in the label
+			return;
+		const std::vector<unsigned int>& ids = getIndexedNodes(node->Init);
+		for ( std::vector<unsigned int>::const_iterator q = ids.begin(), q_end = ids.end(); q != q_end && *q < node->getId(); ++q )
+		{
+			const DlCompletionTree* p = NodeBase[*q];
+
+			// the entry might be out-dated
+			if ( !p->label().contains(node->Init) )
+				continue;
+
+			// node was merge to smth with the larger ID or is cached or blocked itself
+			if ( p->isBlocked() || p->isPBlocked() || p->isNominalNode() || p->isCached() )
+				continue;
+
+			++nBlockingTests;
+			if ( isBlockedBy ( node, p ) )
+			{
+				setNodeDBlocked ( node, p );
+				return;
+			}
+		}
+		return;
+	}
+
 	for ( const_iterator q = begin(), q_end = end(); q < q_end && *q != node; ++q )
 	{
 		const DlCompletionTree* p = *q;
@@ -436,6 +490,7 @@ void DlCompletionGraph :: findDAnywhereBlocker ( DlCompletionTree* node )
 		if ( p->isBlocked() || p->isPBlocked() || p->isNominalNode() || p->isCached() )
 			continue;
 
+		++nBlockingTests;
 		if ( isBlockedBy ( node, p ) )
 		{
 			setNodeDBlocked ( node, p );
@@ -138,7 +138,7 @@ BipolarPointer TBox :: addDataExprToHeap ( TDataEntry* p )
 		hostBP = addDataExprToHeap(const_cast<TDataEntry*>(p->getType()));
 
 	// create new DAG entry for the data value
-	DLVertex* ver = new DLVertex ( dt, hostBP );
+	DLVertex* ver = new(DLHeap) DLVertex ( dt, hostBP );
 	ver->setConcept(p);
 	p->setBP(DLHeap.directAdd(ver));
 
@@ -157,7 +157,7 @@ void TBox :: addConceptToHeap ( TConcept* pConcept )
 		static_cast<TIndividual*>(pConcept)->setNominal();
 
 	// new concept's addition
-	DLVertex* ver = new DLVertex(tag);
+	DLVertex* ver = new(DLHeap) DLVertex(tag);
 	ver->setConcept(pConcept);
 	pConcept->pName = DLHeap.directAdd(ver);
 
@@ -223,7 +223,7 @@ BipolarPointer TBox :: tree2dag ( const DLTree* t )
 		ret = atmost2dag ( cur.getData(), resolveRole(t->Left()), tree2dag(t->Right()) );
 		break;
 	case PROJFROM:	// note: no PROJINTO as already unified
-		ret = DLHeap.directAdd ( new DLVertex ( resolveRole(t->Left()), tree2dag(t->Right()->Right()), resolveRole(t->Right()->Left()) ) );
+		ret = DLHeap.directAdd ( new(DLHeap) DLVertex ( resolveRole(t->Left()), tree2dag(t->Right()->Right()), resolveRole(t->Right()->Left()) ) );
 		break;
 	default:
 		fpp_assert ( isSNF(t) );	// safety check
@@ -238,19 +238,19 @@ BipolarPointer
 TBox :: and2dag ( const DLTree* t )
 {
 	BipolarPointer ret = bpBOTTOM;
-	DLVertex* v = new DLVertex(dtAnd);
+	DLVertex* v = new(DLHeap) DLVertex(dtAnd);
 
 	if ( fillANDVertex ( v, t ) )	// clash found
-		delete v;
+		DLHeap.deleteVertex(v);
 	else	// AND vertex
 		switch ( v->end() - v->begin() )
 		{
 		case 0:	// and(TOP) = TOP
-			delete v;
+			DLHeap.deleteVertex(v);
 			return bpTOP;
 		case 1:	// and(C) = C
 			ret = *v->begin();
-			delete v;
+			DLHeap.deleteVertex(v);
 			break;
 		default:
 			ret = DLHeap.add(v);
@@ -266,7 +266,7 @@ BipolarPointer TBox :: forall2dag ( const TRole* R, BipolarPointer C )
 		return dataForall2dag(R,C);
 
 	// create \all R.C == \all R{0}.C
-	BipolarPointer ret = DLHeap.add ( new DLVertex ( dtForall, 0, R, C ) );
+	BipolarPointer ret = DLHeap.add ( new(DLHeap) DLVertex ( dtForall, 0, R, C ) );
 
 	if ( R->isSimple() )	// don't care about the rest
 		return ret;
@@ -277,7 +277,7 @@ BipolarPointer TBox :: forall2dag ( const TRole* R, BipolarPointer C )
 
 	// have appropriate concepts for all the automata states
 	for ( unsigned int i = 1; i < R->getAutomaton().size(); ++i )
-		DLHeap.directAddAndCache ( new DLVertex ( dtForall, i, R, C ) );
+		DLHeap.directAddAndCache ( new(DLHeap) DLVertex ( dtForall, i, R, C ) );
 
 	return ret;
 }
@@ -294,7 +294,7 @@ BipolarPointer TBox :: atmost2dag ( unsigned int n, const TRole* R, BipolarPoint
 	if ( unlikely ( C == bpBOTTOM ) )	// can happen as A & ~A
 		return bpTOP;
 
-	BipolarPointer ret = DLHeap.add ( new DLVertex ( dtLE, n, R, C ) );
+	BipolarPointer ret = DLHeap.add ( new(DLHeap) DLVertex ( dtLE, n, R, C ) );
 
 	// check if the concept is not last
 	if ( !DLHeap.isLast(ret) )
@@ -302,10 +302,10 @@ BipolarPointer TBox :: atmost2dag ( unsigned int n, const TRole* R, BipolarPoint
 
 	// create entries for the transitive sub-roles
 	for ( unsigned int m = n-1; m > 0; --m )
-		DLHeap.directAddAndCache ( new DLVertex ( dtLE, m, R, C ) );
+		DLHeap.directAddAndCache ( new(DLHeap) DLVertex ( dtLE, m, R, C ) );
 
 	// create a blocker for the NN-rule
-	DLHeap.directAddAndCache(new DLVertex(dtNN));
+	DLHeap.directAddAndCache(new(DLHeap) DLVertex(dtNN));
 
 	return ret;
 }
@@ -314,13 +314,13 @@ BipolarPointer TBox :: atmost2dag ( unsigned int n, const TRole* R, BipolarPoint
 void
 TBox :: split2dag ( TSplitVar* split )
 {
-	DLVertex* v = new DLVertex(dtSplitConcept);
+	DLVertex* v = new(DLHeap) DLVertex(dtSplitConcept);
 	for ( TSplitVar::iterator p = split->begin(), p_end = split->end(); p != p_end; ++p )
 		v->addChild(p->C->pName);
 	split->C->pBody = DLHeap.directAdd(v);
 	split->C->setPrimitive(false);
-	DLHeap.replaceVertex ( split->C->pName, new DLVertex ( dtNConcept, split->C->pBody ), split->C );
-	DLHeap.directAdd(new DLVertex ( dtChoose, split->C->pName ));
+	DLHeap.replaceVertex ( split->C->pName, new(DLHeap) DLVertex ( dtNConcept, split->C->pBody ), split->C );
+	DLHeap.directAdd(new(DLHeap) DLVertex ( dtChoose, split->C->pName ));
 }
 
 bool TBox :: fillANDVertex ( DLVertex* v, const DLTree* t )
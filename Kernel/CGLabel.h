@@ -72,6 +72,8 @@ protected:	// methods
 public:		// interface
 		/// init newly created node
 	void init ( void );
+		/// clear the label and release all its memory
+	void release ( void ) { scLabel.release(); ccLabel.release(); }
 		/// empty c'tor
 	CGLabel ( void ) {}
 		/// copy c'tor
@@ -17,7 +17,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
 #include "CWDArray.h"
-#include "tRestorer.h"
+#include "tRareSaveStack.h"
 
 /// restore dep-set of the duplicated label element of the merged node
 class UnMerge: public TRestorer
@@ -37,7 +37,7 @@ public:
 }; // UnMerge
 
 TRestorer*
-CWDArray :: updateDepSet ( BipolarPointer bp, const DepSet& dep )
+CWDArray :: updateDepSet ( TRareSaveStack& stack, BipolarPointer bp, const DepSet& dep )
 {
 	if ( dep.empty() )
 		return NULL;
@@ -45,7 +45,7 @@ CWDArray :: updateDepSet ( BipolarPointer bp, const DepSet& dep )
 	for ( iterator i = Base.begin(), i_end = Base.end(); i < i_end; ++i )
 		if ( i->bp() == bp )
 		{
-			TRestorer* ret = new UnMerge ( *this, i );
+			TRestorer* ret = new(stack) UnMerge ( *this, i );
 //			DepSet odep(i->getDep());
 			i->addDep(dep);
 /*			if ( odep == i->getDep() )
@@ -64,6 +64,7 @@ CWDArray :: restore ( const SaveState& ss, unsigned int level ATTR_UNUSED )
 {
 #ifndef RKG_USE_DYNAMIC_BACKJUMPING
 	Base.resize(ss.ep);
+	Sig = ss.sig;
 #else
 	unsigned int j = ss.ep;
 	unsigned int k = j;
@@ -79,6 +80,10 @@ CWDArray :: restore ( const SaveState& ss, unsigned int level ATTR_UNUSED )
 	}
 
 	Base.reset(j);
+	// re-create the signature of the remaining entries
+	Sig = 0;
+	for ( const_iterator p = begin(), p_end = end(); p < p_end; ++p )
+		Sig |= sigBit(p->bp());
 #endif
 }
 
@@ -21,6 +21,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <ostream>
 #include <algorithm>	// find
+#include <climits>
 
 #include "globaldef.h"
 #include "growingArray.h"
@@ -29,6 +30,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 enum addConceptResult { acrClash, acrExist, acrDone };
 
 class TRestorer;
+class TRareSaveStack;
 
 /// array of concepts with dep-set, which may be viewed as a label of a completion-graph
 class CWDArray
@@ -38,6 +40,8 @@ protected:	// internal typedefs
 	typedef growingArray<ConceptWDep> ConceptSet;
 		/// RW iterator
 	typedef ConceptSet::iterator iterator;
+		/// signature of a label: a bit for every concept (modulo the word size)
+	typedef unsigned long Signature;
 
 		/// restorer for the merge
 	friend class UnMerge;
@@ -49,12 +53,14 @@ public:		// type interface
 	public:
 			/// end pointer of the label
 		size_t ep;
+			/// signature of the label
+		Signature sig;
 
 	public:		// interface
 			/// empty c'tor
 		SaveState ( void ) {}
 			/// copy c'tor
-		SaveState ( const SaveState& node ) : ep(node.ep) {}
+		SaveState ( const SaveState& node ) : ep(node.ep), sig(node.sig) {}
 			/// empty d'tor
 		~SaveState ( void ) {}
 	}; // SaveState
@@ -65,6 +71,12 @@ public:		// type interface
 protected:	// members
 		/// array of concepts together with dep-sets
 	ConceptSet Base;
+		/// signature of all the concepts in the label; used to quickly reject contains() and subset checks
+	Signature Sig;
+
+protected:	// methods
+		/// @return signature bit of a concept BP
+	static Signature sigBit ( BipolarPointer bp ) { return Signature(1) << ( static_cast<unsigned int>(bp) % (sizeof(Signature)*CHAR_BIT) ); }
 
 public:		// interface
 		/// init/clear label with given size
@@ -72,13 +84,20 @@ public:		// interface
 	{
 		Base.reserve(size);
 		Base.clear();
+		Sig = 0;
+	}
+		/// clear label and release all its memory
+	void release ( void )
+	{
+		Base.release();
+		Sig = 0;
 	}
 		/// empty c'tor
-	CWDArray ( void ) {}
+	CWDArray ( void ) : Sig(0) {}
 		/// copy c'tor
-	CWDArray ( const CWDArray& copy ) : Base(copy.Base) {}
+	CWDArray ( const CWDArray& copy ) : Base(copy.Base), Sig(copy.Sig) {}
 		/// assignment
-	CWDArray& operator = ( const CWDArray& copy ) { Base = copy.Base; return *this; }
+	CWDArray& operator = ( const CWDArray& copy ) { Base = copy.Base; Sig = copy.Sig; return *this; }
 		/// empty d'tor
 	~CWDArray ( void ) {}
 
@@ -97,14 +116,19 @@ public:		// interface
 	// add concept
 
 		/// adds concept P to a label
-	void add ( const ConceptWDep& p ) { Base.add(p); }
+	void add ( const ConceptWDep& p ) { Base.add(p); Sig |= sigBit(p.bp()); }
 		/// update concept BP with a dep-set DEP; @return the appropriate restorer
-	TRestorer* updateDepSet ( BipolarPointer bp, const DepSet& dep );
+	TRestorer* updateDepSet ( TRareSaveStack& stack, BipolarPointer bp, const DepSet& dep );
 
 	// access concepts
 
 		/// check whether label contains BP (ignoring dep-set)
-	bool contains ( BipolarPointer bp ) const { return std::find ( begin(), end(), bp ) != end(); }
+	bool contains ( BipolarPointer bp ) const
+	{
+		if ( ( Sig & sigBit(bp) ) == 0 )	// definitely not there
+			return false;
+		return std::find ( begin(), end(), bp ) != end();
+	}
 		/// get the concept by given index in the node's label
 	const ConceptWDep& getConcept ( int n ) const { return Base[n]; }
 
@@ -112,9 +136,15 @@ public:		// interface
 	// Blocking support
 	//----------------------------------------------
 
+		/// @return signature of the label
+	Signature getSignature ( void ) const { return Sig; }
 		/// check whether LABEL is a superset of a current one
 	bool operator <= ( const CWDArray& label ) const
 	{
+		// some concept of the label is definitely missing in the LABEL
+		if ( ( Sig & ~label.Sig ) != 0 )
+			return false;
+
 		for ( const_iterator p = begin(), p_end = end(); p < p_end; ++p )
 			if ( !label.contains(p->bp()) )
 				return false;
@@ -132,7 +162,7 @@ public:		// interface
 	//----------------------------------------------
 
 		/// save label using given SS
-	void save ( SaveState& ss ) const { ss.ep = Base.size(); }
+	void save ( SaveState& ss ) const { ss.ep = Base.size(); ss.sig = Sig; }
 		/// restore label to given LEVEL using given SS
 	void restore ( const SaveState& ss, unsigned int level );
 
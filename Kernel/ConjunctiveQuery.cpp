@@ -250,6 +250,8 @@ TBox :: answerQuery ( const std::vector<DLTree*>& Cs )
 bool
 NominalReasoner :: checkExtraCond ( void )
 {
+	// query variables could be bound to individuals of any ABox component
+	SessionScope = WholeABox;
 	prepareReasoner();
 	DepSet dummy;
 	for ( size_t i = 0; i < IV.size(); i++ )
@@ -20,14 +20,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 |* Implementation of taxonomy building for the FaCT++  *|
 \*******************************************************/
 
-#include "Reasoner.h"
+#include <chrono>
+
+#include "ReasonerPool.h"
 #include "DLConceptTaxonomy.h"
 #include "procTimer.h"
 #include "globaldef.h"
 #include "logging.h"
 
-#include <queue>
-
 /********************************************************\
 |* 			Implementation of class Taxonomy			*|
 \********************************************************/
@@ -62,7 +62,7 @@ bool DLConceptTaxonomy :: testSub ( const TConcept* p, const TConcept* q )
 		return false;
 	}
 
-	if ( isNotInModule(q->getEntity()) )
+	if ( isNotInModule ( p, q ) )
 	{
 		if ( LLM.isWritable(llTaxTrying) )
 			LL << "NOT holds (module result)";
@@ -98,14 +98,27 @@ bool DLConceptTaxonomy :: testSub ( const TConcept* p, const TConcept* q )
 }
 
 bool
-DLConceptTaxonomy :: isNotInModule ( const TNamedEntity* entity ) const
+DLConceptTaxonomy :: needTableauTest ( const TConcept* p, const TConcept* q )
 {
-	if ( upDirection )	// bottom-up phase
+	// the same checks as in testSub() in the same order, but without statistics
+	if ( q->isSingleton() && q->isPrimitive() && !q->isNominal() )
 		return false;
-	const TSignature* sig = sigStack.top();
-	if ( sig && entity && !sig->contains(entity) )
-		return true;
-	return false;
+
+	if ( unlikely(inSplitCheck) )
+		return !q->isPrimitive();
+
+	if ( tBox.testSortedNonSubsumption ( p, q ) || isNotInModule ( p, q ) )
+		return false;
+
+	modelCacheState state = tBox.testCachedNonSubsumption ( p, q );
+	return state != csValid && state != csInvalid;
+}
+
+bool
+DLConceptTaxonomy :: isNotInModule ( const TConcept* p, const TConcept* q ) const
+{
+	// in the bottom-up phase P is a candidate rather than the current entry
+	return isNotInSignature ( upDirection ? getSignature(p) : sigStack.top(), q );
 }
 
 TaxonomyCreator::KnownSubsumers*
@@ -114,9 +127,9 @@ DLConceptTaxonomy :: buildKnownSubsumers ( ClassifiableEntry* ce )
 	return TaxonomyCreator::buildKnownSubsumers(ce);
 }
 
-/// prepare signature for given entry
+/// @return signature of the \bot-module of P; NULL if not known
 TSignature*
-DLConceptTaxonomy :: buildSignature ( ClassifiableEntry* p )
+DLConceptTaxonomy :: getSignature ( const ClassifiableEntry* p ) const
 {
 	if ( tBox.pName2Sig == NULL )
 		return NULL;
@@ -128,6 +141,13 @@ DLConceptTaxonomy :: buildSignature ( ClassifiableEntry* p )
 	return found->second;
 }
 
+/// prepare signature for given entry
+TSignature*
+DLConceptTaxonomy :: buildSignature ( ClassifiableEntry* p )
+{
+	return getSignature(p);
+}
+
 void DLConceptTaxonomy :: print ( std::ostream& o ) const
 {
 	o << "Totally " << nTries << " subsumption tests was made\nAmong them ";
@@ -158,6 +178,10 @@ DLConceptTaxonomy :: searchBaader ( TaxonomyVertex* cur )
 	++nSearchCalls;
 	bool noPosSucc = true;
 
+	// run independent tests of the successors in parallel; results will be used below
+	if ( tBox.pReasonerPool != NULL )
+		runParallelTests(cur);
+
 	// check if there are positive successors; use DFS on them.
 	for ( TaxonomyVertex::iterator p = cur->begin(upDirection), p_end = cur->end(upDirection); p != p_end; ++p )
 		if ( enhancedSubs(*p) )
@@ -177,6 +201,220 @@ DLConceptTaxonomy :: searchBaader ( TaxonomyVertex* cur )
 		pTax->getCurrent()->addNeighbour ( !upDirection, cur );
 }
 
+bool
+DLConceptTaxonomy :: isTestInevitable ( TaxonomyVertex* cur ) const
+{
+	// the same conditions as in enhancedSubs2()
+	if ( isValued(cur) || (upDirection && !cur->isCommon()) )
+		return false;
+
+	// the same conditions as in enhancedSubs1(): all the neighbours are known to be subsumers
+	for ( TaxonomyVertex::iterator p = cur->begin(!upDirection), p_end = cur->end(!upDirection); p != p_end; ++p )
+		if ( !isValued(*p) || !getValue(*p) )
+			return false;
+
+	return true;
+}
+
+void
+DLConceptTaxonomy :: runParallelTests ( TaxonomyVertex* cur )
+{
+	// values in the taxonomy doesn't change during the search, so every test gathered
+	// here would be performed by searchBaader(cur) anyway
+	TReasonerPool::TaskVector tasks;
+	for ( TaxonomyVertex::iterator p = cur->begin(upDirection), p_end = cur->end(upDirection); p != p_end; ++p )
+	{
+		if ( !isTestInevitable(*p) )
+			continue;
+		const TConcept* testC = static_cast<const TConcept*>((*p)->getPrimer());
+		const TConcept* sub = upDirection ? testC : curConcept();
+		const TConcept* sup = upDirection ? curConcept() : testC;
+		if ( preTested.count(std::make_pair(sub,sup)) == 0 && needTableauTest ( sub, sup ) && tBox.canTestInParallel ( sub, sup ) )
+			tasks.push_back(TSubTask(sub,sup));
+	}
+
+	// single test would be done in the main thread as well
+	if ( tasks.size() < 2 )
+		return;
+
+	tBox.pReasonerPool->run(tasks);
+
+	for ( TReasonerPool::TaskVector::iterator q = tasks.begin(), q_end = tasks.end(); q != q_end; ++q )
+		if ( q->done )
+			preTested[std::make_pair(q->p,q->q)] = q->result;
+}
+
+//-----------------------------------------------------------------
+//--	Parallel realisation
+//-----------------------------------------------------------------
+
+/// @return true iff the test IND [= C could be answered without a tableau using the \bot-module signature SIG of IND; set RES in this case
+bool
+DLConceptTaxonomy :: testTypeCheaply ( const TIndividual* ind, const TSignature* sig, const TConcept* C, bool& res ) const
+{
+	// the same as in testSub(), but only the caches built by preRealise() are used
+	res = false;
+	if ( tBox.testSortedNonSubsumption ( ind, C ) || isNotInSignature ( sig, C ) )
+		return true;
+
+	const modelCacheInterface* pCache = tBox.DLHeap.getCache(ind->pName);
+	const modelCacheInterface* nCache = tBox.DLHeap.getCache(inverse(C->pName));
+	if ( pCache == NULL || nCache == NULL )
+		return false;
+	switch ( pCache->canMerge(nCache) )
+	{
+	case csValid:
+		return true;
+	case csInvalid:
+		res = true;
+		return true;
+	default:
+		return false;
+	}
+}
+
+/// put into TYPES results of the tests of IND against the concept taxonomy, made by WORKER
+void
+DLConceptTaxonomy :: searchTypes ( NominalWorker& worker, const TIndividual* ind, TypeResults& types ) const
+{
+	typedef std::map<const TaxonomyVertex*, bool> VertexValues;
+	VertexValues values;
+	std::vector<const TaxonomyVertex*> positive;	// vertices whose children are to be checked
+	// the creator's signature stack belongs to the main thread, so use the module signature of IND directly
+	const TSignature* sig = getSignature(ind);
+
+	// told subsumers and all their ancestors are known to be types of IND
+	std::vector<const TaxonomyVertex*> todo(1,pTax->getTopVertex());
+	for ( ClassifiableEntry::const_iterator p = ind->told_begin(), p_end = ind->told_end(); p != p_end; ++p )
+		if ( const TaxonomyVertex* v = resolveSynonym(*p)->getTaxVertex() )
+			todo.push_back(v);
+	while ( !todo.empty() )
+	{
+		const TaxonomyVertex* v = todo.back();
+		todo.pop_back();
+		if ( values.count(v) > 0 )
+			continue;
+		values[v] = true;
+		positive.push_back(v);
+		for ( TaxonomyVertex::const_iterator p = v->begin(/*upDirection=*/true), p_end = v->end(/*upDirection=*/true); p != p_end; ++p )
+			todo.push_back(*p);
+	}
+
+	// top-down search: a vertex is tested only if all its parents are types of IND
+	while ( !positive.empty() )
+	{
+		const TaxonomyVertex* cur = positive.back();
+		positive.pop_back();
+		for ( TaxonomyVertex::const_iterator p = cur->begin(/*upDirection=*/false), p_end = cur->end(/*upDirection=*/false); p != p_end; ++p )
+		{
+			const TaxonomyVertex* v = *p;
+			if ( v == pTax->getBottomVertex() || values.count(v) > 0 )
+				continue;
+
+			bool allParents = true;
+			for ( TaxonomyVertex::const_iterator q = v->begin(/*upDirection=*/true), q_end = v->end(/*upDirection=*/true); q != q_end && allParents; ++q )
+			{
+				VertexValues::const_iterator found = values.find(*q);
+				allParents = found != values.end() && found->second;
+			}
+			if ( !allParents )	// will be checked from the last positive parent
+				continue;
+
+			// the tests against individuals are left to the main reasoner
+			const TConcept* C = static_cast<const TConcept*>(v->getPrimer());
+			if ( C->isSingleton() )
+				continue;
+
+			bool res;
+			if ( !testTypeCheaply ( ind, sig, C, res ) )
+			{
+				TSubTask task ( ind, C );
+				worker.runTask(task);
+				if ( !task.done )	// cancelled or failed: the main reasoner will do the rest
+					continue;
+				res = task.result;
+				types.push_back(std::make_pair(C,res));
+			}
+			values[v] = res;
+			if ( res )
+				positive.push_back(v);
+		}
+	}
+
+	std::sort ( types.begin(), types.end() );
+}
+
+/// test individuals from INDS, taken by the shared counter NEXT, using WORKER; decrease NRUNNING when done
+void
+DLConceptTaxonomy :: realiseIndividuals ( NominalWorker* worker, const TBox::ConceptVector* inds, std::atomic<size_t>* next, std::atomic<unsigned int>* nRunning )
+{
+	// every individual has its own place in preRealised, so no synchronisation is necessary
+	if ( worker->init() )
+		for ( size_t i = (*next)++; i < inds->size(); i = (*next)++ )
+		{
+			const TIndividual* ind = static_cast<const TIndividual*>((*inds)[i]);
+			searchTypes ( *worker, ind, preRealised[ind->getId()] );
+		}
+	--(*nRunning);
+}
+
+/// test individuals INDS against the complete concept taxonomy in NTHREADS threads
+void
+DLConceptTaxonomy :: preRealise ( const TBox::ConceptVector& inds, unsigned int nThreads )
+{
+	if ( inds.empty() )
+		return;
+
+	// workers can only read the caches, so create all the caches for the cheap tests here
+	size_t maxId = 0;
+	for ( TBox::ConceptVector::const_iterator p = inds.begin(), p_end = inds.end(); p != p_end; ++p )
+	{
+		tBox.initCache ( *p, /*sub=*/false );
+		maxId = std::max ( maxId, static_cast<size_t>((*p)->getId()) );
+	}
+	std::set<const TaxonomyVertex*> visited;
+	std::vector<const TaxonomyVertex*> todo(1,pTax->getTopVertex());
+	while ( !todo.empty() )
+	{
+		const TaxonomyVertex* v = todo.back();
+		todo.pop_back();
+		if ( !visited.insert(v).second )
+			continue;
+		const TConcept* C = static_cast<const TConcept*>(v->getPrimer());
+		if ( v != pTax->getTopVertex() && !C->isSingleton() )
+			tBox.initCache ( C, /*sub=*/true );
+		for ( TaxonomyVertex::const_iterator p = v->begin(/*upDirection=*/false), p_end = v->end(/*upDirection=*/false); p != p_end; ++p )
+			if ( *p != pTax->getBottomVertex() )
+				todo.push_back(*p);
+	}
+
+	preRealised.clear();
+	preRealised.resize(maxId+1);
+
+	// reasoners should be created in the main thread as they read the TBox
+	std::atomic<bool> cancelled(false);
+	std::atomic<size_t> next(0);
+	std::atomic<unsigned int> nRunning(nThreads);
+	std::vector<NominalWorker*> workers;
+	std::vector<std::thread> threads;
+	for ( unsigned int i = 0; i < nThreads; ++i )
+		workers.push_back(new NominalWorker(tBox,cancelled));
+	for ( std::vector<NominalWorker*>::iterator p = workers.begin(), p_end = workers.end(); p != p_end; ++p )
+		threads.push_back(std::thread(&DLConceptTaxonomy::realiseIndividuals,this,*p,&inds,&next,&nRunning));
+
+	// progress monitor could only be asked from the main thread
+	while ( nRunning > 0 )
+	{
+		if ( tBox.isCancelled() )
+			cancelled = true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	}
+	for ( std::vector<std::thread>::iterator p = threads.begin(), p_end = threads.end(); p != p_end; ++p )
+		p->join();
+	for ( std::vector<NominalWorker*>::iterator q = workers.begin(), q_end = workers.end(); q != q_end; ++q )
+		delete *q;
+}
+
 bool
 DLConceptTaxonomy :: enhancedSubs1 ( TaxonomyVertex* cur )
 {
@@ -374,136 +612,33 @@ DLConceptTaxonomy :: mergeSplitVars ( TSplitVar* split )
 	}
 }
 
-void 		/// fill candidates
-DLConceptTaxonomy :: fillCandidates ( TaxonomyVertex* cur )
-{
-//	std::cout << "fill candidates: " << cur->getPrimer()->getName() << std::endl;
-	if ( isValued(cur) )
-	{
-		if ( getValue(cur) )	// positive value -- nothing to do
-			return;
-	}
-	else
-		candidates.insert(cur);
-
-	for ( TaxonomyVertex::iterator p = cur->begin(true), p_end = cur->end(true); p != p_end; ++p )
-		fillCandidates(*p);
-}
-
 void
-DLConceptTaxonomy ::  reclassify ( const std::set<const TNamedEntity*>& plus, const std::set<const TNamedEntity*>& minus )
+DLConceptTaxonomy :: reclassify ( const std::set<const TNamedEntity*>& plus, const std::set<const TNamedEntity*>& minus )
 {
-	MPlus = plus;
-	MMinus = minus;
+	preTested.clear();
 	pTax->deFinalise();
 
-	// fill in an order to
-	std::queue<TaxonomyVertex*> queue;
-	std::vector<const ClassifiableEntry*> toProcess;
-	queue.push(pTax->getTopVertex());
-	while ( !queue.empty() )
+	// take all the changed entries out of the taxonomy; the rest of it remains correct
+	std::set<const TNamedEntity*> changed(plus);
+	changed.insert ( minus.begin(), minus.end() );
+	std::vector<TConcept*> toProcess;
+	for ( std::set<const TNamedEntity*>::const_iterator p = changed.begin(), p_end = changed.end(); p != p_end; ++p )
 	{
-		TaxonomyVertex* cur = queue.front();
-		queue.pop();
-		if ( pTax->isVisited(cur) )
+		TConcept* C = dynamic_cast<TConcept*>((*p)->getEntry());
+		if ( C == NULL )	// FIXME!! only concepts for now
 			continue;
-		pTax->setVisited(cur);
-		const ClassifiableEntry* entry = cur->getPrimer();
-		const TNamedEntity* entity = entry->getEntity();
-		if ( MPlus.find(entity) != MPlus.end() || MMinus.find(entity) != MMinus.end() )
-			toProcess.push_back(entry);
-		for ( TaxonomyVertex::iterator p = cur->begin(/*upDirection=*/false), p_end = cur->end(/*upDirection=*/false); p != p_end; ++p )
-			queue.push(*p);
+		if ( C->isClassified() )
+			pTax->removeEntry(C);
+		toProcess.push_back(C);
 	}
-	pTax->clearVisited();
-//	std::cout << "Add/Del names Taxonomy:\n";
-//	pTax->print(std::cout);
 
-	for ( std::vector<const ClassifiableEntry*>::iterator p = toProcess.begin(), p_end = toProcess.end(); p != p_end; ++p )
-	{
-		TaxonomyVertex* node = (*p)->getTaxVertex();
-		const TNamedEntity* entity = (*p)->getEntity();
-		std::cout << "Reclassify " << entity->getName() << " (" << (MPlus.count(entity) > 0 ?"Added":"") << (MMinus.count(entity) > 0 ?" Removed":"") << ")";
-
-		TsProcTimer timer;
-		timer.Start();
-		reclassify ( node, (*tBox.pName2Sig)[entity] );
-		timer.Stop();
-		std::cout << "; reclassification time: " << timer << std::endl;
-//		tax->print(std::cout);
-//		std::cout.flush();
-	}
+	// put them back; their place is unknown, so both TD and BU phases are necessary
+	setCompletelyDefined(false);
+	for ( std::vector<TConcept*>::iterator p = toProcess.begin(), p_end = toProcess.end(); p != p_end; ++p )
+		if ( !(*p)->isClassified() )	// could be classified as a told subsumer of another one
+			classifyEntry(*p);
 
 	pTax->finalise();
-//	print(std::cout);
-//	std::cout.flush();
-}
-
-void
-DLConceptTaxonomy :: reclassify ( TaxonomyVertex* node, const TSignature* s )
-{
-	upDirection = false;
-	sigStack.push(s);
-	curEntry = node->getPrimer();
-	TaxonomyVertex* oldCur = pTax->getCurrent();
-	pTax->setCurrent(node);
-
-	// FIXME!! check the unsatisfiability later
-
-	bool added = MPlus.count(curEntry->getEntity()) > 0;
-	bool removed = MMinus.count(curEntry->getEntity()) > 0;
-	fpp_assert ( added || removed );
-	typedef std::vector<TaxonomyVertex*> TVArray;
-	clearLabels();
-
-	setValue ( pTax->getTopVertex(), true );
-	if ( node->noNeighbours(true) )
-		node->addNeighbour(true, pTax->getTopVertex());
-
-	// we use candidates set if nothing was added (so no need to look further from current subs)
-	useCandidates = !added;
-	candidates.clear();
-	if ( removed )	// re-check all parents
-	{
-		TVArray pos, neg;
-		for ( TaxonomyVertex::iterator p = node->begin(true), p_end = node->end(true); p != p_end; ++p )
-		{
-			if ( isValued(*p) && getValue(*p) )
-				continue;
-			bool sub = testSubsumption(*p);
-			if ( sub )
-			{
-				pos.push_back(*p);
-				propagateTrueUp(*p);
-			}
-			else
-			{
-				setValue ( *p, sub );
-				neg.push_back(*p);
-			}
-		}
-		node->removeLinks(true);
-//		for ( TVArray::iterator q = pos.begin(), q_end = pos.end(); q != q_end; ++q )
-//			node->addNeighbour(true, *q);
-		if ( useCandidates )
-			for ( TVArray::iterator q = neg.begin(), q_end = neg.end(); q != q_end; ++q )
-				fillCandidates(*q);
-	}
-	else	// all parents are there
-	{
-		for ( TaxonomyVertex::iterator p = node->begin(true), p_end = node->end(true); p != p_end; ++p )
-			propagateTrueUp(*p);
-		node->removeLinks(true);
-	}
-
-	// FIXME!! for now. later check the equivalence etc
-	setValue ( node, true );
-	// the landscape is prepared
-	searchBaader(pTax->getTopVertex());
-	node->incorporate();
-	clearLabels();
-	sigStack.pop();
-	pTax->setCurrent(oldCur);
 }
 
 /********************************************************\
@@ -522,6 +657,9 @@ void TBox :: createTaxonomy ( bool needIndividual )
 	if ( pTax == NULL )	// 1st run
 		initTaxonomy();
 
+	// create reasoners for parallel subsumption tests if necessary
+	getReasonerPool();
+
 	DLHeap.setSubOrder();	// init priorities in order to do subsumption tests
 	pTaxCreator->setBottomUp(GCIs);
 	needConcept |= needIndividual;	// together with concepts
@@ -541,6 +679,8 @@ void TBox :: createTaxonomy ( bool needIndividual )
 
 	// calculate number of items to be classified
 	unsigned int nItems = 0;
+	// individuals would be classified after all the concepts
+	const bool parallelRealisation = canRealiseInParallel();
 
 	// fills collections
 	arrayCD.clear();
@@ -550,7 +690,17 @@ void TBox :: createTaxonomy ( bool needIndividual )
 //	if ( needConcept )
 		nItems += fillArrays ( c_begin(), c_end() );
 //	if ( needIndividual || nNominalReferences > 0 )	// TODO ORE
-		nItems += fillArrays ( i_begin(), i_end() );
+	if ( !parallelRealisation )
+	{
+		// individuals of the same ABox component share the nominal cloud, so classify them together
+		ConceptVector inds;
+		getIndividualsByComponent(inds);
+		nItems += fillArrays ( inds.begin(), inds.end() );
+	}
+	else
+		for ( i_iterator pi = i_begin(); pi != i_end(); ++pi )
+			if ( !(*pi)->isNonClassifiable() )
+				++nItems;
 
 	// taxonomy progress
 	if ( pMonitor )
@@ -568,6 +718,9 @@ void TBox :: createTaxonomy ( bool needIndividual )
 //	sort ( arrayNP.begin(), arrayNP.end(), TSDepthCompare() );
 	classifyConcepts ( arrayNP, false, "non-primitive" );
 
+	if ( parallelRealisation )
+		realiseInParallel();
+
 	duringClassification = false;
 
 	pTaxCreator->processSplits();
@@ -581,6 +734,7 @@ void TBox :: createTaxonomy ( bool needIndividual )
 	pTax->finalise();
 
 	locTimer.Stop();
+	classifyTime += locTimer;
 	if ( verboseOutput )
 		std::cerr << " done in " << locTimer << " seconds\n";
 
@@ -596,6 +750,32 @@ void TBox :: createTaxonomy ( bool needIndividual )
 	}
 }
 
+void
+TBox :: realiseInParallel ( void )
+{
+	// individuals of the same ABox component share the nominal cloud, so process them together
+	ConceptVector all;
+	getIndividualsByComponent(all);
+	arrayCD.clear();
+	arrayNoCD.clear();
+	arrayNP.clear();
+	fillArrays ( all.begin(), all.end() );
+
+	// test all the individuals against the concept taxonomy concurrently...
+	ConceptVector inds;
+	for ( ConceptVector::const_iterator p = all.begin(), p_end = all.end(); p != p_end; ++p )
+		if ( !(*p)->isNonClassifiable() && !(*p)->isClassified() )
+			inds.push_back(*p);
+	if ( !isCancelled() )
+		pTaxCreator->preRealise ( inds, nThreads );
+
+	// ... and insert them into the taxonomy in the usual order, so the result is deterministic
+	classifyConcepts ( arrayCD, true, "completely defined" );
+	classifyConcepts ( arrayNoCD, false, "regular" );
+	classifyConcepts ( arrayNP, false, "non-primitive" );
+	pTaxCreator->clearPreRealised();
+}
+
 void
 TBox :: classifyConcepts ( const ConceptVector& collection, bool curCompletelyDefined, const char* type )
 {
@@ -19,16 +19,24 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef DLCONCEPTTAXONOMY_H
 #define DLCONCEPTTAXONOMY_H
 
+#include <atomic>
+
 #include "TaxonomyCreator.h"
 #include "dlTBox.h"
 #include "tProgressMonitor.h"
 #include "tSplitVars.h"
 
+class NominalWorker;
+
 /// Taxonomy of named DL concepts (and mapped individuals)
 class DLConceptTaxonomy: public TaxonomyCreator
 {
 protected:	// types
 	typedef std::vector<TaxonomyVertex*> TaxVertexVec;
+		/// map between subsumption test and its result
+	typedef std::map<std::pair<const TConcept*, const TConcept*>, bool> SubResultMap;
+		/// results of the tests IND [= C of an individual, sorted by C
+	typedef std::vector<std::pair<const TConcept*, bool> > TypeResults;
 		/// all the derived subsumers of a class (came from the model)
 	class DerivedSubsumers: public KnownSubsumers
 	{
@@ -67,16 +75,14 @@ protected:	// types
 protected:	// members
 		/// host tBox
 	TBox& tBox;
-		/// incremental sets M+ and M-
-	std::set<const TNamedEntity*> MPlus, MMinus;
-		/// set of possible parents
-	std::set<TaxonomyVertex*> candidates;
-		/// whether look into it
-	bool useCandidates;
 		/// common descendants of all parents of currently classified concept
 	TaxVertexVec Common;
 		/// number of processed common parents
 	unsigned int nCommon;
+		/// results of the subsumption tests performed in advance by the reasoner pool
+	SubResultMap preTested;
+		/// results of the realisation tests performed in advance by the nominal workers, indexed by individual's id
+	std::vector<TypeResults> preRealised;
 
 	// statistic counters
 	unsigned long nConcepts;
@@ -121,10 +127,36 @@ protected:	// methods
 	const TConcept* curConcept ( void ) const { return static_cast<const TConcept*>(curEntry); }
 		/// tests subsumption (via tBox) and gather statistics.  Use cache and other optimisations.
 	bool testSub ( const TConcept* p, const TConcept* q );
+		/// @return true iff the test P [= Q can not be answered by testSub without a tableau reasoning
+	bool needTableauTest ( const TConcept* p, const TConcept* q );
+		/// @return true and set RES iff the result of P [= Q test was obtained by the reasoner pool
+	bool getPreTested ( const TConcept* p, const TConcept* q, bool& res )
+	{
+		SubResultMap::iterator found = preTested.find(std::make_pair(p,q));
+		if ( found == preTested.end() )
+			return getPreRealised ( p, q, res );
+		res = found->second;
+		preTested.erase(found);
+		return true;
+	}
+		/// @return true and set RES iff the result of P [= Q test was obtained by a nominal worker
+	bool getPreRealised ( const TConcept* p, const TConcept* q, bool& res ) const
+	{
+		if ( !p->isSingleton() || static_cast<size_t>(p->getId()) >= preRealised.size() )
+			return false;
+		const TypeResults& types = preRealised[p->getId()];
+		TypeResults::const_iterator found = std::lower_bound ( types.begin(), types.end(), std::make_pair ( q, false ) );
+		if ( found == types.end() || found->first != q )
+			return false;
+		res = found->second;
+		return true;
+	}
 		/// test subsumption via TBox explicitely
 	bool testSubTBox ( const TConcept* p, const TConcept* q )
 	{
-		bool res = tBox.isSubHolds ( p, q );
+		bool res;
+		if ( !getPreTested ( p, q, res ) )
+			res = tBox.isSubHolds ( p, q );
 
 		// update statistic
 		++nTries;
@@ -141,6 +173,10 @@ protected:	// methods
 
 		/// SEARCH procedure from Baader et al paper
 	void searchBaader ( TaxonomyVertex* cur );
+		/// @return true iff ENHANCED_SUBS of CUR would lead to its explicit test
+	bool isTestInevitable ( TaxonomyVertex* cur ) const;
+		/// perform all inevitable tests of CUR's successors using the reasoner pool
+	void runParallelTests ( TaxonomyVertex* cur );
 		/// ENHANCED_SUBS procedure from Baader et al paper
 	bool enhancedSubs1 ( TaxonomyVertex* cur );
 		/// short-cut from ENHANCED_SUBS
@@ -152,8 +188,6 @@ protected:	// methods
 		// for top-down search it's enough to look at defined concepts and non-det ones
 //		if ( likely(!inSplitCheck && !upDirection) && !possibleSub(cur) )
 //			return false;
-		if ( unlikely ( useCandidates && candidates.find(cur) == candidates.end() ) )
-			return false;
 		return enhancedSubs1(cur);
 	}
 		// wrapper for the ENHANCED_SUBS
@@ -178,10 +212,16 @@ protected:	// methods
 		// all others should be in the possible sups list
 		return ksStack.top()->isPossibleSub(C);
 	}
-		/// @return true if non-subsumption is due to ENTITY is not in the \bot-module
-	bool isNotInModule ( const TNamedEntity* entity ) const;
-		/// reclassify node
-	void reclassify ( TaxonomyVertex* node, const TSignature* s );
+		/// @return signature of the \bot-module of P; NULL if not known
+	TSignature* getSignature ( const ClassifiableEntry* p ) const;
+		/// @return true if non-subsumption P [= Q is due to Q is not in the \bot-module of P
+	bool isNotInModule ( const TConcept* p, const TConcept* q ) const;
+		/// @return true if Q is not in the \bot-module signature SIG (if known)
+	static bool isNotInSignature ( const TSignature* sig, const TConcept* q )
+	{
+		const TNamedEntity* entity = q->getEntity();
+		return sig && entity && !sig->contains(entity);
+	}
 
 		/// propagate common value from NODE to all its descendants; save visited nodes
 	void propagateOneCommon ( TaxonomyVertex* node );
@@ -196,8 +236,6 @@ protected:	// methods
 	}
 		/// check if concept is unsat; add it as a synonym of BOTTOM if necessary
 	bool isUnsatisfiable ( void );
-		/// fill candidates
-	void fillCandidates ( TaxonomyVertex* cur );
 
 	//-----------------------------------------------------------------
 	//--	Tunable methods (depending on taxonomy type)
@@ -240,10 +278,22 @@ protected:	// methods
 					searchBaader(*p);
 	}
 
+	//-----------------------------------------------------------------
+	//--	Parallel realisation
+	//-----------------------------------------------------------------
+
+		/// @return true iff the test IND [= C could be answered without a tableau using the \bot-module signature SIG of IND; set RES in this case
+	bool testTypeCheaply ( const TIndividual* ind, const TSignature* sig, const TConcept* C, bool& res ) const;
+		/// put into TYPES results of the tests of IND against the concept taxonomy, made by WORKER
+	void searchTypes ( NominalWorker& worker, const TIndividual* ind, TypeResults& types ) const;
+		/// test individuals from INDS, taken by the shared counter NEXT, using WORKER; decrease NRUNNING when done
+	void realiseIndividuals ( NominalWorker* worker, const TBox::ConceptVector* inds, std::atomic<size_t>* next, std::atomic<unsigned int>* nRunning );
+
 		/// actions that to be done BEFORE entry will be classified
 	virtual void preClassificationActions ( void )
 	{
 		++nConcepts;
+		preTested.clear();
 		if ( pTaxProgress != NULL )
 			pTaxProgress->nextClass();
 	}
@@ -271,7 +321,6 @@ public:		// interface
 	DLConceptTaxonomy ( Taxonomy* tax, TBox& kb )
 		: TaxonomyCreator(tax)
 		, tBox(kb)
-		, useCandidates(false)
 		, nConcepts (0), nTries (0), nPositives (0), nNegatives (0)
 		, nSearchCalls(0)
 		, nSubCalls(0)
@@ -295,8 +344,12 @@ public:		// interface
 	}
 		/// set bottom-up flag
 	void setBottomUp ( const TKBFlags& GCIs ) { flagNeedBottomUp = (GCIs.isGCI() || (GCIs.isReflexive() && GCIs.isRnD())); }
-		/// reclassify taxonomy wrt changed sets
+		/// reclassify entities from the changed sets MPLUS and MMINUS wrt the rest of the taxonomy
 	void reclassify ( const std::set<const TNamedEntity*>& MPlus, const std::set<const TNamedEntity*>& MMinus );
+		/// test individuals INDS against the complete concept taxonomy in NTHREADS threads
+	void preRealise ( const TBox::ConceptVector& inds, unsigned int nThreads );
+		/// forget the results of the pre-realisation
+	void clearPreRealised ( void ) { preRealised.clear(); }
 		/// set progress indicator
 	void setProgressIndicator ( TProgressMonitor* pMon ) { pTaxProgress = pMon; }
 		/// output taxonomy to a stream
@@ -60,7 +60,9 @@ fillDTReasoner ( DataTypeReasoner& DTR, const DlCompletionTree* node )
 void
 ReasoningKernel :: getDataRelatedIndividuals ( TDRoleExpr* R, TDRoleExpr* S, int op, IndividualSet& Result )
 {
+	TQueryGuard guard(this);
 	preprocessKB();	// ensure KB is ready to answer the query
+	getTBox()->initIndividualNodes();	// the nodes of the individuals are read here
 	Result.clear();
 	const TRole* r = getRole ( R, "Role expression expected in the getDataRelatedIndividuals()" );
 	const TRole* s = getRole ( S, "Role expression expected in the getDataRelatedIndividuals()" );
@@ -110,113 +110,83 @@ ReasoningKernel :: doIncremental ( void )
 
 	// detect new- and old- signature elements
 	TSignature NewSig = Ontology.getSignature();
-	TSignature::BaseType RemovedEntities, AddedEntities;
-	std::set_difference(OntoSig.begin(), OntoSig.end(), NewSig.begin(), NewSig.end(), inserter(RemovedEntities, RemovedEntities.begin()));
-	std::set_difference(NewSig.begin(), NewSig.end(), OntoSig.begin(), OntoSig.end(), inserter(AddedEntities, AddedEntities.begin()));
+	const TSignature::BaseType RemovedEntities = difference ( OntoSig, NewSig );
+	const TSignature::BaseType AddedEntities = difference ( NewSig, OntoSig );
 
 	Taxonomy* tax = getCTaxonomy();
 //	std::cout << "Original Taxonomy:";
 //	tax->print(std::cout);
 
-	// deal with removed concepts
-	TSignature::BaseType::iterator e, e_end;
+	// deal with removed concepts: they are fresh now, so just take them out of the taxonomy
+	TSignature::BaseType::const_iterator e, e_end;
+	tax->deFinalise();
 	for ( e = RemovedEntities.begin(), e_end = RemovedEntities.end(); e != e_end; ++e )
 		if ( const TConcept* C = dynamic_cast<const TConcept*>((*e)->getEntry()) )
 		{
-			excluded.insert(C);
-			// remove all links
-			C->getTaxVertex()->remove();
+			if ( C->isClassified() )
+				tax->removeEntry(C);
 			// update Name2Sig
-			delete Name2Sig[*e];
-			Name2Sig.erase(*e);
+			NameSigMap::iterator sig = Name2Sig.find(*e);
+			if ( sig != Name2Sig.end() )
+			{
+				delete sig->second;
+				Name2Sig.erase(sig);
+			}
 		}
+	tax->finalise();
 
-	// deal with added concepts
-	tax->deFinalise();
+	// deal with added concepts: they are not in the taxonomy yet, so they have to be classified
 	for ( e = AddedEntities.begin(), e_end = AddedEntities.end(); e != e_end; ++e )
-		if ( const TDLConceptName* cName = dynamic_cast<const TDLConceptName*>(*e) )
-		{
-			// register the name in TBox
-			TreeDeleter TD(this->e(cName));
-			TConcept* C = dynamic_cast<TConcept*>(cName->getEntry());
-			// create sig for it
-			setupSig(cName);
-			// init the taxonomy element
-			TaxonomyVertex* cur = tax->getCurrent();
-			cur->clear();
-			cur->setSample(C);
-			cur->addNeighbour ( /*upDirection=*/true, tax->getTopVertex() );
-			tax->finishCurrentNode();
-//			std::cout << "Insert " << C->getName() << std::endl;
-		}
+		if ( dynamic_cast<const TDLConceptName*>(*e) != NULL )
+			MPlus.insert(*e);
 	OntoSig = NewSig;
 
 	// fill in M^+ and M^- sets
 	TsProcTimer t;
 	t.Start();
+	// index the changed axioms, so only the ones sharing entities with a module are checked for locality
 	LocalityChecker* lc = getModExtractor(false)->getModularizer()->getLocalityChecker();
-	TOntology::iterator p, nb = Ontology.beginUnprocessed(), ne = Ontology.end(), rb = Ontology.beginRetracted(), re = Ontology.endRetracted();
-//	TLISPOntologyPrinter pr(std::cout);
-//	for ( p = nb; p != ne; ++p )
-//	{
-//		std::cout << "Add:";
-//		(*p)->accept(pr);
-//	}
-//	for ( p = rb; p != re; ++p )
-//	{
-//		std::cout << "Del:";
-//		(*p)->accept(pr);
-//	}
+	SigIndex AddedIndex(lc), RetractedIndex(lc);
+	AddedIndex.preprocessAxioms ( Ontology.beginUnprocessed(), Ontology.end() );
+	RetractedIndex.preprocessAxioms ( Ontology.beginRetracted(), Ontology.endRetracted() );
 	for ( NameSigMap::iterator p = Name2Sig.begin(), p_end = Name2Sig.end(); p != p_end; ++p )
 	{
-		lc->setSignatureValue(*p->second);
-		for ( TOntology::iterator notProcessed = nb; notProcessed != ne; ++notProcessed )
-			if ( !lc->local(*notProcessed) )
-			{
-				MPlus.insert(p->first);
-//				std::cout << "Non-local NP axiom ";
-//				(*notProcessed)->accept(pr);
-//				std::cout << " wrt " << p->first->getName() << std::endl;
-				break;
-			}
-		for ( TOntology::iterator retracted = rb; retracted != re; retracted++ )
-			if ( !lc->local(*retracted) )
-			{
-				MMinus.insert(p->first);
-				// FIXME!! only concepts for now
-				TaxonomyVertex* v = dynamic_cast<const ClassifiableEntry*>(p->first->getEntry())->getTaxVertex();
-				if ( v->noNeighbours(true) )
-				{
-					v->addNeighbour(true,tax->getTopVertex());
-					tax->getTopVertex()->addNeighbour(false,v);
-				}
-//				std::cout << "Non-local RT axiom ";
-//				(*retracted)->accept(pr);
-//				std::cout << " wrt " << p->first->getName() << std::endl;
-				break;
-			}
+		if ( AddedIndex.hasNonLocal(*p->second) )
+			MPlus.insert(p->first);
+		if ( RetractedIndex.hasNonLocal(*p->second) )
+			MMinus.insert(p->first);
 	}
 	t.Stop();
-	std::cout << "Determine concepts that need reclassification: done in " << t << std::endl;
+	std::cout << "Determine concepts that need reclassification (" << MPlus.size() << " added, " << MMinus.size()
+			  << " removed): done in " << t << std::endl;
 
 	// build changed modules
 	std::set<const TNamedEntity*> toProcess(MPlus);
 	toProcess.insert ( MMinus.begin(), MMinus.end() );
+	// the module of every changed entity is a part of the module of all of them, so look there
+	TSignature ChangedSig;
+	for ( std::set<const TNamedEntity*>::iterator p = toProcess.begin(), p_end = toProcess.end(); p != p_end; ++p )
+		ChangedSig.add(*p);
+	const AxiomVec Module = getModExtractor(false)->getModule ( ChangedSig, M_BOT );
+	// start from the largest (old) modules, so the smaller ones are extracted from them recursively
+	typedef std::vector<std::pair<size_t, const TNamedEntity*> > SizedEntityVec;
+	SizedEntityVec order;
+	for ( std::set<const TNamedEntity*>::iterator p = toProcess.begin(), p_end = toProcess.end(); p != p_end; ++p )
+	{
+		NameSigMap::iterator found = Name2Sig.find(*p);
+		order.push_back ( std::make_pair ( found == Name2Sig.end() ? 0 : found->second->size(), *p ) );
+	}
+	std::sort ( order.rbegin(), order.rend() );
 	// process all entries recursively
-	while ( !toProcess.empty() )
-		buildSignature ( *toProcess.begin(), Ontology.getAxioms(), toProcess );
-
-	tax->finalise();
-//	std::cout << "Adjusted Taxonomy:";
-//	tax->print(std::cout);
+	for ( SizedEntityVec::const_iterator p = order.begin(), p_end = order.end(); p != p_end; ++p )
+		if ( toProcess.count(p->second) > 0 )	// not processed yet
+			buildSignature ( p->second, Module, toProcess );
 
 	t.Reset();
 	t.Start();
 	// save taxonomy
 	SaveLoadManager SLManager("Incremental");
 	SLManager.prepare(/*input=*/false);
-	// FIXME!! for now
-	excluded.clear();
 	getTBox()->SaveTaxonomy(SLManager,excluded);
 
 	// do actual change
@@ -233,9 +203,8 @@ ReasoningKernel :: doIncremental ( void )
 
 	std::cout << "Reloading ontology: done in " << t << std::endl;
 
-	tax = getCTaxonomy();
 //	std::cout << "Reloaded Taxonomy:";
-//	tax->print(std::cout);
+//	getCTaxonomy()->print(std::cout);
 //	std::cout.flush();
 
 	subCheckTimer.Start();
@@ -24,6 +24,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "OntologyBasedModularizer.h"
 #include "eFPPSaveLoad.h"
 #include "SaveLoadManager.h"
+#include "ReasonerPool.h"
+#include "RoleAssertionIndex.h"
 
 const char* ReasoningKernel :: Version = "1.6.3";
 const char* ReasoningKernel :: SupportedDL = "SROIQ(D)";
@@ -46,12 +48,15 @@ ReasoningKernel :: ReasoningKernel ( void )
 	, ModSem(NULL)
 	, JNICache(NULL)
 	, pSLManager(NULL)
+	, pCacheSLManager(NULL)
 	, pMonitor(NULL)
 	, OpTimeout(0)
 	, verboseOutput(false)
 	, useUndefinedNames(true)
 	, cachedQuery(NULL)
 	, cachedQueryTree(NULL)
+	, frozenKB(false)
+	, queryDepth(0)
 	, reasoningFailed(false)
 	, NeedTracing(false)
 	, useAxiomSplitting(false)
@@ -81,6 +86,7 @@ ReasoningKernel :: ~ReasoningKernel ( void )
 	deleteTree(cachedQueryTree);
 	delete pMonitor;
 	delete pSLManager;
+	delete pCacheSLManager;
 	for ( NameSigMap::iterator p = Name2Sig.begin(), p_end = Name2Sig.end(); p != p_end; ++p )
 		delete p->second;
 }
@@ -178,6 +184,8 @@ ReasoningKernel :: ClassifyOrLoad ( bool needIndividuals )
 				// fail to load -- fall through to the real action
 			}
 		}
+		// KB was changed: reuse the model caches of its unchanged part
+		LoadModelCaches();
 	}
 	// perform the real classification
 	if ( needIndividuals )
@@ -187,7 +195,10 @@ ReasoningKernel :: ClassifyOrLoad ( bool needIndividuals )
 
 	// save the result if necessary
 	if ( pSLManager != NULL )
+	{
 		Save();
+		SaveModelCaches();
+	}
 }
 
 void
@@ -395,12 +406,243 @@ ReasoningKernel :: checkSub ( TConcept* C, TConcept* D )
 	if ( getStatus() < kbClassified )	// unclassified => do via SAT test
 		return getTBox()->isSubHolds ( C, D );
 	// classified => do the taxonomy traversal
+	return checkTaxSub ( C->getTaxVertex(), D );
+}
+
+/// @return true iff the vertex V of a classified taxonomy is a sub-vertex of the one of D
+bool
+ReasoningKernel :: checkTaxSub ( TaxonomyVertex* v, TConcept* D )
+{
 	SupConceptActor actor(D);
 	Taxonomy* tax = getCTaxonomy();
-	try { tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/false, /*upDirection=*/true> ( C->getTaxVertex(), actor ); return false; }
+	try { tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/false, /*upDirection=*/true> ( v, actor ); return false; }
 	catch (...) { tax->clearVisited(); return true; }
 }
 
+//-------------------------------------------------
+// batch subsumption query implementation
+//-------------------------------------------------
+
+void
+ReasoningKernel :: isSubsumedBy ( const TConceptExprPairVec& queries, std::vector<bool>& results )
+{
+	results.assign ( queries.size(), false );
+	if ( queries.empty() )
+		return;
+
+	TQueryGuard guard(this);
+	preprocessKB();
+
+	// queries between named concepts; the rest are grouped by the sub-concept to share its cache
+	typedef std::map<TConceptExpr*, std::vector<size_t> > TQueryGroups;
+	std::vector<size_t> named;
+	TQueryGroups groups;
+
+	for ( size_t i = 0; i < queries.size(); ++i )
+	{
+		TConceptExpr* C = queries[i].first;
+		TConceptExpr* D = queries[i].second;
+		if ( C == D )	// easy case
+		{
+			results[i] = true;
+			continue;
+		}
+		// named concepts in a frozen KB: check the taxonomy
+		TaxonomyVertex* dV = getFrozenVertex(D);
+		TaxonomyVertex* cV = dV != NULL ? getFrozenVertex(C) : NULL;
+		if ( cV != NULL )
+			results[i] = checkFrozenSub ( cV, dV );
+		else if ( isNameOrConst(D) && likely(isNameOrConst(C)) )
+			named.push_back(i);
+		else
+			groups[C].push_back(i);
+	}
+
+	checkNamedSubs ( queries, named, results );
+	for ( TQueryGroups::const_iterator p = groups.begin(), p_end = groups.end(); p != p_end; ++p )
+		checkSubsOf ( p->first, queries, p->second, results );
+}
+
+void
+ReasoningKernel :: checkNamedSubs ( const TConceptExprPairVec& queries, const std::vector<size_t>& idx, std::vector<bool>& results )
+{
+	std::vector<TConcept*> Sub, Sup;
+	Sub.reserve(idx.size());
+	Sup.reserve(idx.size());
+	for ( std::vector<size_t>::const_iterator p = idx.begin(), p_end = idx.end(); p != p_end; ++p )
+	{
+		Sub.push_back(getTBox()->getCI(TreeDeleter(e(queries[*p].first))));
+		Sup.push_back(getTBox()->getCI(TreeDeleter(e(queries[*p].second))));
+	}
+
+	std::vector<bool> done ( idx.size(), false );
+
+	// unclassified KB: try the model caches first, then run the remaining tableau tests in parallel if possible
+	if ( getStatus() < kbClassified )
+	{
+		TReasonerPool* pool = getTBox()->getReasonerPool();
+		TReasonerPool::TaskVector tasks;
+		std::vector<size_t> taskIdx;
+		for ( size_t k = 0; k < idx.size(); ++k )
+		{
+			TConcept* C = Sub[k];
+			TConcept* D = Sup[k];
+			if ( !isValid(C->pName) || !isValid(D->pName) || D->isTop() || C->isBottom() )
+				continue;
+			modelCacheState state = getTBox()->testCachedNonSubsumption ( C, D );
+			if ( state == csValid || state == csInvalid )	// C and not D is (un)satisfiable
+			{
+				results[idx[k]] = state == csInvalid;
+				done[k] = true;
+			}
+			else if ( pool != NULL && getTBox()->canTestInParallel ( C, D ) )
+			{
+				tasks.push_back(TSubTask(C,D));
+				taskIdx.push_back(k);
+			}
+		}
+		// single test would be done in the main thread as well
+		if ( tasks.size() > 1 )
+		{
+			pool->run(tasks);
+			for ( size_t t = 0; t < tasks.size(); ++t )
+				if ( tasks[t].done )
+				{
+					results[idx[taskIdx[t]]] = tasks[t].result;
+					done[taskIdx[t]] = true;
+				}
+		}
+	}
+
+	// the rest is done sequentially
+	for ( size_t k = 0; k < idx.size(); ++k )
+		if ( !done[k] )
+			results[idx[k]] = checkSub ( Sub[k], Sup[k] );
+}
+
+void
+ReasoningKernel :: checkSubsOf ( TConceptExpr* C, const TConceptExprPairVec& queries, const std::vector<size_t>& idx, std::vector<bool>& results )
+{
+	// named super-concepts are checked against the cached query concept C
+	std::vector<size_t> named, rest;
+	for ( std::vector<size_t>::const_iterator p = idx.begin(), p_end = idx.end(); p != p_end; ++p )
+		if ( isNameOrConst(queries[*p].second) )
+			named.push_back(*p);
+		else
+			rest.push_back(*p);
+
+	// single query is cheaper to answer directly
+	if ( named.size() < 2 )
+	{
+		rest.insert ( rest.end(), named.begin(), named.end() );
+		named.clear();
+	}
+
+	if ( !named.empty() )
+	{
+		bool classified = getStatus() >= kbClassified;
+		setUpCache ( C, classified ? csClassified : csSat );
+		TConcept* query = cachedConcept;
+		bool sat = getTBox()->isSatisfiable(query);
+
+		for ( std::vector<size_t>::const_iterator p = named.begin(), p_end = named.end(); p != p_end; ++p )
+		{
+			TConcept* D = getTBox()->getCI(TreeDeleter(e(queries[*p].second)));
+			if ( !sat || D->isTop() )
+				results[*p] = true;
+			else if ( !isValid(D->pName) || D->isBottom() )	// satisfiable C is not subsumed by fresh or empty D
+				results[*p] = false;
+			else if ( classified )	// C is in the taxonomy already
+				results[*p] = checkTaxSub ( cachedVertex, D );
+			else
+			{
+				modelCacheState state = getTBox()->testCachedNonSubsumption ( query, D );
+				if ( state == csValid || state == csInvalid )
+					results[*p] = state == csInvalid;
+				else
+					results[*p] = getTBox()->isSubHolds ( query, D );
+			}
+		}
+	}
+
+	for ( std::vector<size_t>::const_iterator p = rest.begin(), p_end = rest.end(); p != p_end; ++p )
+	{
+		DLTree* nD = createSNFNot(e(queries[*p].second));
+		results[*p] = !checkSatTree ( createSNFAnd ( e(C), nD ) );
+	}
+}
+
+//-------------------------------------------------
+// frozen KB support
+//-------------------------------------------------
+
+TaxonomyVertex*
+ReasoningKernel :: getFrozenVertex ( const TConceptExpr* C )
+{
+	if ( !frozenKB )
+		return NULL;
+	if ( unlikely ( dynamic_cast<const TDLConceptTop*>(C) != NULL ) )
+		return getCTaxonomy()->getTopVertex();
+	if ( unlikely ( dynamic_cast<const TDLConceptBottom*>(C) != NULL ) )
+		return getCTaxonomy()->getBottomVertex();
+	const TDLConceptName* name = dynamic_cast<const TDLConceptName*>(C);
+	// unknown entries are processed via the standard query mechanism
+	if ( name == NULL || name->getEntry() == NULL )
+		return NULL;
+	return static_cast<const ClassifiableEntry*>(name->getEntry())->getTaxVertex();
+}
+
+TaxonomyVertex*
+ReasoningKernel :: getFrozenVertex ( const TIndividualExpr* I )
+{
+	if ( !frozenKB )
+		return NULL;
+	const TDLIndividualName* name = dynamic_cast<const TDLIndividualName*>(I);
+	if ( name == NULL || name->getEntry() == NULL )
+		return NULL;
+	return static_cast<const ClassifiableEntry*>(name->getEntry())->getTaxVertex();
+}
+
+TRole*
+ReasoningKernel :: getFrozenRole ( const TRoleExpr* R )
+{
+	if ( !frozenKB )
+		return NULL;
+	const TNamedEntity* name = dynamic_cast<const TDLObjectRoleName*>(R);
+	if ( name == NULL )
+		name = dynamic_cast<const TDLDataRoleName*>(R);
+	if ( name == NULL || name->getEntry() == NULL )
+		return NULL;
+	return resolveSynonym(static_cast<TRole*>(name->getEntry()));
+}
+
+/// actor that throws an exception when a given vertex is found
+class SupVertexActor
+{
+protected:
+	const TaxonomyVertex* pv;
+public:
+	SupVertexActor ( const TaxonomyVertex* v ) : pv(v) {}
+	bool apply ( const TaxonomyVertex& v )
+	{
+		if ( &v == pv )
+			throw std::exception();
+		return true;
+	}
+}; // SupVertexActor
+
+/// @return true iff vertex C is a sub-vertex of D in a frozen concept taxonomy
+bool
+ReasoningKernel :: checkFrozenSub ( TaxonomyVertex* C, TaxonomyVertex* D )
+{
+	Taxonomy* tax = getCTaxonomy();
+	if ( C == D || D == tax->getTopVertex() || C == tax->getBottomVertex() )
+		return true;
+	SupVertexActor actor(D);
+	try { tax->getRelativesInfoConst</*needCurrent=*/false, /*onlyDirect=*/false, /*upDirection=*/true> ( C, actor ); return false; }
+	catch (...) { return true; }
+}
+
 //-------------------------------------------------
 // all-disjoint query implementation
 //-------------------------------------------------
@@ -408,6 +650,7 @@ ReasoningKernel :: checkSub ( TConcept* C, TConcept* D )
 bool
 ReasoningKernel :: isDisjointRoles ( void )
 {
+	TQueryGuard guard(this);
 	// grab all roles from the arg-list
 	typedef const std::vector<const TDLExpression*> TExprVec;
 	typedef std::vector<const TRole*> TRoleVec;
@@ -518,6 +761,15 @@ ReasoningKernel :: buildRelatedCache ( TIndividual* I, const TRole* R )
 	if ( R->isBottom() )
 		return CIVec();
 
+	// all fillers follow from the told assertions: no need to ask the reasoner
+	const RoleAssertionIndex& index = getTBox()->getRoleAssertionIndex();
+	if ( index.isComplete(R) )
+	{
+		CIVec ret;
+		index.getRelated ( I, R, ret );
+		return ret;
+	}
+
 	// now fills the query
 	RIActor actor;
 	// ask for instances of \exists R^-.{i}
@@ -535,15 +787,18 @@ ReasoningKernel :: buildRelatedCache ( TIndividual* I, const TRole* R )
 void
 ReasoningKernel :: getRelatedRoles ( const TIndividualExpr* I, NamesVector& Rs, bool data, bool needI )
 {
+	TQueryGuard guard(this);
 	realiseKB();	// ensure KB is ready to answer the query
 	Rs.clear();
 
 	TIndividual* i = getIndividual ( I, "individual name expected in the getRelatedRoles()" );
 	RoleMaster* RM = data ? getDRM() : getORM();
+	const RoleAssertionIndex& index = getTBox()->getRoleAssertionIndex();
 	for ( RoleMaster::iterator p = RM->begin(), p_end = RM->end(); p < p_end; ++p )
 	{
 		const TRole* R = *p;
-		if ( ( R->getId() > 0 || needI ) && !getRelated(i,R).empty() )
+		// told filler is enough to know that R is non-empty
+		if ( ( R->getId() > 0 || needI ) && ( ( !data && index.hasRelated(i,R) ) || !getRelated(i,R).empty() ) )
 			Rs.push_back(R);
 	}
 }
@@ -551,6 +806,7 @@ ReasoningKernel :: getRelatedRoles ( const TIndividualExpr* I, NamesVector& Rs,
 void
 ReasoningKernel :: getRoleFillers ( const TIndividualExpr* I, const TORoleExpr* R, IndividualSet& Result )
 {
+	TQueryGuard guard(this);
 	realiseKB();	// ensure KB is ready to answer the query
 	CIVec vec = getRelated ( getIndividual ( I, "Individual name expected in the getRoleFillers()" ),
 							 getRole ( R, "Role expression expected in the getRoleFillers()" ) );
@@ -562,6 +818,7 @@ ReasoningKernel :: getRoleFillers ( const TIndividualExpr* I, const TORoleExpr*
 bool
 ReasoningKernel :: isRelated ( const TIndividualExpr* I, const TORoleExpr* R, const TIndividualExpr* J )
 {
+	TQueryGuard guard(this);
 	realiseKB();	// ensure KB is ready to answer the query
 	TIndividual* i = getIndividual ( I, "Individual name expected in the isRelated()" );
 	TRole* r = getRole ( R, "Role expression expected in the isRelated()" );
@@ -569,8 +826,14 @@ ReasoningKernel :: isRelated ( const TIndividualExpr* I, const TORoleExpr* R, co
 		return false;	// FIXME!! not implemented
 
 	TIndividual* j = getIndividual ( J, "Individual name expected in the isRelated()" );
-	CIVec vec = getRelated ( i, r );
-	for ( CIVec::iterator p = vec.begin(), p_end = vec.end(); p < p_end; ++p )
+	const RoleAssertionIndex& index = getTBox()->getRoleAssertionIndex();
+	if ( index.isRelated ( i, r, j ) )
+		return true;
+	if ( index.isComplete(r) )
+		return false;
+
+	const CIVec& vec = getRelated ( i, r );
+	for ( CIVec::const_iterator p = vec.begin(), p_end = vec.end(); p < p_end; ++p )
 		if ( j == (*p) )
 			return true;
 
@@ -590,6 +853,7 @@ ReasoningKernel :: getAtomicDecompositionSize ( bool useSemantic, ModuleType mod
 		delete AD;
 
 	AD = new AtomicDecomposer(getModExtractor(useSemantic)->getModularizer());
+	AD->setNThreads(KernelOptions.getInt("nThreads"));
 	return AD->getAOS ( &Ontology, moduleType )->size();
 }
 	/// get a set of axioms that corresponds to the atom with the id INDEX
@@ -689,6 +953,8 @@ ReasoningKernel :: setSaveLoadContext ( const std::string& name )
 {
 	delete pSLManager;
 	pSLManager = new SaveLoadManager(name);
+	delete pCacheSLManager;
+	pCacheSLManager = new SaveLoadManager ( name, ".fpp.cache" );
 	return pSLManager->existsContent();
 }
 
@@ -696,6 +962,8 @@ ReasoningKernel :: setSaveLoadContext ( const std::string& name )
 bool
 ReasoningKernel :: clearSaveLoadContext ( const std::string& name ) const
 {
+	// model caches are useless without the state
+	SaveLoadManager ( name, ".fpp.cache" ).clearContent();
 	if ( checkSaveLoadContext(name) )
 	{
 		SaveLoadManager(name).clearContent();
@@ -847,6 +1115,17 @@ bool ReasoningKernel :: initOptions ( void )
 		) )
 		return true;
 
+	// register "useAdaptiveOrder" option (16/10/2026)
+	if ( KernelOptions.RegisterOption (
+		"useAdaptiveOrder",
+		"Option 'useAdaptiveOrder' allows the reasoner to gather the failure rates of OR alternatives and the clash "
+		"rates of the TODO list operations during the early tests, and to re-order OR alternatives and the priorities "
+		"of non-generating deterministic operations accordingly. Options orSortSat, orSortSub and IAOEFLG give the initial ordering.",
+		ifOption::iotBool,
+		"false"
+		) )
+		return true;
+
 	// register "skipBeforeBlock" option (28/02/2009)
 	if ( KernelOptions.RegisterOption (
 		"skipBeforeBlock",
@@ -915,6 +1194,38 @@ bool ReasoningKernel :: initOptions ( void )
 		) )
 		return true;
 
+	// register "nThreads" option (16/10/2026)
+	if ( KernelOptions.RegisterOption (
+		"nThreads",
+		"Option 'nThreads' sets the number of threads used to run independent subsumption tests "
+		"during classification, to realise individuals and to extract modules for the atomic decomposition "
+		"in parallel. "
+		"Value 1 means sequential processing.",
+		ifOption::iotInt,
+		"1"
+		) )
+		return true;
+
+	// register "retainedGraphSize" option (16/10/2026)
+	if ( KernelOptions.RegisterOption (
+		"retainedGraphSize",
+		"Option 'retainedGraphSize' sets the number of completion graph nodes that are kept allocated "
+		"between tests; the memory of the rest is released after the test. Value 0 means no limit.",
+		ifOption::iotInt,
+		"0"
+		) )
+		return true;
+
+	// register "gatherStatistics" option (16/10/2026)
+	if ( KernelOptions.RegisterOption (
+		"gatherStatistics",
+		"Option 'gatherStatistics' allows the reasoner to count the tactic operations, cache hits and backjumps "
+		"for the reasoning statistic. The numbers of tests and the timers are gathered anyway.",
+		ifOption::iotBool,
+		"false"
+		) )
+		return true;
+
 	// all was registered OK
 	return false;
 }
@@ -20,6 +20,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #define KERNEL_H
 
 #include <string>
+#include <mutex>
 
 #include "fpp_assert.h"
 #include "eFPPInconsistentKB.h"
@@ -103,6 +104,13 @@ public:	// types interface
 		/// type for a vector of data/concept expressions (used in KE to return stuff)
 	typedef KnowledgeExplorer::TCGItemVec TCGItemVec;
 
+	// types for batch queries
+
+		/// subsumption query C [= D as a pair (C,D)
+	typedef std::pair<TConceptExpr*,TConceptExpr*> TConceptExprPair;
+		/// vector of subsumption queries
+	typedef std::vector<TConceptExprPair> TConceptExprPairVec;
+
 protected:	// types
 		/// arguments for property chain querying and friends
 	typedef const std::vector<const TDLExpression*> TExprVec;
@@ -120,10 +128,42 @@ private:
 	static const char* ReleaseDate;
 		/// header of the file with internal state; defined in SaveLoad.cpp
 	static const char* InternalStateFileHeader;
+		/// header of the file with model caches; defined in SaveLoad.cpp
+	static const char* ModelCacheFileHeader;
 
 protected:	// types
 		/// enumeration for the cache
 	enum cacheStatus { csEmpty, csSat, csClassified };
+		/// lock the query cache and reasoners for the life time of the guard (if KB is frozen); gather per-query statistic
+	class TQueryGuard
+	{
+	protected:	// members
+			/// lock to use; NULL if no locking is necessary
+		std::recursive_mutex* pLock;
+			/// kernel to gather the per-query statistic for; NULL if not necessary
+		ReasoningKernel* pKernel;
+
+	public:		// interface
+			/// c'tor: lock the query lock of a frozen KERNEL (if any); start the query statistic if NEEDSTAT is set
+		TQueryGuard ( ReasoningKernel* kernel, bool needStat = true )
+			: pLock ( kernel != NULL && kernel->frozenKB ? &kernel->QueryLock : NULL )
+			, pKernel ( needStat ? kernel : NULL )
+		{
+			if ( pLock != NULL )
+				pLock->lock();
+			// only the outermost query counts
+			if ( pKernel != NULL && pKernel->queryDepth++ == 0 )
+				pKernel->startQueryStatistic();
+		}
+			/// d'tor: finish the query statistic and unlock the lock if necessary
+		~TQueryGuard ( void )
+		{
+			if ( pKernel != NULL && --pKernel->queryDepth == 0 )
+				pKernel->finishQueryStatistic();
+			if ( pLock != NULL )
+				pLock->unlock();
+		}
+	}; // TQueryGuard
 		/// set of TreeNE
 /*	class TreeNESet: public TNameSet<TTreeNamedEntry>
 	{
@@ -164,6 +204,8 @@ protected:	// members
 	TJNICache* JNICache;
 		/// name of an S/L context. do nothing if empty
 	SaveLoadManager* pSLManager;
+		/// S/L manager of the model caches that are reused if the KB is changed
+	SaveLoadManager* pCacheSLManager;
 
 	// Top/Bottom role names: if set, they will appear in all hierarchy-related output
 
@@ -200,6 +242,22 @@ protected:	// members
 		/// cached query result (taxonomy position)
 	TaxonomyVertex* cachedVertex;
 
+	// concurrent queries support
+
+		/// KB is frozen: no changes are allowed, queries might come from different threads
+	bool frozenKB;
+		/// lock for the queries to a frozen KB that use reasoning cache or reasoners
+	std::recursive_mutex QueryLock;
+
+	// reasoning statistic
+
+		/// depth of the nested queries
+	unsigned int queryDepth;
+		/// statistic at the beginning of the current query
+	TReasoningStatistic QueryStatStart;
+		/// statistic of the last finished query
+	TReasoningStatistic LastQueryStat;
+
 	// internal flags
 
 		/// set if TBox throws an exception during preprocessing/classification
@@ -241,6 +299,22 @@ protected:	// methods
 		/// classify/realise KB only if it is impossible to load results
 	void ClassifyOrLoad ( bool needIndividuals );
 
+		/// remember the reasoning statistic at the beginning of a query
+	void startQueryStatistic ( void )
+	{
+		QueryStatStart.clear();
+		if ( pTBox != NULL )
+			pTBox->gatherStatistic(QueryStatStart);
+	}
+		/// set the last query statistic to the difference between the current and the starting one
+	void finishQueryStatistic ( void )
+	{
+		LastQueryStat.clear();
+		if ( pTBox != NULL )
+			pTBox->gatherStatistic(LastQueryStat);
+		LastQueryStat -= QueryStatStart;
+	}
+
 		/// get DLTree corresponding to an expression EXPR
 	DLTree* e ( const TExpr* expr )
 	{
@@ -334,6 +408,12 @@ protected:	// methods
 	}
 		/// @return true iff C [= D holds
 	bool checkSub ( TConcept* C, TConcept* D );
+		/// @return true iff the vertex V of a classified taxonomy is a sub-vertex of the one of D
+	bool checkTaxSub ( TaxonomyVertex* v, TConcept* D );
+		/// answer the QUERIES with indices IDX, all of which are between the named concepts; put the answers into RESULTS
+	void checkNamedSubs ( const TConceptExprPairVec& queries, const std::vector<size_t>& idx, std::vector<bool>& results );
+		/// answer the QUERIES with indices IDX, all of which have sub-concept C; put the answers into RESULTS
+	void checkSubsOf ( TConceptExpr* C, const TConceptExprPairVec& queries, const std::vector<size_t>& idx, std::vector<bool>& results );
 		/// helper; @return true iff C is either named concept of Top/Bot
 	static bool isNameOrConst ( const TConceptExpr* C )
 	{
@@ -489,6 +569,17 @@ protected:	// methods
 		return R->getTaxVertex();
 	}
 
+	// frozen KB support
+
+		/// @return taxonomy vertex of a named concept C in a frozen KB; NULL if C is not named or KB is not frozen
+	TaxonomyVertex* getFrozenVertex ( const TConceptExpr* C );
+		/// @return taxonomy vertex of a named individual I in a frozen KB; NULL if I is not named or KB is not frozen
+	TaxonomyVertex* getFrozenVertex ( const TIndividualExpr* I );
+		/// @return named role R in a frozen KB; NULL if R is not named or KB is not frozen
+	TRole* getFrozenRole ( const TRoleExpr* R );
+		/// @return true iff vertex C is a sub-vertex of D in a frozen concept taxonomy
+	bool checkFrozenSub ( TaxonomyVertex* C, TaxonomyVertex* D );
+
 		/// check whether it is necessary to reload the ontology
 	bool needForceReload ( void ) const;
 		/// force the re-classification of the changed ontology
@@ -537,6 +628,10 @@ protected:	// methods
 	void Save ( void );
 		/// load internal state of the Kernel using S/L Manager
 	void Load ( void );
+		/// save model caches of the classified KB using the cache S/L Manager
+	void SaveModelCaches ( void );
+		/// set model caches saved in another session to the unchanged part of the KB; ignore broken content
+	void LoadModelCaches ( void );
 
 	//----------------------------------------------------------------------------------
 	// knowledge exploration queries
@@ -564,6 +659,8 @@ public:	// general staff
 	bool isKBClassified ( void ) const { return getStatus() >= kbClassified; }
 		/// return realistion status of KB
 	bool isKBRealised ( void ) const { return getStatus() >= kbRealised; }
+		/// return true iff KB is frozen
+	bool isKBFrozen ( void ) const { return frozenKB; }
 
 		/// set Progress monitor to control the classification process
 	void setProgressMonitor ( TProgressMonitor* pMon )
@@ -624,6 +721,26 @@ public:	// general staff
 		/// choose whether the loaded ontology should be dumped as a LISP one
 	void setDumpOntology ( bool value ) { dumpOntology = value; }
 
+	//----------------------------------------------
+	//-- Reasoning statistic
+	//----------------------------------------------
+
+		/// @return reasoning statistic gathered since the KB was loaded
+	TReasoningStatistic getReasoningStatistic ( void )
+	{
+		TQueryGuard guard ( this, /*needStat=*/false );
+		TReasoningStatistic stat;
+		if ( pTBox != NULL )
+			pTBox->gatherStatistic(stat);
+		return stat;
+	}
+		/// @return reasoning statistic of the last query
+	TReasoningStatistic getLastQueryStatistic ( void )
+	{
+		TQueryGuard guard ( this, /*needStat=*/false );
+		return LastQueryStat;
+	}
+
 	//----------------------------------------------
 	//-- Tracing support
 	//----------------------------------------------
@@ -672,6 +789,7 @@ public:
 		/// delete existed KB
 	bool releaseKB ( void )
 	{
+		unfreezeKB();
 		clearTBox();
 		Ontology.clear();
 		// the new KB is coming so the failures of the precious one doesn't matter
@@ -686,6 +804,19 @@ public:
 			return true;
 		return releaseKB () || newKB ();
 	}
+		/// realise KB and freeze it. No changes are allowed to a frozen KB; queries could be asked from different threads
+	void freezeKB ( void )
+	{
+		realiseKB();
+		Ontology.setLocked(true);
+		frozenKB = true;
+	}
+		/// unfreeze KB to allow changes; should not be called while queries are running
+	void unfreezeKB ( void )
+	{
+		frozenKB = false;
+		Ontology.setLocked(false);
+	}
 
 	//----------------------------------------------------
 	//	TELLS interface
@@ -854,6 +985,7 @@ public:
 		/// @return true iff object role is functional
 	bool isFunctional ( const TORoleExpr* R )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isFunctional()" );
 		if ( unlikely(r->isTop()) )
@@ -866,6 +998,7 @@ public:
 		/// @return true iff data role is functional
 	bool isFunctional ( const TDRoleExpr* R )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isFunctional()" );
 		if ( unlikely(r->isTop()) )
@@ -878,6 +1011,7 @@ public:
 		/// @return true iff role is inverse-functional
 	bool isInverseFunctional ( const TORoleExpr* R )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isInverseFunctional()" )->inverse();
 		if ( unlikely(r->isTop()) )
@@ -890,6 +1024,7 @@ public:
 		/// @return true iff role is transitive
 	bool isTransitive ( const TORoleExpr* R )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isTransitive()" );
 		if ( unlikely(r->isTop()) )
@@ -904,6 +1039,7 @@ public:
 		/// @return true iff role is symmetric
 	bool isSymmetric ( const TORoleExpr* R )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isSymmetric()" );
 		if ( unlikely(r->isTop()) )
@@ -918,6 +1054,7 @@ public:
 		/// @return true iff role is asymmetric
 	bool isAsymmetric ( const TORoleExpr* R )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isAsymmetric()" );
 		if ( unlikely(r->isTop()) )
@@ -932,6 +1069,7 @@ public:
 		/// @return true iff role is reflexive
 	bool isReflexive ( const TORoleExpr* R )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isReflexive()" );
 		if ( unlikely(r->isTop()) )
@@ -946,6 +1084,7 @@ public:
 		/// @return true iff role is irreflexive
 	bool isIrreflexive ( const TORoleExpr* R )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isIrreflexive()" );
 		if ( unlikely(r->isTop()) )
@@ -960,6 +1099,7 @@ public:
 		/// @return true if R is a sub-role of S
 	bool isSubRoles ( const TORoleExpr* R, const TORoleExpr* S )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isSubRoles()" );
 		TRole* s = getRole ( S, "Role expression expected in isSubRoles()" );
@@ -981,6 +1121,7 @@ public:
 		/// @return true if R is a sub-role of S
 	bool isSubRoles ( const TDRoleExpr* R, const TDRoleExpr* S )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isSubRoles()" );
 		TRole* s = getRole ( S, "Role expression expected in isSubRoles()" );
@@ -1002,6 +1143,7 @@ public:
 		/// @return true iff two roles are disjoint
 	bool isDisjointRoles ( const TORoleExpr* R, const TORoleExpr* S )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isDisjointRoles()" );
 		TRole* s = getRole ( S, "Role expression expected in isDisjointRoles()" );
@@ -1014,6 +1156,7 @@ public:
 		/// @return true iff two roles are disjoint
 	bool isDisjointRoles ( const TDRoleExpr* R, const TDRoleExpr* S )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isDisjointRoles()" );
 		TRole* s = getRole ( S, "Role expression expected in isDisjointRoles()" );
@@ -1028,6 +1171,7 @@ public:
 		/// @return true if R is a super-role of a chain holding in the args
 	bool isSubChain ( const TORoleExpr* R )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isSubChain()" );
 		if ( unlikely(r->isTop()) )
@@ -1040,6 +1184,7 @@ public:
 		/// @return true iff C is satisfiable
 	bool isSatisfiable ( const TConceptExpr* C )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();
 		try { return checkSat(C); }
 		catch ( const EFPPCantRegName& crn )
@@ -1053,12 +1198,23 @@ public:
 		/// @return true iff C [= D holds
 	bool isSubsumedBy ( const TConceptExpr* C, const TConceptExpr* D )
 	{
+		// named concepts in a frozen KB: check taxonomy without locking
+		TaxonomyVertex* dV = getFrozenVertex(D);
+		if ( dV != NULL )
+		{
+			TaxonomyVertex* cV = getFrozenVertex(C);
+			if ( cV != NULL )
+				return checkFrozenSub ( cV, dV );
+		}
+		TQueryGuard guard(this);
 		preprocessKB();
 		if ( isNameOrConst(D) && likely(isNameOrConst(C)) )
 			return checkSub ( getTBox()->getCI(TreeDeleter(e(C))), getTBox()->getCI(TreeDeleter(e(D))) );
 		DLTree* nD = createSNFNot(e(D));
 		return !checkSatTree ( createSNFAnd (e(C), nD) );
 	}
+		/// answer all the subsumption QUERIES at once; RESULTS[i] is true iff the i-th query holds
+	void isSubsumedBy ( const TConceptExprPairVec& queries, std::vector<bool>& results );
 		/// @return true iff C is disjoint with D; that is, (C and D) is unsatisfiable
 	bool isDisjoint ( const TConceptExpr* C, const TConceptExpr* D ) { return !isSatisfiable(getExpressionManager()->And(C,D)); }
 		/// @return true iff C is equivalent to D
@@ -1066,6 +1222,15 @@ public:
 	{
 		if ( C == D )	// easy case
 			return true;
+		// named concepts in a frozen KB: compare vertices without locking
+		TaxonomyVertex* dV = getFrozenVertex(D);
+		if ( dV != NULL )
+		{
+			TaxonomyVertex* cV = getFrozenVertex(C);
+			if ( cV != NULL )
+				return cV == dV;
+		}
+		TQueryGuard guard(this);
 		preprocessKB();
 		if ( isKBClassified() )
 		{	// try to detect C=D wrt named concepts
@@ -1087,6 +1252,17 @@ public:
 	template<class Actor>
 	void getSupConcepts ( const TConceptExpr* C, bool direct, Actor& actor )
 	{
+		if ( TaxonomyVertex* v = getFrozenVertex(C) )
+		{	// named concept in a frozen KB: no locking is necessary
+			actor.clear();
+			Taxonomy* tax = getCTaxonomy();
+			if ( direct )
+				tax->getRelativesInfoConst</*needCurrent=*/false, /*onlyDirect=*/true, /*upDirection=*/true> ( v, actor );
+			else
+				tax->getRelativesInfoConst</*needCurrent=*/false, /*onlyDirect=*/false, /*upDirection=*/true> ( v, actor );
+			return;
+		}
+		TQueryGuard guard(this);
 		classifyKB();	// ensure KB is ready to answer the query
 		setUpCache ( C, csClassified );
 		actor.clear();
@@ -1100,6 +1276,17 @@ public:
 	template<class Actor>
 	void getSubConcepts ( const TConceptExpr* C, bool direct, Actor& actor )
 	{
+		if ( TaxonomyVertex* v = getFrozenVertex(C) )
+		{	// named concept in a frozen KB: no locking is necessary
+			actor.clear();
+			Taxonomy* tax = getCTaxonomy();
+			if ( direct )
+				tax->getRelativesInfoConst</*needCurrent=*/false, /*onlyDirect=*/true, /*upDirection=*/false> ( v, actor );
+			else
+				tax->getRelativesInfoConst</*needCurrent=*/false, /*onlyDirect=*/false, /*upDirection=*/false> ( v, actor );
+			return;
+		}
+		TQueryGuard guard(this);
 		classifyKB();	// ensure KB is ready to answer the query
 		setUpCache ( C, csClassified );
 		actor.clear();
@@ -1113,6 +1300,13 @@ public:
 	template<class Actor>
 	void getEquivalentConcepts ( const TConceptExpr* C, Actor& actor )
 	{
+		if ( TaxonomyVertex* v = getFrozenVertex(C) )
+		{	// named concept in a frozen KB: no locking is necessary
+			actor.clear();
+			actor.apply(*v);
+			return;
+		}
+		TQueryGuard guard(this);
 		classifyKB();	// ensure KB is ready to answer the query
 		setUpCache ( C, csClassified );
 		actor.clear();
@@ -1122,6 +1316,7 @@ public:
 	template<class Actor>
 	void getDisjointConcepts ( const TConceptExpr* C, Actor& actor )
 	{
+		TQueryGuard guard(this);
 		classifyKB();	// ensure KB is ready to answer the query
 		setUpCache ( getExpressionManager()->Not(C), csClassified );
 		actor.clear();
@@ -1136,6 +1331,17 @@ public:
 	template<class Actor>
 	void getSupRoles ( const TRoleExpr* r, bool direct, Actor& actor )
 	{
+		if ( TRole* R = getFrozenRole(r) )
+		{	// named role in a frozen KB: no locking is necessary
+			actor.clear();
+			Taxonomy* tax = getTaxonomy(R);
+			if ( direct )
+				tax->getRelativesInfoConst</*needCurrent=*/false, /*onlyDirect=*/true, /*upDirection=*/true> ( getTaxVertex(R), actor );
+			else
+				tax->getRelativesInfoConst</*needCurrent=*/false, /*onlyDirect=*/false, /*upDirection=*/true> ( getTaxVertex(R), actor );
+			return;
+		}
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* R = getRole ( r, "Role expression expected in getSupRoles()" );
 		actor.clear();
@@ -1149,6 +1355,17 @@ public:
 	template<class Actor>
 	void getSubRoles ( const TRoleExpr* r, bool direct, Actor& actor )
 	{
+		if ( TRole* R = getFrozenRole(r) )
+		{	// named role in a frozen KB: no locking is necessary
+			actor.clear();
+			Taxonomy* tax = getTaxonomy(R);
+			if ( direct )
+				tax->getRelativesInfoConst</*needCurrent=*/false, /*onlyDirect=*/true, /*upDirection=*/false> ( getTaxVertex(R), actor );
+			else
+				tax->getRelativesInfoConst</*needCurrent=*/false, /*onlyDirect=*/false, /*upDirection=*/false> ( getTaxVertex(R), actor );
+			return;
+		}
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* R = getRole ( r, "Role expression expected in getSubRoles()" );
 		actor.clear();
@@ -1162,6 +1379,13 @@ public:
 	template<class Actor>
 	void getEquivalentRoles ( const TRoleExpr* r, Actor& actor )
 	{
+		if ( TRole* R = getFrozenRole(r) )
+		{	// named role in a frozen KB: no locking is necessary
+			actor.clear();
+			actor.apply(*getTaxVertex(R));
+			return;
+		}
+		TQueryGuard guard(this);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* R = getRole ( r, "Role expression expected in getEquivalentRoles()" );
 		actor.clear();
@@ -1174,6 +1398,7 @@ public:
 	template<class Actor>
 	void getORoleDomain ( const TORoleExpr* r, bool direct, Actor& actor )
 	{
+		TQueryGuard guard(this);
 		classifyKB();	// ensure KB is ready to answer the query
 		setUpCache ( getExpressionManager()->Exists ( r, getExpressionManager()->Top() ), csClassified );
 		actor.clear();
@@ -1187,6 +1412,7 @@ public:
 	template<class Actor>
 	void getDRoleDomain ( const TDRoleExpr* r, bool direct, Actor& actor )
 	{
+		TQueryGuard guard(this);
 		classifyKB();	// ensure KB is ready to answer the query
 		setUpCache ( getExpressionManager()->Exists ( r, getExpressionManager()->DataTop() ), csClassified );
 		actor.clear();
@@ -1207,20 +1433,26 @@ public:
 	template<class Actor>
 	void getDirectInstances ( const TConceptExpr* C, Actor& actor )
 	{
-		realiseKB();	// ensure KB is ready to answer the query
-		setUpCache ( C, csClassified );
+		TaxonomyVertex* v = getFrozenVertex(C);
+		TQueryGuard guard ( v == NULL ? this : NULL );
+		if ( v == NULL )
+		{
+			realiseKB();	// ensure KB is ready to answer the query
+			setUpCache ( C, csClassified );
+			v = cachedVertex;
+		}
 		actor.clear();
 
 		// implement 1-level check by hand
 
 		// if the root vertex contains individuals -- we are done
-		if ( actor.apply(*cachedVertex) )
+		if ( actor.apply(*v) )
 			return;
 
 		// if not, just go 1 level down and apply the actor regardless of what's found
 		// FIXME!! check again after bucket-method will be implemented
-		for ( TaxonomyVertex::iterator p = cachedVertex->begin(/*upDirection=*/false),
-				p_end = cachedVertex->end(/*upDirection=*/false); p != p_end; ++p )
+		for ( TaxonomyVertex::iterator p = v->begin(/*upDirection=*/false),
+				p_end = v->end(/*upDirection=*/false); p != p_end; ++p )
 			actor.apply(**p);
 	}
 
@@ -1228,6 +1460,13 @@ public:
 	template<class Actor>
 	void getInstances ( const TConceptExpr* C, Actor& actor )
 	{	// FIXME!! check for Racer's/IS approach
+		if ( TaxonomyVertex* v = getFrozenVertex(C) )
+		{	// named concept in a frozen KB: no locking is necessary
+			actor.clear();
+			getCTaxonomy()->getRelativesInfoConst</*needCurrent=*/true, /*onlyDirect=*/false, /*upDirection=*/false> ( v, actor );
+			return;
+		}
+		TQueryGuard guard(this);
 		realiseKB();	// ensure KB is ready to answer the query
 		setUpCache ( C, csClassified );
 		actor.clear();
@@ -1239,6 +1478,17 @@ public:
 	template<class Actor>
 	void getTypes ( const TIndividualExpr* I, bool direct, Actor& actor )
 	{
+		if ( TaxonomyVertex* v = getFrozenVertex(I) )
+		{	// named individual in a frozen KB: no locking is necessary
+			actor.clear();
+			Taxonomy* tax = getCTaxonomy();
+			if ( direct )
+				tax->getRelativesInfoConst</*needCurrent=*/true, /*onlyDirect=*/true, /*upDirection=*/true> ( v, actor );
+			else
+				tax->getRelativesInfoConst</*needCurrent=*/true, /*onlyDirect=*/false, /*upDirection=*/true> ( v, actor );
+			return;
+		}
+		TQueryGuard guard(this);
 		realiseKB();	// ensure KB is ready to answer the query
 		setUpCache ( getExpressionManager()->OneOf(I), csClassified );
 		actor.clear();
@@ -1252,12 +1502,20 @@ public:
 	template<class Actor>
 	void getSameAs ( const TIndividualExpr* I, Actor& actor )
 	{
+		if ( TaxonomyVertex* v = getFrozenVertex(I) )
+		{	// named individual in a frozen KB: no locking is necessary
+			actor.clear();
+			actor.apply(*v);
+			return;
+		}
+		TQueryGuard guard(this);
 		realiseKB();	// ensure KB is ready to answer the query
 		getEquivalentConcepts ( getExpressionManager()->OneOf(I), actor );
 	}
 		/// @return true iff I and J refer to the same individual
 	bool isSameIndividuals ( const TIndividualExpr* I, const TIndividualExpr* J )
 	{
+		TQueryGuard guard(this);
 		realiseKB();
 		TIndividual* i = getIndividual ( I, "Only known individuals are allowed in the isSameAs()" );
 		TIndividual* j = getIndividual ( J, "Only known individuals are allowed in the isSameAs()" );
@@ -1266,6 +1524,15 @@ public:
 		/// @return true iff individual I is instance of given [complex] C
 	bool isInstance ( const TIndividualExpr* I, const TConceptExpr* C )
 	{
+		// named individual and concept in a frozen KB: check taxonomy without locking
+		TaxonomyVertex* cV = getFrozenVertex(C);
+		if ( cV != NULL )
+		{
+			TaxonomyVertex* iV = getFrozenVertex(I);
+			if ( iV != NULL )
+				return checkFrozenSub ( iV, cV );
+		}
+		TQueryGuard guard(this);
 		realiseKB();	// ensure KB is ready to answer the query
 		getIndividual ( I, "individual name expected in the isInstance()" );
 		// FIXME!! this way a new concept is created; could be done more optimal
@@ -1288,6 +1555,7 @@ public:
 		/// build a completion tree for a concept expression C (no caching as it breaks the idea of KE). @return the root node
 	const TCGNode* buildCompletionTree ( const TConceptExpr* C )
 	{
+		TQueryGuard guard(this);
 		preprocessKB();
 		setUpCache ( C, csSat );
 		const TCGNode* ret = getTBox()->buildCompletionTree(cachedConcept);
@@ -20,6 +20,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #define MODULARITY_H
 
 #include <queue>
+#include <vector>
+#include <algorithm>
 
 // uncomment the next line to use AD to speed up modularisation
 #define RKG_USE_AD_IN_MODULE_EXTRACTION
@@ -60,8 +62,43 @@ protected:	// members
 	unsigned long long nNonLocal;
 		/// true if no atoms are processed ATM
 	bool noAtomsProcessing;
+		/// true iff the modularizer uses semantic locality
+	bool useSemantic;
+		/// per-axiom marks (indexed by axiom id) of the axioms in the current module
+	std::vector<unsigned int> ModuleMarks;
+		/// per-axiom marks (indexed by axiom id) of the axioms in the current search space
+	std::vector<unsigned int> SSMarks;
+		/// mark of the current extraction
+	unsigned int curMark;
+		/// true iff all the used axioms are in the search space
+	bool wholeSS;
 
 protected:	// methods
+		/// start a new extraction: all the axioms are neither in the module nor in the search space
+	void newMark ( void )
+	{
+		if ( unlikely(++curMark == 0) )	// overflow: clear all the marks
+		{
+			std::fill ( ModuleMarks.begin(), ModuleMarks.end(), 0 );
+			std::fill ( SSMarks.begin(), SSMarks.end(), 0 );
+			curMark = 1;
+		}
+	}
+		/// set the mark of an axiom AX in MARKS to the current one
+	void setMark ( std::vector<unsigned int>& Marks, const TDLAxiom* ax )
+	{
+		if ( unlikely(ax->getId() >= Marks.size()) )
+			Marks.resize ( ax->getId()+1, 0 );
+		Marks[ax->getId()] = curMark;
+	}
+		/// @return true iff the mark of an axiom AX in MARKS is the current one
+	bool hasMark ( const std::vector<unsigned int>& Marks, const TDLAxiom* ax ) const
+		{ return ax->getId() < Marks.size() && Marks[ax->getId()] == curMark; }
+		/// @return true iff the axiom AX is in the current module
+	bool isInModule ( const TDLAxiom* ax ) const { return hasMark ( ModuleMarks, ax ); }
+		/// @return true iff the axiom AX is in the current search space
+	bool isInSS ( const TDLAxiom* ax ) const { return wholeSS ? ax->isUsed() : hasMark ( SSMarks, ax ); }
+
 		/// update SIG wrt the axiom signature
 	void addAxiomSig ( const TSignature& axiomSig )
 	{
@@ -75,7 +112,7 @@ protected:	// methods
 		/// add an axiom to a module
 	void addAxiomToModule ( TDLAxiom* axiom )
 	{
-		axiom->setInModule(true);
+		setMark ( ModuleMarks, axiom );
 		Module.push_back(axiom);
 		// update the signature
 		addAxiomSig(axiom->getSignature());
@@ -111,7 +148,7 @@ protected:	// methods
 	void addNonLocal ( const AxiomVec& AxSet, bool noCheck )
 	{
 		for ( SigIndex::const_iterator q = AxSet.begin(), q_end = AxSet.end(); q != q_end; ++q )
-			if ( !(*q)->isInModule() && (*q)->isInSS() ) // in the given range but not in module yet
+			if ( !isInModule(*q) && isInSS(*q) ) // in the given range but not in module yet
 				addNonLocal ( *q, noCheck );
 	}
 		/// build a module traversing axioms by a signature
@@ -136,16 +173,38 @@ protected:	// methods
 	{
 		Module.clear();
 		Module.reserve(end-begin);
-		// clear the module flag in the input
-		const_iterator p;
-		for ( p = begin; p != end; ++p )
-			(*p)->setInModule(false);
-		for ( p = begin; p != end; ++p )
+		// mark the search space for the new extraction
+		newMark();
+		for ( const_iterator p = begin; p != end; ++p )
 			if ( (*p)->isUsed() )
-				(*p)->setInSS(true);
+				setMark ( SSMarks, *p );
+		extractModuleQueue();
+	}
+		/// extract module from all the used axioms wrt presence of a sig index
+	void extractModule ( void )
+	{
+		Module.clear();
+		newMark();
+		// no need to mark the search space: it consists of all the used axioms
+		wholeSS = true;
 		extractModuleQueue();
-		for ( p = begin; p != end; ++p )
-			(*p)->setInSS(false);
+		wholeSS = false;
+	}
+		/// continue the extraction of a STAR module wrt SIGNATURE until stabilization; TOPLOCALITY is the one of the last pass
+	void extractStar ( const TSignature& signature, bool topLocality )
+	{
+		size_t size;
+		AxiomVec oldModule;
+		do
+		{
+			size = Module.size();
+			oldModule.swap(Module);
+			topLocality = !topLocality;
+
+			sig = signature;
+			sig.setLocality(topLocality);
+	 		extractModule ( oldModule.begin(), oldModule.end() );
+		} while ( size != Module.size() );
 	}
 
 public:		// interface
@@ -156,6 +215,9 @@ public:		// interface
 		, nChecks(0)
 		, nNonLocal(0)
 		, noAtomsProcessing(true)
+		, useSemantic(useSem)
+		, curMark(0)
+		, wholeSS(false)
 		{}
 		// d'tor
 	~TModularizer ( void ) { delete Checker; }
@@ -177,22 +239,22 @@ public:		// interface
 		sig.setLocality(topLocality);
  		extractModule ( begin, end );
 
-		if ( type != M_STAR )
-			return;
-
 		// here there is a star: do the cycle until stabilization
-		size_t size;
-		AxiomVec oldModule;
-		do
-		{
-			size = Module.size();
-			oldModule.swap(Module);
-			topLocality = !topLocality;
+		if ( type == M_STAR )
+			extractStar ( signature, topLocality );
+	}
+		/// extract module wrt SIGNATURE and TYPE from all the used axioms of the preprocessed ontology
+	void extract ( const TSignature& signature, ModuleType type )
+	{
+		bool topLocality = (type == M_TOP);
 
-			sig = signature;
-			sig.setLocality(topLocality);
-	 		extractModule ( oldModule.begin(), oldModule.end() );
-		} while ( size != Module.size() );
+		sig = signature;
+		sig.setLocality(topLocality);
+ 		extractModule();
+
+		// here there is a star: do the cycle until stabilization
+		if ( type == M_STAR )
+			extractStar ( signature, topLocality );
 	}
 		/// extract module wrt SIGNATURE and TYPE from the axiom vector VEC
 	void extract ( const AxiomVec& Vec, const TSignature& signature, ModuleType type )
@@ -228,6 +290,14 @@ public:		// interface
 	unsigned long long getNChecks ( void ) const { return nChecks; }
 		/// get number of axioms that were local
 	unsigned long long getNNonLocal ( void ) const { return nNonLocal; }
+		/// @return true iff the modularizer uses semantic locality
+	bool isSemantic ( void ) const { return useSemantic; }
+		/// add the locality checks statistic of a modularizer M to the current one
+	void addStat ( const TModularizer& m )
+	{
+		nChecks += m.nChecks;
+		nNonLocal += m.nNonLocal;
+	}
 }; // TModularizer
 
 #endif
@@ -19,6 +19,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef PRIORITYMATRIX_H
 #define PRIORITYMATRIX_H
 
+#include <algorithm>
+
 #include "eFaCTPlusPlus.h"
 #include "dlVertex.h"	// DagTag
 #include "logging.h"
@@ -33,14 +35,13 @@ const unsigned int iNN = nRegularOps+2;
 /// Auxiliary class to get priorities on operations
 class ToDoPriorMatrix
 {
+public:		// types
+		/// regular operations with the configurable priorities
+	enum Operation { opAnd = 0, opOr, opExists, opForall, opLE, opGE, opLast };
+
 protected:	// members
-	// regular operation indexes
-	unsigned int iAnd;
-	unsigned int iOr;
-	unsigned int iExists;
-	unsigned int iForall;
-	unsigned int iLE;
-	unsigned int iGE;
+		/// regular operation indexes
+	unsigned int Index[opLast];
 
 public:		// interface
 		/// empty c'tor
@@ -52,6 +53,10 @@ public:		// interface
 	void initPriorities ( const std::string& options, const char* optionName );
 		/// get an index corresponding given Op, Sign and NominalNode
 	unsigned int getIndex ( DagTag Op, bool Sign, bool NominalNode ) const;
+		/// get an operation corresponding given Op and Sign; opLast if there is no such
+	static unsigned int getOperation ( DagTag Op, bool Sign );
+		/// re-assign the priorities of the non-generating deterministic operations wrt their clash rates, given by numbers of APPLIED and CLASHES
+	void adaptPriorities ( const unsigned long* applied, const unsigned long* clashes );
 }; // ToDoPriorMatrix
 
 inline void ToDoPriorMatrix :: initPriorities ( const std::string& options, const char* optionName )
@@ -61,25 +66,21 @@ inline void ToDoPriorMatrix :: initPriorities ( const std::string& options, cons
 		throw EFaCTPlusPlus ( "ToDo List option string should have length 7" );
 
 	// init values by symbols loaded
-	iAnd	= options[1] - '0';
-	iOr		= options[2] - '0';
-	iExists	= options[3] - '0';
-	iForall	= options[4] - '0';
-	iLE		= options[5] - '0';
-	iGE		= options[6] - '0';
+	Index[opAnd]	= options[1] - '0';
+	Index[opOr]		= options[2] - '0';
+	Index[opExists]	= options[3] - '0';
+	Index[opForall]	= options[4] - '0';
+	Index[opLE]		= options[5] - '0';
+	Index[opGE]		= options[6] - '0';
 
 	// correctness checking
-	if ( iAnd >= nRegularOps ||
-		 iOr >= nRegularOps ||
-		 iExists >= nRegularOps ||
-		 iForall >= nRegularOps ||
-		 iGE >= nRegularOps ||
-		 iLE >= nRegularOps )
-		throw EFaCTPlusPlus ( "ToDo List option out of range" );
+	for ( unsigned int i = 0; i < opLast; ++i )
+		if ( Index[i] >= nRegularOps )
+			throw EFaCTPlusPlus ( "ToDo List option out of range" );
 
 	// inform about used rules order
 	if ( LLM.isWritable(llAlways) )
-		LL << "\nInit " << optionName << " = " << iAnd << iOr << iExists << iForall << iLE << iGE;
+		LL << "\nInit " << optionName << " = " << Index[opAnd] << Index[opOr] << Index[opExists] << Index[opForall] << Index[opLE] << Index[opGE];
 }
 
 inline unsigned int ToDoPriorMatrix :: getIndex ( DagTag Op, bool Sign, bool NominalNode ) const
@@ -87,21 +88,21 @@ inline unsigned int ToDoPriorMatrix :: getIndex ( DagTag Op, bool Sign, bool Nom
 	switch ( Op )
 	{
 	case dtAnd:
-		return (Sign?iAnd:iOr);
+		return (Sign?Index[opAnd]:Index[opOr]);
 
 	case dtSplitConcept:
-		return iAnd;
+		return Index[opAnd];
 
 	case dtForall:
 	case dtIrr:		// process local (ir-)reflexivity as a FORALL
-		return (Sign?iForall:iExists);
+		return (Sign?Index[opForall]:Index[opExists]);
 
 	case dtProj:	// it should be the lowest priority but now just OR's one
 	case dtChoose:	// probably should be highest branching one
-		return iOr;
+		return Index[opOr];
 
 	case dtLE:
-		return (Sign?(NominalNode?iNN:iLE):iGE);
+		return (Sign?(NominalNode?iNN:Index[opLE]):Index[opGE]);
 
 	case dtDataType:
 	case dtDataValue:
@@ -123,4 +124,58 @@ inline unsigned int ToDoPriorMatrix :: getIndex ( DagTag Op, bool Sign, bool Nom
 	}
 }
 
+inline unsigned int ToDoPriorMatrix :: getOperation ( DagTag Op, bool Sign )
+{
+	switch ( Op )
+	{
+	case dtAnd:
+		return (Sign?opAnd:opOr);
+	case dtSplitConcept:
+		return opAnd;
+	case dtForall:
+	case dtIrr:
+		return (Sign?opForall:opExists);
+	case dtProj:
+	case dtChoose:
+		return opOr;
+	case dtLE:
+		return (Sign?opLE:opGE);
+	default:	// ID's and the rest have fixed priorities
+		return opLast;
+	}
+}
+
+inline void ToDoPriorMatrix :: adaptPriorities ( const unsigned long* applied, const unsigned long* clashes )
+{
+	// only non-generating deterministic operations change places: OR is branching, and generating
+	// rules should go after the other ones for the termination of the nominal reasoning
+	static const unsigned int nDet = 3;
+	unsigned int Ops[nDet] = { opForall, opLE, opAnd };
+	unsigned int Values[nDet];
+	for ( unsigned int i = 0; i < nDet; ++i )
+		Values[i] = Index[Ops[i]];
+	std::sort ( Values, Values+nDet );
+
+	// order operations by the clash rate (descending); current priorities break ties
+	for ( unsigned int i = 1; i < nDet; ++i )
+	{
+		unsigned int x = Ops[i];
+		double rx = (clashes[x]+1.0)/(applied[x]+2.0);
+		int j = i-1;
+		for ( ; j >= 0; --j )
+		{
+			unsigned int y = Ops[j];
+			double ry = (clashes[y]+1.0)/(applied[y]+2.0);
+			if ( rx < ry || ( rx == ry && Index[x] >= Index[y] ) )
+				break;
+			Ops[j+1] = y;
+		}
+		Ops[j+1] = x;
+	}
+
+	// the most clashing operation gets the highest priority
+	for ( unsigned int i = 0; i < nDet; ++i )
+		Index[Ops[i]] = Values[i];
+}
+
 #endif
@@ -27,9 +27,46 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 // comment the line out for flushing LL after dumping significant piece of info
 //#define __DEBUG_FLUSH_LL
 
-#ifdef USE_REASONING_STATISTICS
-AccumulatedStatistic* AccumulatedStatistic::root = NULL;
-#endif
+/// all the statistic counters of the reasoner with the corresponding elements of the reasoning statistic
+const DlSatTester::StatEntry DlSatTester::StatTable[] =
+{
+	{ TReasoningStatistic::rsSatTests, &DlSatTester::nSatTests },
+	{ TReasoningStatistic::rsSubTests, &DlSatTester::nSubTests },
+	{ TReasoningStatistic::rsTacticCalls, &DlSatTester::nTacticCalls },
+	{ TReasoningStatistic::rsUseless, &DlSatTester::nUseless },
+	{ TReasoningStatistic::rsIdCalls, &DlSatTester::nIdCalls },
+	{ TReasoningStatistic::rsSingletonCalls, &DlSatTester::nSingletonCalls },
+	{ TReasoningStatistic::rsOrCalls, &DlSatTester::nOrCalls },
+	{ TReasoningStatistic::rsOrBrCalls, &DlSatTester::nOrBrCalls },
+	{ TReasoningStatistic::rsAndCalls, &DlSatTester::nAndCalls },
+	{ TReasoningStatistic::rsSomeCalls, &DlSatTester::nSomeCalls },
+	{ TReasoningStatistic::rsAllCalls, &DlSatTester::nAllCalls },
+	{ TReasoningStatistic::rsFuncCalls, &DlSatTester::nFuncCalls },
+	{ TReasoningStatistic::rsLeCalls, &DlSatTester::nLeCalls },
+	{ TReasoningStatistic::rsGeCalls, &DlSatTester::nGeCalls },
+	{ TReasoningStatistic::rsNNCalls, &DlSatTester::nNNCalls },
+	{ TReasoningStatistic::rsMergeCalls, &DlSatTester::nMergeCalls },
+	{ TReasoningStatistic::rsAutoEmptyLookups, &DlSatTester::nAutoEmptyLookups },
+	{ TReasoningStatistic::rsAutoTransLookups, &DlSatTester::nAutoTransLookups },
+	{ TReasoningStatistic::rsSRuleAdd, &DlSatTester::nSRuleAdd },
+	{ TReasoningStatistic::rsSRuleFire, &DlSatTester::nSRuleFire },
+	{ TReasoningStatistic::rsStateSaves, &DlSatTester::nStateSaves },
+	{ TReasoningStatistic::rsStateRestores, &DlSatTester::nStateRestores },
+	{ TReasoningStatistic::rsBackjumps, &DlSatTester::nBackjumps },
+	{ TReasoningStatistic::rsNodeSaves, &DlSatTester::nNodeSaves },
+	{ TReasoningStatistic::rsNodeRestores, &DlSatTester::nNodeRestores },
+	{ TReasoningStatistic::rsLookups, &DlSatTester::nLookups },
+	{ TReasoningStatistic::rsFairnessViolations, &DlSatTester::nFairnessViolations },
+	{ TReasoningStatistic::rsCacheTry, &DlSatTester::nCacheTry },
+	{ TReasoningStatistic::rsCacheFailedNoCache, &DlSatTester::nCacheFailedNoCache },
+	{ TReasoningStatistic::rsCacheFailedShallow, &DlSatTester::nCacheFailedShallow },
+	{ TReasoningStatistic::rsCacheFailed, &DlSatTester::nCacheFailed },
+	{ TReasoningStatistic::rsCachedSat, &DlSatTester::nCachedSat },
+	{ TReasoningStatistic::rsCachedUnsat, &DlSatTester::nCachedUnsat },
+	{ TReasoningStatistic::rsBlockingTests, &DlSatTester::nBlockingTests },
+	{ TReasoningStatistic::rsBlockedNodes, &DlSatTester::nBlockedNodes },
+	{ TReasoningStatistic::rsLast, NULL },
+};
 
 DlSatTester :: DlSatTester ( TBox& tbox )
 	: tBox(tbox)
@@ -45,17 +82,26 @@ DlSatTester :: DlSatTester ( TBox& tbox )
 	, bContext(NULL)
 	, tryLevel(InitBranchingLevelValue)
 	, nonDetShift(0)
+	, gatherBranchStat(tbox.useAdaptiveOrder)
+	, gatherStat(tbox.gatherStatistics)
 	, curNode(NULL)
 	, dagSize(0)
 {
+	std::fill ( OpApplied, OpApplied+ToDoPriorMatrix::opLast, 0 );
+	std::fill ( OpClashes, OpClashes+ToDoPriorMatrix::opLast, 0 );
 	// init static part of CTree
 	CGraph.initContext ( tBox.nSkipBeforeBlock, tBox.useLazyBlocking, tBox.useAnywhereBlocking );
+	CGraph.setRetainedSize(tBox.retainedGraphSize);
 	// init datatype reasoner
 	tBox.getDataTypeCenter().initDataTypeReasoner(DTReasoner);
 	// init set of reflexive roles
 	tBox.getORM()->fillReflexiveRoles(ReflexiveRoles);
 	// init blocking statistics
 	clearBlockingStat();
+#ifdef USE_REASONING_STATISTICS
+	// statistic is always printed in the logging mode
+	gatherStat = true;
+#endif
 
 	resetSessionFlags();
 }
@@ -414,18 +460,20 @@ bool DlSatTester :: runSat ( void )
 void
 DlSatTester :: finaliseStatistic ( void )
 {
-#ifdef USE_REASONING_STATISTICS
 	// add the integer stat values
 	nNodeSaves.set(CGraph.getNNodeSaves());
 	nNodeRestores.set(CGraph.getNNodeRestores());
+	nBlockingTests.set(CGraph.getNBlockingTests());
+	nBlockedNodes.set(CGraph.getNBlockedNodes());
 
+#ifdef USE_REASONING_STATISTICS
 	// log statistics data
 	if ( LLM.isWritable(llRStat) )
 		logStatisticData ( LL, /*needLocal=*/true );
+#endif
 
 	// merge local statistics with the global one
-	AccumulatedStatistic::accumulateAll();
-#endif
+	accumulateStatistic();
 
 	// clear global statistics
 	CGraph.clearStatistics();
@@ -473,14 +521,23 @@ bool DlSatTester :: checkSatisfiability ( void )
 		if ( ++loop == 5000 )
 		{
 			loop = 0;
-			if ( tBox.isCancelled() )
+			if ( isCancelled() )
 				return false;
 			if ( unlikely(getSatTimeout()) && 1000*(float)testTimer >= getSatTimeout() )
 				throw EFPPTimeout();
 		}
 		// here curNode/curConcept are set
+		unsigned int op = ToDoPriorMatrix::opLast;
+		if ( gatherBranchStat )
+		{
+			op = ToDoPriorMatrix::getOperation ( DLHeap[curConcept.bp()].Type(), isPositive(curConcept.bp()) );
+			if ( op != ToDoPriorMatrix::opLast )
+				++OpApplied[op];
+		}
 		if ( commonTactic() )	// clash found
 		{
+			if ( op != ToDoPriorMatrix::opLast )
+				++OpClashes[op];
 			if ( tunedRestore() )	// the concept is unsatisfiable
 				return false;
 		}
@@ -733,6 +790,7 @@ void DlSatTester :: logStatisticData ( std::ostream& o, bool needLocal ) const
 
 	nStateSaves.Print		( o, needLocal, "\nThere were made ", " save(s) of global state" );
 	nStateRestores.Print	( o, needLocal, "\nThere were made ", " restore(s) of global state" );
+	nBackjumps.Print		( o, needLocal, "\n       of which ", " backjumps" );
 	nNodeSaves.Print		( o, needLocal, "\nThere were made ", " save(s) of tree state" );
 	nNodeRestores.Print		( o, needLocal, "\nThere were made ", " restore(s) of tree state" );
 	nLookups.Print			( o, needLocal, "\nThere were made ", " concept lookups" );
@@ -749,7 +807,10 @@ void DlSatTester :: logStatisticData ( std::ostream& o, bool needLocal ) const
 #endif
 
 	if ( !needLocal )
-		o << "\nThe maximal graph size is " << CGraph.maxSize() << " nodes";
+	{
+		o << "\nThe maximal graph size is " << CGraph.maxSize() << " nodes and " << CGraph.maxEdges() << " edges";
+		o << "\nThe graph keeps " << CGraph.allocatedSize() << " nodes and " << CGraph.allocatedEdges() << " edges allocated";
+	}
 }
 
 float
@@ -759,3 +820,16 @@ DlSatTester :: printReasoningTime ( std::ostream& o ) const
 	return satTimer + subTimer;
 }
 
+void
+DlSatTester :: gatherStatistic ( TReasoningStatistic& stat ) const
+{
+	for ( const StatEntry* p = StatTable; p->counter != NULL; ++p )
+		stat.add ( p->elem, (this->*p->counter).get(/*needLocal=*/false) );
+	stat.add ( TReasoningStatistic::rsSatTime, satTimer );
+	stat.add ( TReasoningStatistic::rsSubTime, subTimer );
+	stat.add ( TReasoningStatistic::rsGraphPeakNodes, CGraph.maxSize() );
+	stat.add ( TReasoningStatistic::rsGraphPeakEdges, CGraph.maxEdges() );
+	stat.add ( TReasoningStatistic::rsGraphNodes, CGraph.allocatedSize() );
+	stat.add ( TReasoningStatistic::rsGraphEdges, CGraph.allocatedEdges() );
+}
+
@@ -30,12 +30,12 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "DataReasoning.h"
 #include "ToDoList.h"
 #include "tFastSet.h"
+#include "tReasoningStatistic.h"
 
-#ifdef _USE_LOGGING	// don't gather statistics w/o logging
+#ifdef _USE_LOGGING	// don't print statistics w/o logging
 #	define USE_REASONING_STATISTICS
 #endif
 
-#ifdef USE_REASONING_STATISTICS
 /// class for gathering statistic both for session and totally
 class AccumulatedStatistic
 {
@@ -45,46 +45,17 @@ private:	// prohibit copy
 		/// assignment (unimplemented)
 	AccumulatedStatistic& operator = ( const AccumulatedStatistic& );
 
-protected:	// static members
-		/// all members are linked together
-	static AccumulatedStatistic* root;
-
-public:		// static methods
-		/// accumulate all registered statistic elements
-	static void accumulateAll ( void )
-	{
-		for ( AccumulatedStatistic* cur = root; cur; cur = cur->next )
-			cur->accumulate();
-	}
-
 protected:	// members
 		/// accumulated statistic
 	unsigned int total;
 		/// current session statistic
 	unsigned int local;
-		/// link to the next element
-	AccumulatedStatistic* next;
 
 public:		// interface
-		/// c'tor: link itself to the list
-	AccumulatedStatistic ( void ) : total(0), local(0), next(root) { root = this; }
-		/// d'tor: remove link from the list
-	~AccumulatedStatistic ( void )
-	{
-		// all statistic elements are deleted in the inversed creation order
-		if ( root == this )
-		{
-			root = next;
-			return;
-		}
-		// we are here if it's multi-environment and arbitrary deletion order was chosen
-		AccumulatedStatistic *prev = root, *cur = root->next;
-		// find a pointer to current node
-		for ( ; cur && cur != this; prev = cur, cur = cur->next )
-			(void)NULL;
-		if ( cur == this )
-			prev->next = next;
-	}
+		/// empty c'tor
+	AccumulatedStatistic ( void ) : total(0), local(0) {}
+		/// empty d'tor
+	~AccumulatedStatistic ( void ) {}
 
 	// access to the elements
 
@@ -114,7 +85,6 @@ public:		// interface
 			o << prefix << get(needLocal) << suffix;
 	}
 }; // AccumulatedStatistic
-#endif
 
 class DlSatTester
 {
@@ -129,6 +99,14 @@ protected:	// type definition
 	typedef DlCompletionTree::const_label_iterator const_label_iterator;
 		/// set to keep BPs (during cascaded cache creation)
 	typedef std::set<BipolarPointer> BPSet;
+		/// entry of the statistic table: counter and the corresponding element of the reasoning statistic
+	struct StatEntry
+	{
+			/// element of the reasoning statistic
+		TReasoningStatistic::Element elem;
+			/// counter that keeps the element's value
+		AccumulatedStatistic DlSatTester::* counter;
+	}; // StatEntry
 
 protected:	// types
 		/// possible flags of re-checking ALL-like expressions in new nodes
@@ -259,8 +237,13 @@ protected:	// members
 
 	// statistic elements
 
-#ifdef USE_REASONING_STATISTICS
+		/// all the statistic counters
+	static const StatEntry StatTable[];
+
 	AccumulatedStatistic
+		nSatTests,
+		nSubTests,
+
 		nTacticCalls,
 		nUseless,
 
@@ -286,6 +269,7 @@ protected:	// members
 
 		nStateSaves,
 		nStateRestores,
+		nBackjumps,
 		nNodeSaves,
 		nNodeRestores,
 
@@ -299,8 +283,21 @@ protected:	// members
 		nCacheFailedShallow,
 		nCacheFailed,
 		nCachedSat,
-		nCachedUnsat;
-#endif
+		nCachedUnsat,
+
+		nBlockingTests,
+		nBlockedNodes;
+
+	// adaptive ordering statistic
+
+		/// whether OR alternatives and rule applications are registered for the adaptive ordering
+	bool gatherBranchStat;
+		/// whether tactic operations are counted for the reasoning statistic
+	bool gatherStat;
+		/// number of applications of every regular operation
+	unsigned long OpApplied[ToDoPriorMatrix::opLast];
+		/// number of clashes found during the application of every regular operation
+	unsigned long OpClashes[ToDoPriorMatrix::opLast];
 
 	// current values
 
@@ -344,12 +341,8 @@ private:	// no copy
 
 protected:	// methods
 
-		/// increment statistic counter
-#ifdef USE_REASONING_STATISTICS
-#	define incStat(stat) stat.inc()
-#else
-#	define incStat(stat)
-#endif
+		/// increment statistic counter if the statistic is gathered
+	void incStat ( AccumulatedStatistic& stat ) { if ( gatherStat ) stat.inc(); }
 
 	//-----------------------------------------------------------------------------
 	// flags section
@@ -363,6 +356,12 @@ protected:	// methods
 	bool useLazyBlocking ( void ) const { return tBox.useLazyBlocking; }
 		/// @return true iff active signature is in use
 	bool useActiveSignature ( void ) const { return !tBox.getSplits()->empty(); }
+		/// @return true iff the current reasoning session could contain nominals
+	virtual bool sessionHasNominals ( void ) const { return tBox.testHasNominals(); }
+		/// @return true iff the reasoning was cancelled by the user
+	virtual bool isCancelled ( void ) const { return tBox.isCancelled(); }
+		/// @return node of the nominal NOM in the completion graph
+	virtual DlCompletionTree* getNominalNode ( const TIndividual* nom ) const { return nom->node; }
 
 		/// reset all session flags
 	void resetSessionFlags ( void );
@@ -514,7 +513,7 @@ protected:	// methods
 	{
 		modelCacheState ret = canBeCached(node) ? reportNodeCached(node) : csFailed;
 		// node is cached if RET is csValid
-		CGraph.saveRareCond(node->setCached(ret == csValid));
+		CGraph.saveRareCond(node->setCached(*CGraph.getRareStack(),ret == csValid));
 		return ret;
 	}
 		/// @return true iff cache status is invalid
@@ -861,6 +860,12 @@ protected:	// methods
 			CGraph.Print(LL);
 	}
 
+		/// add local values of all the statistic counters to the total ones
+	void accumulateStatistic ( void )
+	{
+		for ( const StatEntry* p = StatTable; p->counter != NULL; ++p )
+			(this->*p->counter).accumulate();
+	}
 		/// merge session statistics to the global one
 	void finaliseStatistic ( void );
 		/// write down statistics wrt LOCAL flag
@@ -991,7 +996,7 @@ public:
 	void writeTotalStatistic ( std::ostream& o )
 	{
 #	ifdef USE_REASONING_STATISTICS
-		AccumulatedStatistic::accumulateAll();	// ensure that the last reasoning results are in
+		accumulateStatistic();	// ensure that the last reasoning results are in
 		logStatisticData ( o, /*needLocal=*/false );
 #	endif
 		printBlockingStat (o);
@@ -1001,6 +1006,17 @@ public:
 
 		/// print SAT/SUB timings to O; @return total time spend during reasoning
 	float printReasoningTime ( std::ostream& o ) const;
+		/// add total values of the counters and SAT/SUB timings to STAT
+	void gatherStatistic ( TReasoningStatistic& stat ) const;
+		/// add numbers of applications and clashes of every regular operation to APPLIED and CLASHES
+	void addOperationStat ( unsigned long* applied, unsigned long* clashes ) const
+	{
+		for ( unsigned int i = 0; i < ToDoPriorMatrix::opLast; ++i )
+		{
+			applied[i] += OpApplied[i];
+			clashes[i] += OpClashes[i];
+		}
+	}
 }; // DlSatTester
 
 // implementation
@@ -1045,6 +1061,11 @@ DlSatTester :: runSat ( BipolarPointer p, BipolarPointer q )
 {
 	prepareReasoner();
 
+	if ( q == bpTOP )
+		nSatTests.inc();
+	else
+		nSubTests.inc();
+
 	// use general method to init node with P and add Q then
 	if ( initNewNode ( CGraph.getRoot(), DepSet(), p ) ||
 		 addToDoEntry ( CGraph.getRoot(), ConceptWDep(q) ) )
@@ -1115,6 +1136,8 @@ inline bool DlSatTester :: backJumpedRestore ( void )
 		return true;
 
 	// some non-deterministic choices were done
+	if ( getClashSet().level() + 1 < getCurLevel() )	// skip some branching points
+		incStat(nBackjumps);
 	restore ( getClashSet().level() );
 	return false;
 }
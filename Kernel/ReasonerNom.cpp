@@ -37,6 +37,10 @@ NominalReasoner :: initNominalVector ( void )
 void
 NominalReasoner :: prepareReasoner ( void )
 {
+	// the session needs another part of the ABox; it is known to be consistent
+	if ( SessionScope != CloudScope )
+		initCloudScope(SessionScope);
+
 	if ( LLM.isWritable(llSRState) )
 		LL << "\nInitNominalReasoner:";
 
@@ -58,7 +62,7 @@ NominalReasoner :: prepareReasoner ( void )
 }
 
 bool
-NominalReasoner :: consistentNominalCloud ( void )
+NominalReasoner :: buildNominalCloud ( void )
 {
 	if ( LLM.isWritable(llBegSat) )
 		LL << "\n--------------------------------------------\n"
@@ -90,55 +94,135 @@ NominalReasoner :: consistentNominalCloud ( void )
 	if ( LLM.isWritable(llSatResult) )
 		LL << "\nThe ontology is " << (result ? "consistent" : "INCONSISTENT");
 
-	if ( !result )
-		return false;
+	return result;
+}
+
+bool
+NominalReasoner :: initCloudScope ( unsigned int scope )
+{
+	// the nodes of the previous cloud are freed with the completion graph, so the nominals should forget them
+	if ( CloudScope != NoCloud )
+	{
+		const SingletonVector& nominals = getCloudNominals();
+		for ( SingletonVector::const_iterator p = nominals.begin(); p != nominals.end(); ++p )
+			setNominalNode ( *p, NULL );
+	}
+	// start from the empty completion graph
+	DlSatTester::prepareReasoner();
+	nonDetShift = 0;
+	CloudScope = scope;
+	return buildNominalCloud();
+}
+
+bool
+NominalReasoner :: consistentNominalCloud ( void )
+{
+	const ABoxPartition* partition = tBox.getABoxPartition();
+
+	if ( partition == NULL )
+	{
+		CloudScope = WholeABox;
+		if ( !buildNominalCloud() )
+			return false;
+
+		// ABox is consistent -> create cache for every nominal in KB
+		for ( SingletonVector::iterator p = Nominals.begin(); p != Nominals.end(); ++p )
+			updateClassifiedSingleton(*p);
+
+		return true;
+	}
 
-	// ABox is consistent -> create cache for every nominal in KB
-	for ( SingletonVector::iterator p = Nominals.begin(); p != Nominals.end(); ++p )
-		updateClassifiedSingleton(*p);
+	// ABox is consistent iff all its components are; create caches for the nominals of each of them
+	for ( unsigned int n = 0; n < partition->size(); ++n )
+	{
+		if ( !initCloudScope(n) )
+			return false;
+		const SingletonVector& nominals = partition->getMembers(n);
+		for ( SingletonVector::const_iterator p = nominals.begin(); p != nominals.end(); ++p )
+			updateClassifiedSingleton(*p);
+	}
 
 	return true;
 }
 
+void
+NominalReasoner :: setSessionScope ( const TConcept* p, const TConcept* q )
+{
+	const ABoxPartition* partition = tBox.getABoxPartition();
+
+	// an individual and a concept without nominals need only the component of the individual
+	if ( partition != NULL && p != NULL && p->isSingleton() && ( q == NULL || !q->negFeatures.hasSingletons() ) )
+	{
+		const TIndividual* ind = resolveSynonym(static_cast<const TIndividual*>(p));
+		if ( partition->contains(ind) )
+		{
+			SessionScope = partition->getComponent(ind);
+			return;
+		}
+	}
+
+	SessionScope = WholeABox;
+}
+
 /// create nominal nodes for all individuals in TBox
 bool
 NominalReasoner :: initNominalCloud ( void )
 {
 	// create nominal nodes and fills them with initial values
-	for ( SingletonVector::iterator p = Nominals.begin(); p != Nominals.end(); ++p )
+	const SingletonVector& nominals = getCloudNominals();
+	for ( SingletonVector::const_iterator p = nominals.begin(); p != nominals.end(); ++p )
 		if ( initNominalNode(*p) )
 			return true;	// ABox is inconsistent
 
+	// the assertions of a single component are kept by the ABox partition
+	if ( CloudScope != WholeABox )
+	{
+		const ABoxPartition* partition = tBox.getABoxPartition();
+		const ABoxPartition::RelatedVector& related = partition->getRelated(CloudScope);
+		for ( ABoxPartition::RelatedVector::const_iterator q = related.begin(); q != related.end(); ++q )
+			if ( initRelatedNominals(*q) )
+				return true;	// ABox is inconsistent
+		const ABoxPartition::DifferentVector& different = partition->getDifferent(CloudScope);
+		for ( ABoxPartition::DifferentVector::const_iterator r = different.begin(); r != different.end(); ++r )
+			if ( initDifferentNominals(**r) )
+				return true;	// ABox is inconsistent
+		return false;
+	}
+
 	// create edges between related nodes
 	for ( TBox::RelatedCollection::const_iterator q = tBox.RelatedI.begin(); q != tBox.RelatedI.end(); ++q, ++q )
 		if ( initRelatedNominals(*q) )
 			return true;	// ABox is inconsistent
 
 	// create disjoint markers on nominal nodes
-	if ( tBox.Different.empty() )
-		return false;
-
-	DepSet dummy;	// empty dep-set for the CGraph
-
 	for ( TBox::DifferentIndividuals::const_iterator
 		  r = tBox.Different.begin(); r != tBox.Different.end(); ++r )
-	{
-		CGraph.initIR();
-		for ( SingletonVector::const_iterator p = r->begin(); p != r->end(); ++p )
-			if ( CGraph.setCurIR ( resolveSynonym(*p)->node, dummy ) )	// different(c,c)
-				return true;
-		CGraph.finiIR();
-	}
+		if ( initDifferentNominals(*r) )
+			return true;	// ABox is inconsistent
 
 	// init was OK
 	return false;
 }
 
+/// make a disjoint marker on the nodes of the different nominals DIFF
+bool
+NominalReasoner :: initDifferentNominals ( const SingletonVector& diff )
+{
+	DepSet dummy;	// empty dep-set for the CGraph
+
+	CGraph.initIR();
+	for ( SingletonVector::const_iterator p = diff.begin(); p != diff.end(); ++p )
+		if ( CGraph.setCurIR ( getNominalNode(resolveSynonym(*p)), dummy ) )	// different(c,c)
+			return true;
+	CGraph.finiIR();
+	return false;
+}
+
 bool
 NominalReasoner :: initRelatedNominals ( const TRelated* rel )
 {
-	DlCompletionTree* from = resolveSynonym(rel->a)->node;
-	DlCompletionTree* to = resolveSynonym(rel->b)->node;
+	DlCompletionTree* from = getNominalNode(resolveSynonym(rel->a));
+	DlCompletionTree* to = getNominalNode(resolveSynonym(rel->b));
 	TRole* R = resolveSynonym(rel->R);
 	DepSet dep;	// empty dep-set
 
@@ -20,6 +20,7 @@ Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 #define REASONERNOM_H
 
 #include "Reasoner.h"
+#include "ABoxPartition.h"
 
 class NominalReasoner: public DlSatTester
 {
@@ -27,9 +28,19 @@ protected:	// type definition
 		/// vector of singletons
 	typedef TBox::SingletonVector SingletonVector;
 
+protected:	// constants
+		/// scope of the whole ABox
+	static const unsigned int WholeABox = static_cast<unsigned int>(-1);
+		/// scope of the nominal cloud that is not built yet
+	static const unsigned int NoCloud = static_cast<unsigned int>(-2);
+
 protected:	// members
 		/// all nominals defined in TBox
 	SingletonVector Nominals;
+		/// ABox component represented by the nominal cloud, or WholeABox
+	unsigned int CloudScope;
+		/// ABox component necessary for the current reasoning session, or WholeABox
+	unsigned int SessionScope;
 
 protected:	// methods
 		/// prepare reasoning
@@ -47,18 +58,30 @@ protected:	// methods
 		/// create cache entry for given singleton
 	void registerNominalCache ( TIndividual* p )
 		{ DLHeap.setCache ( p->pName, createModelCache(p->node->resolvePBlocker()) ); }
+		/// associate NODE with the nominal NOM
+	virtual void setNominalNode ( const TIndividual* nom, DlCompletionTree* node )
+		{ const_cast<TIndividual*>(nom)->node = node; }
 		/// init single nominal node
 	bool initNominalNode ( const TIndividual* nom )
 	{
 		DlCompletionTree* node = CGraph.getNewNode();
 		node->setNominalLevel();
-		const_cast<TIndividual*>(nom)->node = node;	// init nominal with associated node
+		setNominalNode ( nom, node );	// init nominal with associated node
 		return initNewNode ( node, DepSet(), nom->pName );	// ABox is inconsistent
 	}
+		/// @return nominals of the ABox component represented by the nominal cloud
+	const SingletonVector& getCloudNominals ( void ) const
+		{ return CloudScope == WholeABox ? Nominals : tBox.getABoxPartition()->getMembers(CloudScope); }
 		/// create nominal nodes for all individuals in TBox
 	bool initNominalCloud ( void );
+		/// build the completion graph of the nominal cloud; make a barrier after it if possible
+	bool buildNominalCloud ( void );
+		/// build the nominal cloud for the ABox component SCOPE from scratch
+	bool initCloudScope ( unsigned int scope );
 		/// make an R-edge between related nominals
 	bool initRelatedNominals ( const TRelated* rel );
+		/// make a disjoint marker on the nodes of the different nominals DIFF
+	bool initDifferentNominals ( const SingletonVector& diff );
 		/// use classification information for the nominal P
 	void updateClassifiedSingleton ( TIndividual* p )
 	{
@@ -77,6 +100,8 @@ public:
 		/// c'tor
 	NominalReasoner ( TBox& tbox )
 		: DlSatTester(tbox)
+		, CloudScope(NoCloud)
+		, SessionScope(WholeABox)
 	{
 		initNominalVector();
 	}
@@ -85,6 +110,15 @@ public:
 
 		/// check whether ontology with nominals is consistent
 	bool consistentNominalCloud ( void );
+		/// use only the part of the ABox related to P in the following SUB(P,Q) tests
+	void setSessionScope ( const TConcept* p, const TConcept* q );
+		/// build the nominal cloud of the whole ABox (if necessary), so every individual has its node
+	void initWholeABoxCloud ( void )
+	{
+		SessionScope = WholeABox;
+		if ( CloudScope != WholeABox )
+			initCloudScope(WholeABox);
+	}
 
 		/// check an extra conditions (for query answering)
 	bool checkExtraCond ( void );
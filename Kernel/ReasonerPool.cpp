@@ -0,0 +1,230 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <chrono>
+
+#include "ReasonerPool.h"
+
+//-----------------------------------------------------------------------------
+//--		implementation of DlSatWorker
+//-----------------------------------------------------------------------------
+
+void
+DlSatWorker :: runTask ( TSubTask& task )
+{
+	if ( Cancelled )
+		return;
+
+	// set blocking method wrt features of the test
+	LogicFeatures lf;
+	tBox.fillQueryFeatures ( lf, task.p, task.q );
+	fpp_assert ( !lf.hasSingletons() );
+	setBlockingMethod ( lf.hasInverseRole(), TBox::hasNR(lf) );
+
+	try
+	{
+		bool result = !runSat ( task.p->resolveId(), inverse(task.q->resolveId()) );
+		// the result of the cancelled test is meaningless
+		if ( Cancelled )
+			return;
+		task.result = result;
+		task.done = true;
+	}
+	catch (...)
+	{
+		// timeout or any other problem: leave the test to the main reasoner
+	}
+}
+
+//-----------------------------------------------------------------------------
+//--		implementation of NominalWorker
+//-----------------------------------------------------------------------------
+
+NominalWorker :: NominalWorker ( TBox& tbox, const std::atomic<bool>& cancelled )
+	: NominalReasoner(tbox)
+	, Cancelled(cancelled)
+{
+	// DAG is shared between the workers, so only the main reasoner gathers the branching statistic
+	gatherBranchStat = false;
+	// individuals are numbered from 1
+	for ( SingletonVector::const_iterator p = Nominals.begin(), p_end = Nominals.end(); p != p_end; ++p )
+		if ( static_cast<size_t>((*p)->getId()) >= Nodes.size() )
+			Nodes.resize ( (*p)->getId()+1, NULL );
+}
+
+bool
+NominalWorker :: init ( void )
+{
+	// the ABox is known to be consistent, so there are no caches to update here
+	LogicFeatures lf;
+	tBox.fillQueryFeatures ( lf, Nominals.front(), NULL );
+	setBlockingMethod ( lf.hasInverseRole(), TBox::hasNR(lf) );
+
+	// nominal clouds of the ABox components are built on demand
+	if ( tBox.getABoxPartition() != NULL )
+		return true;
+
+	try
+	{
+		return initCloudScope(WholeABox) && !Cancelled;
+	}
+	catch (...)
+	{
+		return false;
+	}
+}
+
+void
+NominalWorker :: runTask ( TSubTask& task )
+{
+	if ( Cancelled )
+		return;
+
+	// set blocking method wrt features of the test
+	LogicFeatures lf;
+	tBox.fillQueryFeatures ( lf, task.p, task.q );
+	setBlockingMethod ( lf.hasInverseRole(), TBox::hasNR(lf) );
+	setSessionScope ( task.p, task.q );
+
+	try
+	{
+		bool result = !runSat ( task.p->resolveId(), inverse(task.q->resolveId()) );
+		// the result of the cancelled test is meaningless
+		if ( Cancelled )
+			return;
+		task.result = result;
+		task.done = true;
+	}
+	catch (...)
+	{
+		// timeout or any other problem: leave the test to the main reasoner
+	}
+}
+
+//-----------------------------------------------------------------------------
+//--		implementation of TReasonerPool
+//-----------------------------------------------------------------------------
+
+TReasonerPool :: TReasonerPool ( TBox& tbox, unsigned int n )
+	: tBox(tbox)
+	, Tasks(NULL)
+	, nextTask(0)
+	, nRunning(0)
+	, batchNumber(0)
+	, stopped(false)
+	, Cancelled(false)
+{
+	// reasoners should be created in the main thread as they read the TBox
+	for ( unsigned int i = 0; i < n; ++i )
+		Workers.push_back(new DlSatWorker(tBox,Cancelled));
+	for ( WorkerVector::iterator p = Workers.begin(), p_end = Workers.end(); p != p_end; ++p )
+		Threads.push_back(std::thread(&TReasonerPool::workerLoop,this,*p));
+}
+
+TReasonerPool :: ~TReasonerPool ( void )
+{
+	{
+		std::lock_guard<std::mutex> guard(Lock);
+		stopped = true;
+	}
+	WorkReady.notify_all();
+	for ( ThreadVector::iterator p = Threads.begin(), p_end = Threads.end(); p != p_end; ++p )
+		p->join();
+	for ( WorkerVector::iterator q = Workers.begin(), q_end = Workers.end(); q != q_end; ++q )
+		delete *q;
+}
+
+void
+TReasonerPool :: workerLoop ( DlSatWorker* worker )
+{
+	unsigned long lastBatch = 0;
+	std::unique_lock<std::mutex> guard(Lock);
+
+	while ( true )
+	{
+		while ( !stopped && batchNumber == lastBatch )
+			WorkReady.wait(guard);
+		if ( stopped )
+			return;
+
+		lastBatch = batchNumber;
+		while ( nextTask < Tasks->size() )
+		{
+			TSubTask& task = (*Tasks)[nextTask++];
+			guard.unlock();
+			worker->runTask(task);
+			guard.lock();
+		}
+
+		if ( --nRunning == 0 )
+			WorkDone.notify_one();
+	}
+}
+
+void
+TReasonerPool :: run ( TaskVector& tasks )
+{
+	// reflect possible change of DAG size here, as it updates the shared structures
+	for ( WorkerVector::iterator p = Workers.begin(), p_end = Workers.end(); p != p_end; ++p )
+		(*p)->prepareReasoner();
+
+	std::unique_lock<std::mutex> guard(Lock);
+	Tasks = &tasks;
+	nextTask = 0;
+	nRunning = Workers.size();
+	Cancelled = false;
+	++batchNumber;
+	WorkReady.notify_all();
+
+	// wait for the workers; check the progress monitor from time to time
+	while ( nRunning > 0 )
+		if ( WorkDone.wait_for ( guard, std::chrono::milliseconds(50) ) == std::cv_status::timeout && tBox.isCancelled() )
+			Cancelled = true;
+
+	Tasks = NULL;
+}
+
+//-----------------------------------------------------------------------------
+//--		implementation of reasoner pool-related parts of TBox
+//-----------------------------------------------------------------------------
+
+bool
+TBox :: canTestInParallel ( const TConcept* p, const TConcept* q ) const
+{
+	if ( pReasonerPool == NULL )
+		return false;
+	// nominal reasoner changes the individuals, so such tests are performed sequentially
+	LogicFeatures lf;
+	fillQueryFeatures ( lf, p, q );
+	return !lf.hasSingletons();
+}
+
+bool
+TBox :: canRealiseInParallel ( void ) const
+{
+	// concepts don't depend on individuals only if there are no nominals in the TBox
+	return nThreads > 1 && nomReasoner != NULL && nNominalReferences == 0 && i_end() - i_begin() > 1;
+}
+
+TReasonerPool*
+TBox :: getReasonerPool ( void )
+{
+	if ( nThreads > 1 && pReasonerPool == NULL )
+		pReasonerPool = new TReasonerPool ( *this, nThreads );
+	return pReasonerPool;
+}
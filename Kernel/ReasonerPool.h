@@ -0,0 +1,175 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef REASONERPOOL_H
+#define REASONERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "ReasonerNom.h"
+
+/// single subsumption test P [= Q to be performed by a reasoner pool
+class TSubTask
+{
+public:		// members
+		/// sub-concept of the test
+	const TConcept* p;
+		/// super-concept of the test
+	const TConcept* q;
+		/// true iff the test was performed
+	bool done;
+		/// result of the test; valid iff DONE
+	bool result;
+
+public:		// interface
+		/// init c'tor
+	TSubTask ( const TConcept* P, const TConcept* Q ) : p(P), q(Q), done(false), result(false) {}
+}; // TSubTask
+
+/// SAT tester that runs nominal-free subsumption tests in a separate thread
+class DlSatWorker: public DlSatTester
+{
+protected:	// members
+		/// cancellation flag shared by all the workers of a pool
+	const std::atomic<bool>& Cancelled;
+
+protected:	// methods
+		/// worker runs only tests without nominals
+	virtual bool sessionHasNominals ( void ) const { return false; }
+		/// worker can't call progress monitor from its thread, so check the pool's flag
+	virtual bool isCancelled ( void ) const { return Cancelled; }
+
+public:		// interface
+		/// c'tor
+	DlSatWorker ( TBox& tbox, const std::atomic<bool>& cancelled )
+		: DlSatTester(tbox)
+		, Cancelled(cancelled)
+	{
+		// DAG is shared between the workers, so only the main reasoner gathers the branching statistic
+		gatherBranchStat = false;
+	}
+		/// empty d'tor
+	virtual ~DlSatWorker ( void ) {}
+
+		/// perform given TASK; leave it undone if the result can not be obtained
+	void runTask ( TSubTask& task );
+}; // DlSatWorker
+
+/// nominal reasoner with its own copy of the nominal cloud; runs realisation tests in a separate thread
+class NominalWorker: public NominalReasoner
+{
+protected:	// members
+		/// nodes of the nominals in the own completion graph, indexed by the individual's id
+	std::vector<DlCompletionTree*> Nodes;
+		/// cancellation flag shared by all the workers
+	const std::atomic<bool>& Cancelled;
+
+protected:	// methods
+		/// all the tests of a worker are made wrt ABox
+	virtual bool sessionHasNominals ( void ) const { return true; }
+		/// worker can't call progress monitor from its thread, so check the shared flag
+	virtual bool isCancelled ( void ) const { return Cancelled; }
+		/// individuals are shared between the workers, so keep the nominal nodes locally
+	virtual void setNominalNode ( const TIndividual* nom, DlCompletionTree* node ) { Nodes[nom->getId()] = node; }
+		/// @return node of the nominal NOM in the own completion graph
+	virtual DlCompletionTree* getNominalNode ( const TIndividual* nom ) const
+		{ return static_cast<size_t>(nom->getId()) < Nodes.size() ? Nodes[nom->getId()] : NULL; }
+
+public:		// interface
+		/// c'tor
+	NominalWorker ( TBox& tbox, const std::atomic<bool>& cancelled );
+		/// empty d'tor
+	virtual ~NominalWorker ( void ) {}
+
+		/// build the own nominal cloud; @return false if the ABox is inconsistent
+	bool init ( void );
+		/// perform given TASK; leave it undone if the result can not be obtained
+	void runTask ( TSubTask& task );
+}; // NominalWorker
+
+/// pool of threads, each with its own reasoner, to run independent subsumption tests in parallel
+class TReasonerPool
+{
+public:		// types
+		/// vector of tasks to be performed
+	typedef std::vector<TSubTask> TaskVector;
+
+protected:	// types
+		/// vector of the workers
+	typedef std::vector<DlSatWorker*> WorkerVector;
+		/// vector of the threads
+	typedef std::vector<std::thread> ThreadVector;
+
+protected:	// members
+		/// host TBox
+	TBox& tBox;
+		/// reasoners, one per thread
+	WorkerVector Workers;
+		/// threads
+	ThreadVector Threads;
+		/// lock protecting all the fields below
+	std::mutex Lock;
+		/// signalled when a new batch is available or the pool is stopping
+	std::condition_variable WorkReady;
+		/// signalled when the last worker has finished the batch
+	std::condition_variable WorkDone;
+		/// current batch of tasks; NULL if there is none
+	TaskVector* Tasks;
+		/// index of the next task to be taken
+	size_t nextTask;
+		/// number of workers that still process the current batch
+	unsigned int nRunning;
+		/// number of the current batch; used by the workers to detect the new one
+	unsigned long batchNumber;
+		/// flag to stop all the threads
+	bool stopped;
+		/// flag to cancel the current batch
+	std::atomic<bool> Cancelled;
+
+private:	// no copy
+		/// no copy c'tor
+	TReasonerPool ( const TReasonerPool& );
+		/// no assignment
+	TReasonerPool& operator = ( const TReasonerPool& );
+
+protected:	// methods
+		/// main loop of a thread that uses WORKER
+	void workerLoop ( DlSatWorker* worker );
+
+public:		// interface
+		/// c'tor: create N workers for a TBOX
+	TReasonerPool ( TBox& tbox, unsigned int n );
+		/// d'tor: stop all the threads
+	~TReasonerPool ( void );
+
+		/// get the number of workers in the pool
+	size_t size ( void ) const { return Workers.size(); }
+		/// perform all the TASKS; return when all of them are processed. DAG should not be changed meanwhile
+	void run ( TaskVector& tasks );
+		/// add the statistic of all the workers to STAT; should not be called while tasks are running
+	void gatherStatistic ( TReasoningStatistic& stat ) const
+	{
+		for ( WorkerVector::const_iterator p = Workers.begin(), p_end = Workers.end(); p != p_end; ++p )
+			(*p)->gatherStatistic(stat);
+	}
+}; // TReasonerPool
+
+#endif
@@ -0,0 +1,201 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <algorithm>
+
+#include "RoleAssertionIndex.h"
+#include "tRelated.h"
+
+//----------------------------------------------------------------------------------
+// building the index
+//----------------------------------------------------------------------------------
+
+void
+RoleAssertionIndex :: addIndividual ( const TIndividual* I )
+{
+	unsigned int n = static_cast<unsigned int>(I->getId());
+	if ( n >= Individuals.size() )
+		Individuals.resize ( n+1, NULL );
+	Individuals[n] = I;
+}
+
+void
+RoleAssertionIndex :: addRole ( TRole* R )
+{
+	unsigned int n = R->getIndex();
+	if ( n >= Edges.size() )
+	{
+		Edges.resize(n+1);
+		TransSubs.resize(n+1);
+		SelfRoles.resize ( n+1, false );
+	}
+	Roles.push_back(R);
+}
+
+void
+RoleAssertionIndex :: addAssertion ( const TRelated* rel )
+{
+	unsigned int a = id(rel->a), b = id(rel->b);
+	if ( a == 0 || b == 0 )
+		return;
+
+	// the edge belongs to the role and to all its super-roles
+	const TRole* R = rel->getRole();
+	if ( unsigned int n = index(R) )
+		Edges[n].push_back(Edge(a,b));
+	for ( TRole::const_iterator p = R->begin_anc(), p_end = R->end_anc(); p != p_end; ++p )
+		if ( unsigned int n = index(*p) )
+			Edges[n].push_back(Edge(a,b));
+}
+
+void
+RoleAssertionIndex :: addSelfRole ( const TRole* R )
+{
+	if ( unsigned int n = index(R) )
+		SelfRoles[n] = true;
+	if ( unsigned int n = index(R->inverse()) )
+		SelfRoles[n] = true;
+}
+
+/// @return true iff told assertions define all the fillers of R
+bool
+RoleAssertionIndex :: isTold ( const TRole* R ) const
+{
+	if ( R->isTop() || R->isReflexive() || R->hasSubCompositions() || SelfRoles[index(R)] )
+		return false;
+	for ( TRole::const_iterator p = R->begin_desc(), p_end = R->end_desc(); p != p_end; ++p )
+		if ( (*p)->isTop() || (*p)->isReflexive() || (*p)->hasSubCompositions() || SelfRoles[index(*p)] )
+			return false;
+	return true;
+}
+
+void
+RoleAssertionIndex :: finalise ( bool canMerge )
+{
+	Complete.assign ( Edges.size(), false );
+
+	for ( TRole::TRoleVec::const_iterator p = Roles.begin(), p_end = Roles.end(); p != p_end; ++p )
+	{
+		TRole* R = *p;
+		unsigned int n = index(R);
+
+		// sort the adjacency for the binary search
+		EdgeVec& E = Edges[n];
+		std::sort ( E.begin(), E.end() );
+		E.erase ( std::unique ( E.begin(), E.end() ), E.end() );
+
+		// gather transitive sub-roles of R
+		TRole::TRoleVec Trans;
+		if ( R->isTransitive() )
+			Trans.push_back(R);
+		for ( TRole::const_iterator q = R->begin_desc(), q_end = R->end_desc(); q != q_end; ++q )
+			if ( (*q)->isTransitive() && index(*q) != 0 )
+				Trans.push_back(*q);
+		// keep only maximal ones: the closure of a sub-role is a part of the closure of its super-role
+		for ( TRole::TRoleVec::const_iterator q = Trans.begin(), q_end = Trans.end(); q != q_end; ++q )
+		{
+			bool maximal = true;
+			for ( TRole::TRoleVec::const_iterator s = Trans.begin(); s != q_end && maximal; ++s )
+				if ( *s != *q && *(*q) < *(*s) )
+					maximal = false;
+			if ( maximal )
+				TransSubs[n].push_back(*q);
+		}
+
+		Complete[n] = !canMerge && isTold(R);
+	}
+}
+
+//----------------------------------------------------------------------------------
+// queries
+//----------------------------------------------------------------------------------
+
+/// add to ACC ids of all individuals reachable from I via the edges of a role with index R
+void
+RoleAssertionIndex :: addReachable ( unsigned int R, unsigned int I, IdVec& Acc ) const
+{
+	std::vector<bool> visited ( Individuals.size(), false );
+	IdVec todo(1,I);
+	while ( !todo.empty() )
+	{
+		unsigned int cur = todo.back();
+		todo.pop_back();
+		EdgeRange range = getEdges ( R, cur );
+		for ( EdgeVec::const_iterator p = range.first; p != range.second; ++p )
+			if ( !visited[p->second] )
+			{
+				visited[p->second] = true;
+				Acc.push_back(p->second);
+				todo.push_back(p->second);
+			}
+	}
+}
+
+/// add to ACC ids of all the R-fillers of I
+void
+RoleAssertionIndex :: addFillers ( const TRole* R, unsigned int I, IdVec& Acc ) const
+{
+	unsigned int n = index(R);
+	EdgeRange range = getEdges ( n, I );
+	for ( EdgeVec::const_iterator p = range.first; p != range.second; ++p )
+		Acc.push_back(p->second);
+	for ( TRole::TRoleVec::const_iterator q = TransSubs[n].begin(), q_end = TransSubs[n].end(); q != q_end; ++q )
+		addReachable ( index(*q), I, Acc );
+}
+
+bool
+RoleAssertionIndex :: isRelated ( const TIndividual* I, const TRole* R, const TIndividual* J ) const
+{
+	R = resolveSynonym(R);
+	unsigned int n = index(R), i = id(resolveSynonym(I)), j = id(resolveSynonym(J));
+	if ( n == 0 || i == 0 || j == 0 )
+		return false;
+	if ( hasEdge ( n, i, j ) )
+		return true;
+	if ( TransSubs[n].empty() )
+		return false;
+	IdVec Acc;
+	addFillers ( R, i, Acc );
+	return std::find ( Acc.begin(), Acc.end(), j ) != Acc.end();
+}
+
+bool
+RoleAssertionIndex :: hasRelated ( const TIndividual* I, const TRole* R ) const
+{
+	unsigned int n = index(resolveSynonym(R)), i = id(resolveSynonym(I));
+	if ( n == 0 || i == 0 )
+		return false;
+	// every transitive sub-role edge is an edge of R as well
+	EdgeRange range = getEdges ( n, i );
+	return range.first != range.second;
+}
+
+void
+RoleAssertionIndex :: getRelated ( const TIndividual* I, const TRole* R, CIVec& Result ) const
+{
+	R = resolveSynonym(R);
+	unsigned int n = index(R), i = id(resolveSynonym(I));
+	if ( n == 0 || i == 0 )
+		return;
+	IdVec Acc;
+	addFillers ( R, i, Acc );
+	std::sort ( Acc.begin(), Acc.end() );
+	Acc.erase ( std::unique ( Acc.begin(), Acc.end() ), Acc.end() );
+	for ( IdVec::const_iterator p = Acc.begin(), p_end = Acc.end(); p != p_end; ++p )
+		Result.push_back(Individuals[*p]);
+}
@@ -0,0 +1,131 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef ROLEASSERTIONINDEX_H
+#define ROLEASSERTIONINDEX_H
+
+#include <vector>
+#include <algorithm>
+
+#include "tIndividual.h"
+#include "tRole.h"
+
+class TRelated;
+
+/**	index of the role assertions that follow from the told ones by the role hierarchy
+	and transitivity. Every role keeps its (hierarchy-closed) edges between individuals'
+	ids in a sorted array; transitive closure is computed on demand. If nothing else
+	could relate named individuals via a role, the index is complete for this role.
+**/
+class RoleAssertionIndex
+{
+public:		// types
+		/// vector of individuals
+	typedef TIndividual::CIVec CIVec;
+
+protected:	// types
+		/// edge of a role graph: ids of the source and the target individuals
+	typedef std::pair<unsigned int, unsigned int> Edge;
+		/// adjacency of a role: edges sorted by the source, then by the target
+	typedef std::vector<Edge> EdgeVec;
+		/// range of edges with the same source
+	typedef std::pair<EdgeVec::const_iterator, EdgeVec::const_iterator> EdgeRange;
+		/// set of ids of individuals
+	typedef std::vector<unsigned int> IdVec;
+
+protected:	// members
+		/// individuals by their id
+	CIVec Individuals;
+		/// all the (non-synonym) object roles
+	TRole::TRoleVec Roles;
+		/// adjacency for every role, indexed by the role index
+	std::vector<EdgeVec> Edges;
+		/// maximal transitive sub-roles (including the role itself) of every role
+	std::vector<TRole::TRoleVec> TransSubs;
+		/// roles that appear in self-restrictions
+	std::vector<bool> SelfRoles;
+		/// flags whether the told assertions give all the fillers of a role
+	std::vector<bool> Complete;
+
+protected:	// methods
+		/// @return index of the role R in the arrays; 0 if R is not indexed
+	unsigned int index ( const TRole* R ) const
+	{
+		unsigned int n = R->getIndex();
+		return n < Edges.size() ? n : 0;
+	}
+		/// @return id of an individual I; 0 if I is not indexed
+	unsigned int id ( const TIndividual* I ) const
+	{
+		unsigned int n = static_cast<unsigned int>(I->getId());
+		return n < Individuals.size() && Individuals[n] == I ? n : 0;
+	}
+		/// @return all edges of a role with index R starting from the individual with id I
+	EdgeRange getEdges ( unsigned int R, unsigned int I ) const
+	{
+		const EdgeVec& E = Edges[R];
+		return std::make_pair (
+			std::lower_bound ( E.begin(), E.end(), Edge(I,0) ),
+			std::lower_bound ( E.begin(), E.end(), Edge(I+1,0) ) );
+	}
+		/// @return true iff the edge (I,J) is in the graph of a role with index R
+	bool hasEdge ( unsigned int R, unsigned int I, unsigned int J ) const
+		{ return std::binary_search ( Edges[R].begin(), Edges[R].end(), Edge(I,J) ); }
+		/// add to ACC ids of all individuals reachable from I via the edges of a role with index R
+	void addReachable ( unsigned int R, unsigned int I, IdVec& Acc ) const;
+		/// add to ACC ids of all the R-fillers of I
+	void addFillers ( const TRole* R, unsigned int I, IdVec& Acc ) const;
+		/// @return true iff told assertions define all the fillers of R
+	bool isTold ( const TRole* R ) const;
+
+public:		// interface
+		/// empty c'tor
+	RoleAssertionIndex ( void ) {}
+		/// empty d'tor
+	~RoleAssertionIndex ( void ) {}
+
+	// building the index
+
+		/// register an individual I
+	void addIndividual ( const TIndividual* I );
+		/// register an object role R
+	void addRole ( TRole* R );
+		/// add a told assertion to the index
+	void addAssertion ( const TRelated* rel );
+		/// mark R as a role of a self-restriction
+	void addSelfRole ( const TRole* R );
+		/// finish the index; CANMERGE means that named individuals could be merged
+	void finalise ( bool canMerge );
+
+	// queries
+
+		/// @return true iff the index contains all the R-fillers of all individuals
+	bool isComplete ( const TRole* R ) const
+	{
+		unsigned int n = index(resolveSynonym(R));
+		return n != 0 && Complete[n];
+	}
+		/// @return true iff R(I,J) follows from the told assertions
+	bool isRelated ( const TIndividual* I, const TRole* R, const TIndividual* J ) const;
+		/// @return true iff some R(I,x) follows from the told assertions
+	bool hasRelated ( const TIndividual* I, const TRole* R ) const;
+		/// put into RESULT all J such that R(I,J) follows from the told assertions
+	void getRelated ( const TIndividual* I, const TRole* R, CIVec& Result ) const;
+}; // RoleAssertionIndex
+
+#endif
@@ -24,46 +24,11 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "ReasonerNom.h"	// for initReasoner()
 #include "SaveLoadManager.h"
 
-const char* ReasoningKernel :: InternalStateFileHeader = "FaCT++InternalStateDump1.0";
+const char* ReasoningKernel :: InternalStateFileHeader = "FaCT++InternalStateDump2.0";
+const char* ReasoningKernel :: ModelCacheFileHeader = "FaCT++ModelCacheDump1.0";
 
-const int bytesInInt = sizeof(int);
-
-#if 0
-// FIXME!! try to avoid recursion later on
-static inline
-void saveUIntAux ( ostream& o, unsigned int n, const int rest )
-{
-	if ( rest > 1 )
-		saveUIntAux ( o, n/256, rest-1 );
-	m.o() << (unsigned char)n%256;
-}
-
-static inline
-void saveUInt ( ostream& o, unsigned int n )
-{
-	saveUIntAux ( o, n, bytesInInt );
-}
-
-static inline
-void saveSInt ( ostream& o, int n ) { saveUInt(o,n); }
-
-static inline
-unsigned int loadUInt ( istream& i )
-{
-	static unsigned int ret = 0;
-	unsigned char byte;
-	for ( int j = bytesInInt-1; j >= 0; --j )
-	{
-		i >> byte;
-		ret *= 256;
-		ret += byte;
-	}
-	return ret;
-}
-
-static inline
-int loadSInt ( istream& i ) { return (int)loadUInt(i); }
-#endif	// 0
+/// version of the binary format of the saved state
+const unsigned int FormatVersion = 2;
 
 //----------------------------------------------------------
 //-- Implementation of the Kernel methods (Kernel.h)
@@ -93,6 +58,7 @@ ReasoningKernel :: Save ( void )
 	fpp_assert ( pSLManager != NULL );
 	pSLManager->prepare(/*input=*/false);
 	Save(*pSLManager);
+	pSLManager->flush();
 }
 
 void
@@ -114,6 +80,40 @@ ReasoningKernel :: Load ( SaveLoadManager& m )
 	std::cout << "Reasoner internal state loaded in " << t << " sec" << std::endl;
 }
 
+void
+ReasoningKernel :: SaveModelCaches ( void )
+{
+	fpp_assert ( pCacheSLManager != NULL );
+	pCacheSLManager->prepare(/*input=*/false);
+	pCacheSLManager->saveString(ModelCacheFileHeader);
+	pCacheSLManager->saveUInt(FormatVersion);
+	getTBox()->SaveModelCaches(*pCacheSLManager);
+	pCacheSLManager->flush();
+}
+
+void
+ReasoningKernel :: LoadModelCaches ( void )
+{
+	fpp_assert ( pCacheSLManager != NULL );
+	if ( !pCacheSLManager->existsContent() )
+		return;
+	try
+	{
+		SaveLoadManager& m = *pCacheSLManager;
+		m.prepare(/*input=*/true);
+		m.checkStream();
+		std::string str;
+		m.loadString(str);
+		if ( str != ModelCacheFileHeader || m.loadUInt() != FormatVersion )
+			return;
+		getTBox()->LoadModelCaches(m);
+	}
+	catch ( const EFPPSaveLoad& )
+	{
+		// broken content: the rest of the caches will be rebuilt
+	}
+}
+
 void
 ReasoningKernel :: Load ( void )
 {
@@ -127,24 +127,26 @@ ReasoningKernel :: Load ( void )
 void
 ReasoningKernel :: SaveHeader ( SaveLoadManager& m ) const
 {
-	m.o() << InternalStateFileHeader << "\n" << Version << "\n" << bytesInInt << "\n";
+	m.saveString(InternalStateFileHeader);
+	m.saveString(Version);
+	m.saveUInt(FormatVersion);
 }
 
 void
 ReasoningKernel :: LoadHeader ( SaveLoadManager& m )
 {
 	std::string str;
-	m.i() >> str;
+	// files in other formats could have garbage instead of the header length
+	try { m.loadString(str); }
+	catch ( const EFPPSaveLoad& ) { str.clear(); }
 	if ( str != InternalStateFileHeader )
 		throw EFPPSaveLoad("Incompatible save/load header");
-	m.i() >> str;
+	m.loadString(str);
 	// FIXME!! we don't check version equivalence for now
 //	if ( str != Version )
 //		return true;
-	int n;
-	m.i() >> n;
-	if ( n != bytesInInt )
-		throw EFPPSaveLoad("Saved file differ in word size");
+	if ( m.loadUInt() != FormatVersion )
+		throw EFPPSaveLoad("Saved file has incompatible format version");
 }
 
 //-- save/load options (Kernel.h)
@@ -152,14 +154,14 @@ ReasoningKernel :: LoadHeader ( SaveLoadManager& m )
 void
 ReasoningKernel :: SaveOptions ( SaveLoadManager& m ) const
 {
-	m.o() << "Options\n";
+	m.saveString("Options");
 }
 
 void
 ReasoningKernel :: LoadOptions ( SaveLoadManager& m )
 {
 	std::string options;
-	m.i() >> options;
+	m.loadString(options);
 }
 
 //-- save/load KB (Kernel.h)
@@ -203,22 +205,15 @@ static void
 SaveTNECollection ( const TNECollection<T>& collection, SaveLoadManager& m, const std::set<const TNamedEntry*>& excluded )
 {
 	typename TNECollection<T>::const_iterator p, p_beg = collection.begin(), p_end = collection.end();
-	// get the max length of the identifier in the collection
-	unsigned int maxLength = 0, curLength, size = 0;
+	// get the number of the saved entries
+	unsigned int size = 0;
 
 	for ( p = p_beg; p < p_end; ++p )
-	{
 		if ( excluded.count(*p) == 0 )
-		{
 			++size;
-			if ( maxLength < (curLength = strlen((*p)->getName())) )
-				maxLength = curLength;
-		}
-	}
 
-	// save number of entries and max length of the entry
+	// save number of entries
 	m.saveUInt(size);
-	m.saveUInt(maxLength);
 
 	// save names of all entries
 	for ( p = p_beg; p < p_end; ++p )
@@ -226,7 +221,7 @@ SaveTNECollection ( const TNECollection<T>& collection, SaveLoadManager& m, cons
 		// register all entries in the global map
 		m.registerE(*p);
 		if ( excluded.count(*p) == 0 )
-			m.o() << (*p)->getName() << "\n";
+			m.saveString((*p)->getName());
 	}
 
 	// save the entries itself
@@ -241,21 +236,16 @@ LoadTNECollection ( TNECollection<T>& collection, SaveLoadManager& m )
 	// sanity check: Load shall be done for the empty collection and only once
 //	fpp_assert ( size() == 0 );
 
-	unsigned int collSize, maxLength;
-	collSize = m.loadUInt();
-	maxLength = m.loadUInt();
-	++maxLength;
-	char* name = new char[maxLength];
+	unsigned int collSize = m.loadUInt();
+	std::string name;
 
 	// register all the named entries
 	for ( unsigned int j = 0; j < collSize; ++j )
 	{
-		m.i().getline ( name, maxLength, '\n' );
+		m.loadString(name);
 		m.registerE(collection.get(name));
 	}
 
-	delete [] name;
-
 	// load all the named entries
 //	for ( iterator p = begin(); p < end(); ++p )
 //		(*p)->Load(i);
@@ -269,16 +259,14 @@ static void
 SaveRoleMaster ( const RoleMaster& RM, SaveLoadManager& m )
 {
 	RoleMaster::const_iterator p, p_beg = RM.begin(), p_end = RM.end();
-	// get the max length of the identifier in the collection
-	unsigned int maxLength = 0, curLength, size = 0;
+	// get the number of (non-inverse) entries
+	unsigned int size = 0;
 
-	for ( p = p_beg; p != p_end; p += 2, size++ )
-		if ( maxLength < (curLength = strlen((*p)->getName())) )
-			maxLength = curLength;
+	for ( p = p_beg; p != p_end; p += 2 )
+		++size;
 
-	// save number of entries and max length of the entry
+	// save number of entries
 	m.saveUInt(size);
-	m.saveUInt(maxLength);
 
 	// register const entries in the global map
 	m.registerE(RM.getBotRole());
@@ -290,7 +278,7 @@ SaveRoleMaster ( const RoleMaster& RM, SaveLoadManager& m )
 		TRole* R = *p;
 		m.registerE(R);
 		m.registerE(R->inverse());
-		m.o() << R->getName() << "\n";
+		m.saveString(R->getName());
 	}
 
 //	// save the entries itself
@@ -308,11 +296,8 @@ LoadRoleMaster ( RoleMaster& RM, SaveLoadManager& m )
 	// sanity check: Load shall be done for the empty collection and only once
 //	fpp_assert ( size() == 0 );
 
-	unsigned int RMSize, maxLength;
-	RMSize = m.loadUInt();
-	maxLength = m.loadUInt();
-	++maxLength;
-	char* name = new char[maxLength];
+	unsigned int RMSize = m.loadUInt();
+	std::string name;
 
 	// register const entries in the global map
 	m.registerE(RM.getBotRole());
@@ -321,14 +306,12 @@ LoadRoleMaster ( RoleMaster& RM, SaveLoadManager& m )
 	// register all the named entries
 	for ( unsigned int j = 0; j < RMSize; ++j )
 	{
-		m.i().getline ( name, maxLength, '\n' );
+		m.loadString(name);
 		TRole* R = RM.ensureRoleName(name);
 		m.registerE(R);
 		m.registerE(R->inverse());
 	}
 
-	delete [] name;
-
 //	// load all the named entries
 //	for ( iterator p = begin(); p < end(); ++p )
 //		(*p)->Load(i);
@@ -389,7 +372,6 @@ static void
 SaveDLDag ( const DLDag& dag, SaveLoadManager& m )
 {
 	m.saveUInt(dag.size());
-	m.o() << "\n";
 	// skip fake vertex and TOP
 	for ( unsigned int i = 2; i < dag.size(); ++i )
 		dag[i].Save(m);
@@ -403,7 +385,7 @@ LoadDLDag ( DLDag& dag, SaveLoadManager& m )
 	for ( j = 2; j < size; ++j )
 	{
 		DagTag tag = static_cast<DagTag>(m.loadUInt());
-		DLVertex* v = new DLVertex(tag);
+		DLVertex* v = new(dag) DLVertex(tag);
 		v->Load(m);
 		dag.directAdd(v);
 	}
@@ -428,30 +410,25 @@ VerifyDag ( const DLDag& dag, SaveLoadManager& m )
 	for ( j = 2; j < size; ++j )
 	{
 		DagTag tag = static_cast<DagTag>(m.loadUInt());
-		DLVertex* v = new DLVertex(tag);
-		v->Load(m);
-		if ( *v != dag[j] )
+		DLVertex v(tag);
+		v.Load(m);
+		if ( v != dag[j] )
 		{
 			std::cout << "DAG verification fail: dag entry at " << j << " is ";
-			v->Print(std::cout);
+			v.Print(std::cout);
 			std::cout << ", expected ";
 			dag[j].Print(std::cout);
 			std::cout << "\n";
-			delete v;
 			return false;
 		}
-		delete v;
 	}
 
 	return true;
 }
 
 static void
-SaveSingleCache ( SaveLoadManager& m, BipolarPointer bp, const modelCacheInterface* cache )
+SaveCacheContent ( SaveLoadManager& m, const modelCacheInterface* cache )
 {
-	if ( cache == NULL )
-		return;
-	m.saveSInt(bp);
 	m.saveUInt(cache->getCacheType());
 	switch ( cache->getCacheType() )
 	{
@@ -470,7 +447,15 @@ SaveSingleCache ( SaveLoadManager& m, BipolarPointer bp, const modelCacheInterfa
 	default:
 		fpp_unreachable();
 	}
-	m.o() << "\n";
+}
+
+static void
+SaveSingleCache ( SaveLoadManager& m, BipolarPointer bp, const modelCacheInterface* cache )
+{
+	if ( cache == NULL )
+		return;
+	m.saveSInt(bp);
+	SaveCacheContent ( m, cache );
 }
 
 static const modelCacheInterface*
@@ -501,7 +486,7 @@ LoadSingleCache ( SaveLoadManager& m )
 static void
 SaveDagCache ( const DLDag& dag, SaveLoadManager& m )
 {
-	m.o() << "\nDC";	// dag cache
+	m.saveTag("DC");	// dag cache
 	for ( unsigned int i = 2; i < dag.size(); ++i )
 	{
 		const DLVertex& v = dag[i];
@@ -514,8 +499,7 @@ SaveDagCache ( const DLDag& dag, SaveLoadManager& m )
 static void
 LoadDagCache ( DLDag& dag, SaveLoadManager& m )
 {
-	m.expectChar('D');
-	m.expectChar('C');
+	m.expectTag("DC");
 	while ( BipolarPointer bp = m.loadSInt() )
 		dag.setCache ( bp, LoadSingleCache(m) );
 }
@@ -539,24 +523,24 @@ void
 TBox :: Save ( SaveLoadManager& m )
 {
 	initPointerMaps(m);
-	m.o() << "\nDT";
+	m.saveTag("DT");
 	for ( DataTypeCenter::const_iterator p = DTCenter.begin(), p_end = DTCenter.end(); p != p_end; ++p )
 		SaveDataType(*p,m);
-	m.o() << "\nC";
+	m.saveTag("C");
 	std::set<const TNamedEntry*> empty;
 	SaveTNECollection(Concepts,m,empty);
-	m.o() << "\nI";
+	m.saveTag("I");
 	SaveTNECollection(Individuals,m,empty);
-	m.o() << "\nOR";
+	m.saveTag("OR");
 	SaveRoleMaster(ORM,m);
-	m.o() << "\nDR";
+	m.saveTag("DR");
 	SaveRoleMaster(DRM,m);
-	m.o() << "\nD";
+	m.saveTag("D");
 	DLHeap.removeQuery();
 	SaveDLDag(DLHeap,m);
 	if ( Status > kbCChecked )
 	{
-		m.o() << "\nCT";
+		m.saveTag("CT");
 		pTax->Save(m,empty);
 	}
 	SaveDagCache(DLHeap,m);
@@ -567,21 +551,18 @@ TBox :: Load ( SaveLoadManager& m, KBStatus status )
 {
 	Status = status;
 	initPointerMaps(m);
-	m.expectChar('D');
-	m.expectChar('T');
+	m.expectTag("DT");
 	for ( DataTypeCenter::iterator p = DTCenter.begin(), p_end = DTCenter.end(); p != p_end; ++p )
 		LoadDataType(*p,m);
-	m.expectChar('C');
+	m.expectTag("C");
 	LoadTNECollection(Concepts,m);
-	m.expectChar('I');
+	m.expectTag("I");
 	LoadTNECollection(Individuals,m);
-	m.expectChar('O');
-	m.expectChar('R');
+	m.expectTag("OR");
 	LoadRoleMaster(ORM,m);
-	m.expectChar('D');
-	m.expectChar('R');
+	m.expectTag("DR");
 	LoadRoleMaster(DRM,m);
-	m.expectChar('D');
+	m.expectTag("D");
 	DLHeap.setSubOrder();
 //	LoadDLDag(DLHeap,m);
 	if ( !VerifyDag(DLHeap,m) )
@@ -591,8 +572,7 @@ TBox :: Load ( SaveLoadManager& m, KBStatus status )
 	{
 		initTaxonomy();
 		pTaxCreator->setBottomUp(GCIs);
-		m.expectChar('C');
-		m.expectChar('T');
+		m.expectTag("CT");
 		pTax->Load(m);
 	}
 	LoadDagCache(DLHeap,m);
@@ -602,11 +582,11 @@ void
 TBox :: SaveTaxonomy ( SaveLoadManager& m, const std::set<const TNamedEntry*>& excluded )
 {
 	initPointerMaps(m);
-	m.o() << "\nC";
+	m.saveTag("C");
 	SaveTNECollection(Concepts,m,excluded);
-	m.o() << "\nI";
+	m.saveTag("I");
 	SaveTNECollection(Individuals,m,excluded);
-	m.o() << "\nCT";
+	m.saveTag("CT");
 	pTax->Save(m,excluded);
 }
 
@@ -614,17 +594,287 @@ void
 TBox :: LoadTaxonomy ( SaveLoadManager& m )
 {
 	initPointerMaps(m);
-	m.expectChar('C');
+	m.expectTag("C");
 	LoadTNECollection(Concepts,m);
-	m.expectChar('I');
+	m.expectTag("I");
 	LoadTNECollection(Individuals,m);
 	initTaxonomy();
 	pTaxCreator->setBottomUp(GCIs);
-	m.expectChar('C');
-	m.expectChar('T');
+	m.expectTag("CT");
 	pTax->Load(m);
 }
 
+//----------------------------------------------------------
+//-- Save/Load model caches (dlTBox.h)
+//----------------------------------------------------------
+
+/// save hash value H
+static void
+SaveHash ( SaveLoadManager& m, dlDagHash::HashValue h )
+{
+	m.saveUInt(static_cast<unsigned int>(h>>32));
+	m.saveUInt(static_cast<unsigned int>(h));
+}
+
+/// load hash value
+static dlDagHash::HashValue
+LoadHash ( SaveLoadManager& m )
+{
+	dlDagHash::HashValue h = m.loadUInt();
+	return (h<<32) | m.loadUInt();
+}
+
+/// map from the entity name to its index
+typedef std::map<std::string, unsigned int> NameIndexMap;
+
+/// load the table of names saved in another session and translate it into the index map MAP using NAMES (for the flag false/true)
+static void
+LoadIndexMap ( SaveLoadManager& m, const NameIndexMap names[2], std::vector<unsigned int>& Map )
+{
+	std::string name;
+	Map.resize(m.loadUInt());
+	for ( std::vector<unsigned int>::iterator p = Map.begin(), p_end = Map.end(); p != p_end; ++p )
+	{
+		const NameIndexMap& Names = names[m.loadUInt() != 0];
+		m.loadString(name);
+		NameIndexMap::const_iterator q = Names.find(name);
+		*p = q == Names.end() ? 0 : q->second;
+	}
+}
+
+dlDagHash::HashValue
+TBox :: getRoleHash ( const TRole* R, const dlDagHash& hash ) const
+{
+	dlDagHash::HashValue h = dlDagHash::add ( dlDagHash::get(R->getName()), R->isDataRole() );
+	h = dlDagHash::add ( h, R->isTransitive() | R->isFunctional() << 1 | R->isTopFunc() << 2 | R->isSymmetric() << 3 |
+							R->isAsymmetric() << 4 | R->isReflexive() << 5 | R->isIrreflexive() << 6 );
+
+	// domain (range is the domain of the inverse)
+	if ( isValid(R->getBPDomain()) )
+	{
+		dlDagHash::HashValue domain = hash.get(R->getBPDomain());
+		if ( domain == 0 )
+			return 0;
+		h = dlDagHash::add ( h, domain );
+	}
+
+	// hierarchy
+	dlDagHash::HashValue anc = 0;
+	for ( TRole::const_iterator p = R->begin_anc(), p_end = R->end_anc(); p != p_end; ++p )
+		anc = dlDagHash::addToSet ( anc, dlDagHash::get((*p)->getName()) );
+	h = dlDagHash::add ( h, anc );
+
+	// disjoint roles
+	if ( R->isDisjoint() )
+	{
+		const RoleMaster& RM = R->isDataRole() ? DRM : ORM;
+		dlDagHash::HashValue disj = 0;
+		for ( RoleMaster::const_iterator p = RM.begin(), p_end = RM.end(); p < p_end; ++p )
+			if ( !(*p)->isSynonym() && R->isDisjoint(*p) )
+				disj = dlDagHash::addToSet ( disj, dlDagHash::get((*p)->getName()) );
+		h = dlDagHash::add ( h, disj );
+	}
+
+	// automaton, as the caches of the non-simple roles are built using it
+	const RoleAutomaton& A = R->getAutomaton();
+	for ( RAState state = 0; state < A.size(); ++state )
+	{
+		h = dlDagHash::add ( h, state );
+		for ( RAStateTransitions::const_iterator p = A[state].begin(), p_end = A[state].end(); p != p_end; ++p )
+		{
+			h = dlDagHash::add ( h, (*p)->final() );
+			for ( RATransition::const_iterator q = (*p)->begin(), q_end = (*p)->end(); q != q_end; ++q )
+				h = dlDagHash::add ( h, dlDagHash::get((*q)->getName()) );
+		}
+	}
+
+	return h;
+}
+
+dlDagHash::HashValue
+TBox :: getModelCacheContext ( const dlDagHash& hash ) const
+{
+	// nominal caches depend on the ABox
+	if ( KBFeatures.hasSingletons() )
+		return 0;
+
+	// GCIs
+	dlDagHash::HashValue h = hash.get(T_G);
+	if ( h == 0 )
+		return 0;
+
+	// roles
+	dlDagHash::HashValue roles = 0;
+	RoleMaster::const_iterator r, r_end;
+	for ( r = ORM.begin(), r_end = ORM.end(); r < r_end; ++r )
+		if ( !(*r)->isSynonym() )
+		{
+			dlDagHash::HashValue role = getRoleHash ( *r, hash );
+			if ( role == 0 )
+				return 0;
+			roles = dlDagHash::addToSet ( roles, role );
+		}
+	for ( r = DRM.begin(), r_end = DRM.end(); r < r_end; ++r )
+		if ( !(*r)->isSynonym() )
+		{
+			dlDagHash::HashValue role = getRoleHash ( *r, hash );
+			if ( role == 0 )
+				return 0;
+			roles = dlDagHash::addToSet ( roles, role );
+		}
+	h = dlDagHash::add ( h, roles );
+
+	// simple rules
+	dlDagHash::HashValue rules = 0;
+	for ( TSimpleRules::const_iterator p = SimpleRules.begin(), p_end = SimpleRules.end(); p < p_end; ++p )
+	{
+		dlDagHash::HashValue head = hash.get((*p)->bpHead);
+		if ( head == 0 )
+			return 0;
+		dlDagHash::HashValue body = 0;
+		for ( ConceptVector::const_iterator q = (*p)->Body.begin(), q_end = (*p)->Body.end(); q < q_end; ++q )
+			body = dlDagHash::addToSet ( body, dlDagHash::get((*q)->getName()) );
+		rules = dlDagHash::addToSet ( rules, dlDagHash::add ( body, head ) );
+	}
+
+	return dlDagHash::add ( h, rules );
+}
+
+void
+TBox :: SaveModelCaches ( SaveLoadManager& m ) const
+{
+	dlDagHash hash(DLHeap);
+	dlDagHash::HashValue context = getModelCacheContext(hash);
+	SaveHash ( m, context );
+	if ( context == 0 )	// nothing could be reused
+		return;
+
+	// concept and individual names
+	m.saveTag("CN");
+	m.saveUInt(ConceptMap.size());
+	for ( ConceptVector::const_iterator p = ConceptMap.begin(), p_end = ConceptMap.end(); p < p_end; ++p )
+	{
+		m.saveUInt ( *p != NULL && (*p)->isSingleton() );
+		m.saveString ( *p != NULL ? (*p)->getName() : "" );
+	}
+
+	// role names
+	std::vector<const TRole*> Roles ( nR, static_cast<const TRole*>(NULL) );
+	RoleMaster::const_iterator r, r_end;
+	for ( r = ORM.begin(), r_end = ORM.end(); r < r_end; ++r )
+		if ( !(*r)->isSynonym() )
+			Roles[(*r)->index()] = *r;
+	for ( r = DRM.begin(), r_end = DRM.end(); r < r_end; ++r )
+		if ( !(*r)->isSynonym() )
+			Roles[(*r)->index()] = *r;
+	m.saveTag("RN");
+	m.saveUInt(Roles.size());
+	for ( std::vector<const TRole*>::const_iterator p = Roles.begin(), p_end = Roles.end(); p < p_end; ++p )
+	{
+		m.saveUInt ( *p != NULL && (*p)->isDataRole() );
+		m.saveString ( *p != NULL ? (*p)->getName() : "" );
+	}
+
+	// complete caches that are independent of the nominals
+	m.saveTag("MC");
+	for ( BipolarPointer i = 2; i < static_cast<BipolarPointer>(DLHeap.size()); ++i )
+	{
+		// individuals are checked in the context of the ABox
+		if ( DLHeap[i].Type() == dtPSingleton || DLHeap[i].Type() == dtNSingleton )
+			continue;
+		for ( BipolarPointer bp = i; bp >= -i; bp -= 2*i )
+		{
+			const modelCacheInterface* cache = DLHeap.getCache(bp);
+			dlDagHash::HashValue key = hash.get(bp);
+			if ( cache == NULL || key == 0 || cache->hasNominals() ||
+				 ( cache->getState() != csValid && cache->getState() != csInvalid ) ||
+				 ( cache->getCacheType() != modelCacheInterface::mctConst && cache->getCacheType() != modelCacheInterface::mctIan ) )
+				continue;
+			SaveHash ( m, key );
+			SaveCacheContent ( m, cache );
+		}
+	}
+	SaveHash ( m, 0 );
+}
+
+unsigned int
+TBox :: LoadModelCaches ( SaveLoadManager& m )
+{
+	dlDagHash hash(DLHeap);
+	dlDagHash::HashValue context = getModelCacheContext(hash);
+	if ( context == 0 || LoadHash(m) != context )	// caches were built wrt different GCIs or roles
+		return 0;
+
+	// translate concept and role indices
+	NameIndexMap names[2];
+	for ( ConceptVector::const_iterator p = ConceptMap.begin(), p_end = ConceptMap.end(); p < p_end; ++p )
+		if ( *p != NULL )
+			names[(*p)->isSingleton()][(*p)->getName()] = (*p)->index();
+	std::vector<unsigned int> cMap, rMap;
+	m.expectTag("CN");
+	LoadIndexMap ( m, names, cMap );
+
+	names[0].clear();
+	names[1].clear();
+	RoleMaster::const_iterator r, r_end;
+	for ( r = ORM.begin(), r_end = ORM.end(); r < r_end; ++r )
+		if ( !(*r)->isSynonym() )
+			names[0][(*r)->getName()] = (*r)->index();
+	for ( r = DRM.begin(), r_end = DRM.end(); r < r_end; ++r )
+		if ( !(*r)->isSynonym() )
+			names[1][(*r)->getName()] = (*r)->index();
+	m.expectTag("RN");
+	LoadIndexMap ( m, names, rMap );
+
+	// DAG entries that still need a cache
+	std::map<dlDagHash::HashValue, BipolarPointer> Keys;
+	for ( BipolarPointer i = 2; i < static_cast<BipolarPointer>(DLHeap.size()); ++i )
+		for ( BipolarPointer bp = i; bp >= -i; bp -= 2*i )
+			if ( DLHeap.getCache(bp) == NULL && hash.get(bp) != 0 )
+				Keys[hash.get(bp)] = bp;
+
+	// load caches and set the ones of the unchanged entries
+	unsigned int n = 0;
+	m.expectTag("MC");
+	while ( dlDagHash::HashValue key = LoadHash(m) )
+	{
+		modelCacheInterface* cache = NULL;
+		switch ( m.loadUInt() )
+		{
+		case modelCacheInterface::mctConst:
+			cache = new modelCacheConst ( m.loadUInt() != 0 );
+			break;
+		case modelCacheInterface::mctIan:
+		{
+			bool hasNominals = bool(m.loadUInt());
+			m.loadUInt();	// nC and nR of the saved session
+			m.loadUInt();
+			modelCacheIan* ian = new modelCacheIan ( hasNominals, nC, nR );
+			cache = ian;
+			if ( !ian->Load ( m, cMap, rMap ) )	// some names are gone
+			{
+				delete cache;
+				cache = NULL;
+			}
+			break;
+		}
+		default:
+			throw EFPPSaveLoad("Unexpected model cache type");
+		}
+
+		std::map<dlDagHash::HashValue, BipolarPointer>::iterator p = Keys.find(key);
+		if ( cache == NULL || p == Keys.end() )
+			delete cache;
+		else
+		{
+			DLHeap.setCache ( p->second, cache );
+			Keys.erase(p);
+			++n;
+		}
+	}
+	return n;
+}
+
 //----------------------------------------------------------
 //-- Save/Load incremental structures (Kernel.h)
 //----------------------------------------------------------
@@ -634,7 +884,7 @@ ReasoningKernel :: SaveIncremental ( SaveLoadManager& m ) const
 {
 	if ( !useIncrementalReasoning )
 		return;
-	m.o() << "\nQ";
+	m.saveTag("Q");
 	m.saveUInt(Name2Sig.size());
 	for ( NameSigMap::const_iterator p = Name2Sig.begin(), p_end = Name2Sig.end(); p != p_end; ++p )
 	{
@@ -651,7 +901,7 @@ ReasoningKernel :: LoadIncremental ( SaveLoadManager& m )
 {
 	if ( !useIncrementalReasoning )
 		return;
-	m.expectChar('Q');
+	m.expectTag("Q");
 	Name2Sig.clear();
 	unsigned int size = m.loadUInt();
 	for ( unsigned int j = 0; j < size; j++ )
@@ -758,7 +1008,6 @@ TaxonomyVertex :: SaveLabel ( SaveLoadManager& m ) const
 	m.saveUInt(synonyms.size());
 	for ( syn_iterator p = begin_syn(), p_end = end_syn(); p < p_end; ++p )
 		m.savePointer(*p);
-	m.o() << "\n";
 }
 
 void
@@ -780,7 +1029,6 @@ TaxonomyVertex :: SaveNeighbours ( SaveLoadManager& m ) const
 	m.saveUInt(neigh(false).size());
 	for ( p = begin(false), p_end = end(false); p != p_end; ++p )
 		m.savePointer(*p);
-	m.o() << "\n";
 }
 
 void
@@ -802,22 +1050,29 @@ TaxonomyVertex :: LoadNeighbours ( SaveLoadManager& m )
 void
 Taxonomy :: Save ( SaveLoadManager& m, const std::set<const TNamedEntry*>& excluded ) const
 {
+	// vertices that are out of use (eg, removed during incremental reasoning) are not saved
 	TaxVertexVec::const_iterator p, p_beg = Graph.begin(), p_end = Graph.end();
+	unsigned int size = 0;
 	for ( p = p_beg; p != p_end; ++p )
-		m.registerV(*p);
+		if ( (*p)->isInUse() )
+		{
+			m.registerV(*p);
+			++size;
+		}
 
 	// save number of taxonomy elements
-	m.saveUInt(Graph.size()/*-excluded.size()*/);
-	m.o() << "\n";
+	m.saveUInt(size/*-excluded.size()*/);
 
 	// save labels for all verteces of the taxonomy
 	for ( p = p_beg; p != p_end; ++p )
 //		if ( excluded.count((*p)->getPrimer()) == 0 )
+		if ( (*p)->isInUse() )
 			(*p)->SaveLabel(m);
 
 	// save the taxonomys hierarchy
 	for ( p = p_beg; p != p_end; ++p )
 //		if ( excluded.count((*p)->getPrimer()) == 0 )
+		if ( (*p)->isInUse() )
 			(*p)->SaveNeighbours(m);
 }
 
@@ -846,22 +1101,42 @@ Taxonomy :: Load ( SaveLoadManager& m )
 //-- Implementation of the modelCacheIan methods (modelCacheIan.h)
 //----------------------------------------------------------
 
+template<class IndexSet>
 static void
-SaveIndexSet ( SaveLoadManager& m, const TSetAsTree& Set )
+SaveIndexSet ( SaveLoadManager& m, const IndexSet& Set )
 {
 	m.saveUInt(Set.size());
-	for ( TSetAsTree::const_iterator p = Set.begin(), p_end = Set.end(); p != p_end; ++p )
+	for ( typename IndexSet::const_iterator p = Set.begin(), p_end = Set.end(); p != p_end; ++p )
 		m.saveUInt(*p);
 }
 
+template<class IndexSet>
 static void
-LoadIndexSet ( SaveLoadManager& m, TSetAsTree& Set )
+LoadIndexSet ( SaveLoadManager& m, IndexSet& Set )
 {
 	unsigned int n = m.loadUInt();
 	for ( unsigned int i = 0; i < n; i++ )
 		Set.insert(m.loadUInt());
 }
 
+/// load the set saved in another session translating the indices by MAP; @return false if some index is unknown
+template<class IndexSet>
+static bool
+LoadIndexSet ( SaveLoadManager& m, IndexSet& Set, const std::vector<unsigned int>& Map )
+{
+	bool known = true;
+	unsigned int n = m.loadUInt();
+	for ( unsigned int i = 0; i < n; i++ )
+	{
+		unsigned int index = m.loadUInt();
+		if ( index < Map.size() && Map[index] != 0 )
+			Set.insert(Map[index]);
+		else
+			known = false;
+	}
+	return known;
+}
+
 void
 modelCacheIan :: Save ( SaveLoadManager& m ) const
 {
@@ -902,6 +1177,26 @@ modelCacheIan :: Load ( SaveLoadManager& m )
 	curState = (modelCacheState) m.loadUInt();
 }
 
+bool
+modelCacheIan :: Load ( SaveLoadManager& m, const std::vector<unsigned int>& cMap, const std::vector<unsigned int>& rMap )
+{
+	// read the whole cache even if some index is unknown
+	bool known = true;
+	known &= LoadIndexSet(m,posDConcepts,cMap);
+	known &= LoadIndexSet(m,posNConcepts,cMap);
+	known &= LoadIndexSet(m,negDConcepts,cMap);
+	known &= LoadIndexSet(m,negNConcepts,cMap);
+#ifdef RKG_USE_SIMPLE_RULES
+	known &= LoadIndexSet(m,extraDConcepts,cMap);
+	known &= LoadIndexSet(m,extraNConcepts,cMap);
+#endif
+	known &= LoadIndexSet(m,existsRoles,rMap);
+	known &= LoadIndexSet(m,forallRoles,rMap);
+	known &= LoadIndexSet(m,funcRoles,rMap);
+	curState = (modelCacheState) m.loadUInt();
+	return known;
+}
+
 //----------------------------------------------------------
 //-- Implementation of the DLVertex methods (dlVertex.h)
 //----------------------------------------------------------
@@ -920,7 +1215,7 @@ DLVertex :: Save ( SaveLoadManager& m ) const
 		break;
 
 	case dtAnd:
-		m.saveUInt(Child.size());
+		m.saveUInt(nArgs());
 		for ( const_iterator p = begin(); p != end(); ++p )
 			m.saveSInt(*p);
 		break;
@@ -965,7 +1260,6 @@ DLVertex :: Save ( SaveLoadManager& m ) const
 		m.saveSInt(getC());
 		break;
 	}
-	m.o() << "\n";
 }
 
 void
@@ -985,6 +1279,7 @@ DLVertex :: Load ( SaveLoadManager& m )
 		unsigned int size = m.loadUInt();
 		for ( unsigned int j = 0; j < size; ++j )
 			Child.push_back(m.loadSInt());
+		syncChildren();
 		break;
 	}
 
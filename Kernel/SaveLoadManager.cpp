@@ -37,17 +37,55 @@ SaveLoadManager :: clearContent ( void ) const
 void
 SaveLoadManager :: prepare ( bool input )
 {
-	// close all previously open streams
-	delete ip;
-	delete op;
-	ip = NULL;
-	op = NULL;
+	// write the previously saved content
+	bool justSaved = saving;
+	flush();
+	failed = false;
+	pos = 0;
 
-	// open a new one
-	if ( input )
-		ip = new std::ifstream(filename.c_str());
-	else
-		op = new std::ofstream(filename.c_str());
+	if ( !input )
+	{
+		saving = true;
+		Buffer.clear();
+		return;
+	}
+
+	// the buffer already contains the file content
+	if ( justSaved )
+		return;
+
+	// read the whole file in one go
+	Buffer.clear();
+	std::ifstream file ( filename.c_str(), std::ios::in | std::ios::binary );
+	if ( !file.good() )
+	{
+		failed = true;
+		return;
+	}
+	file.seekg ( 0, std::ios::end );
+	std::streamoff size = file.tellg();
+	file.seekg ( 0, std::ios::beg );
+	if ( size > 0 )
+	{
+		Buffer.resize(static_cast<size_t>(size));
+		file.read ( &Buffer[0], size );
+	}
+	failed = !file.good();
+}
+
+void
+SaveLoadManager :: flush ( void )
+{
+	if ( !saving )
+		return;
+	saving = false;
+
+	std::ofstream file ( filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+	if ( !Buffer.empty() )
+		file.write ( &Buffer[0], Buffer.size() );
+	file.close();
+	if ( file.fail() )
+		throw EFPPSaveLoad ( filename, /*save=*/true );
 }
 
 void
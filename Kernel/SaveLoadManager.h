@@ -20,7 +20,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #define SAVELOADMANAGER_H
 
 #include <string>
-#include <iostream>
+#include <cstring>
 #include <vector>
 #include <map>
 
@@ -94,15 +94,23 @@ protected:	// types
 		unsigned int getI ( const T* p ) { ensure(p); return p2i[p]; }
 	}; // PointerMap
 
+protected:	// types
+		/// type of the byte buffer
+	typedef std::vector<char> BufferType;
+
 protected:	// members
 		/// name of S/L dir
 	std::string dirname;
 		/// file name
 	std::string filename;
-		/// input stream pointer
-	std::istream* ip;
-		/// output stream pointer
-	std::ostream* op;
+		/// content of the file being loaded or the image of the file being saved
+	BufferType Buffer;
+		/// position of the next byte to read in the loaded buffer
+	size_t pos;
+		/// true iff the buffer is an output one that is not yet written to a file
+	bool saving;
+		/// true iff last save/load operation failed
+	bool failed;
 
 		// uint <-> named entity map for the current taxonomy
 	PointerMap<TNamedEntity> eMap;
@@ -111,14 +119,29 @@ protected:	// members
 		// uint <-> TaxonomyVertex map to update the taxonomy
 	PointerMap<TaxonomyVertex> tvMap;
 
+protected:	// methods
+		/// @throw an exception if there are no N more bytes in the input buffer
+	void ensureAvailable ( size_t n )
+	{
+		if ( unlikely ( n > Buffer.size() - pos ) )
+			throw EFPPSaveLoad("Unexpected end of the saved internal state");
+	}
+		/// add N bytes starting from P to the output buffer
+	void saveBytes ( const char* p, size_t n ) { Buffer.insert ( Buffer.end(), p, p+n ); }
+
 public:		// methods
-		/// init c'tor: remember the S/L name
-	SaveLoadManager ( const std::string& name ) : dirname(name), ip(NULL), op(NULL) { filename = name+".fpp.state"; }
-		/// empty d'tor
+		/// init c'tor: remember the S/L name; the content is kept in the file with a given SUFFIX
+	SaveLoadManager ( const std::string& name, const char* suffix = ".fpp.state" )
+		: dirname(name)
+		, pos(0)
+		, saving(false)
+		, failed(false)
+		{ filename = name+suffix; }
+		/// d'tor: write the unsaved data
 	~SaveLoadManager ( void )
 	{
-		delete ip;
-		delete op;
+		try { flush(); }
+		catch ( const EFPPSaveLoad& ) {}
 	}
 
 	// context information
@@ -128,57 +151,76 @@ public:		// methods
 		/// clear all the content corresponding to the manager
 	void clearContent ( void ) const;
 
-	// set up stream
+	// set up buffer
 
-		/// prepare stream according to INPUT value
+		/// prepare buffer according to INPUT value: read the whole file for input, clear the buffer for output
 	void prepare ( bool input );
-		/// get an input stream
-	std::istream& i ( void ) { return *ip; }
-		/// get an output stream
-	std::ostream& o ( void ) { return *op; }
-		/// check whether stream is in a good shape
+		/// write the output buffer (if any) to a file
+	void flush ( void );
+		/// check whether the last operation was successful
 	void checkStream ( void ) const
 	{
-		if ( ip && unlikely(!ip->good()) )
-			throw EFPPSaveLoad ( filename, /*save=*/false);
-		if ( op && unlikely(!op->good()) )
-			throw EFPPSaveLoad ( filename, /*save=*/true);
+		if ( unlikely(failed) )
+			throw EFPPSaveLoad ( filename, /*save=*/saving );
 	}
 
 	// save/load primitives
 
+		/// save a single char
+	void saveChar ( const char c ) { Buffer.push_back(c); }
 		/// load a single char from input, throw an exception if it is not a given one
 	inline void expectChar ( const char C )
 	{
-		char c;
-		i() >> c;
-		if ( c != C )
+		ensureAvailable(1);
+		if ( Buffer[pos++] != C )
 			throw EFPPSaveLoad(C);
 	}
+		/// save a section tag
+	void saveTag ( const char* tag ) { saveBytes ( tag, strlen(tag) ); }
+		/// load a section tag, throw an exception if the input does not contain it
+	void expectTag ( const char* tag )
+	{
+		for ( ; *tag; ++tag )
+			expectChar(*tag);
+	}
 
 	// save/load integers
 
-		/// save unsigned integer
-	inline void saveUInt ( unsigned int n ) { o() << "(" << n << ")"; }
+		/// save unsigned integer as 4 bytes, LSB first
+	inline void saveUInt ( unsigned int n )
+	{
+		char buf[4] = { char(n&0xFF), char((n>>8)&0xFF), char((n>>16)&0xFF), char((n>>24)&0xFF) };
+		saveBytes ( buf, 4 );
+	}
 		/// save signed integer
-	inline void saveSInt ( int n ) { o() << "(" << n << ")"; }
+	inline void saveSInt ( int n ) { saveUInt(static_cast<unsigned int>(n)); }
 		/// load unsigned integer
 	inline unsigned int loadUInt ( void )
 	{
-		unsigned int ret;
-		expectChar('(');
-		i() >> ret;
-		expectChar(')');
-		return ret;
+		ensureAvailable(4);
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(&Buffer[pos]);
+		pos += 4;
+		return p[0] | (p[1]<<8) | (p[2]<<16) | (static_cast<unsigned int>(p[3])<<24);
 	}
 		/// load signed integer
-	inline int loadSInt ( void )
+	inline int loadSInt ( void ) { return static_cast<int>(loadUInt()); }
+
+	// save/load strings
+
+		/// save string as its length followed by its characters
+	void saveString ( const char* str )
+	{
+		size_t n = strlen(str);
+		saveUInt(n);
+		saveBytes ( str, n );
+	}
+		/// load string saved by saveString() into STR
+	void loadString ( std::string& str )
 	{
-		int ret;
-		expectChar('(');
-		i() >> ret;
-		expectChar(')');
-		return ret;
+		unsigned int n = loadUInt();
+		ensureAvailable(n);
+		str.assign ( Buffer.begin()+pos, Buffer.begin()+pos+n );
+		pos += n;
 	}
 
 	// pointer <-> int related methods
@@ -19,6 +19,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef SIGINDEX_H
 #define SIGINDEX_H
 
+#include <vector>
+
 #include "tDLAxiom.h"
 #include "tSignature.h"
 #include "LocalityChecker.h"
@@ -32,16 +34,31 @@ public:		// types
 	typedef AxiomVec::const_iterator const_iterator;
 
 protected:	// types
-		/// map between entities and axioms that contains them in their signature
-	typedef std::map<const TNamedEntity*, AxiomVec> EntityAxiomMap;
+		/// set of axioms; removed axioms stay there until the set is compacted
+	struct AxiomList
+	{
+			/// all the axioms in the set, including the removed ones
+		AxiomVec Axioms;
+			/// number of the removed axioms that are still in the set
+		unsigned int nRemoved;
+			/// empty c'tor
+		AxiomList ( void ) : nRemoved(0) {}
+	}; // AxiomList
+		/// sets of axioms that contains an entity in their signature, indexed by the entity id;
+		/// ids are dense within the expression manager of the ontology, so the vector has no gaps
+	typedef std::vector<AxiomList> EntityAxiomVec;
 
 protected:	// members
-		/// map itself
-	EntityAxiomMap Base;
+		/// axioms by the entities of their signatures
+	EntityAxiomVec Base;
+		/// sets of axioms non-local wrt the empty signature
+	AxiomList NonLocal[2];
+		/// flag per axiom (indexed by axiom id) showing whether the axiom is registered
+	std::vector<bool> Registered;
+		/// empty set of axioms for the entities that are not in the index
+	const AxiomVec EmptyAxioms;
 		/// locality checker
 	LocalityChecker* Checker;
-		/// sets of axioms non-local wrt the empty signature
-	AxiomVec NonLocal[2];
 		/// empty signature to test the non-locality
 	TSignature emptySig;
 		/// number of registered axioms
@@ -50,19 +67,43 @@ protected:	// members
 	unsigned int nUnregistered;
 
 protected:	// methods
-		/// add an axiom AX to an axiom set AXIOMS
-	void add ( AxiomVec& axioms, TDLAxiom* ax ) { axioms.push_back(ax); }
-		/// remove an axiom AX from an axiom set AXIOMS
-	void remove ( AxiomVec& axioms, TDLAxiom* ax )
+		/// @return true iff the axiom AX is registered
+	bool isRegistered ( const TDLAxiom* ax ) const { return ax->getId() < Registered.size() && Registered[ax->getId()]; }
+		/// set the registered status of the axiom AX to VALUE
+	void setRegistered ( const TDLAxiom* ax, bool value )
+	{
+		if ( ax->getId() >= Registered.size() )
+			Registered.resize ( ax->getId()+1, false );
+		Registered[ax->getId()] = value;
+	}
+		/// get the set of axioms for an ENTITY; create it if necessary
+	AxiomList& getList ( const TNamedEntity* entity )
+	{
+		if ( entity->getId() >= Base.size() )
+			Base.resize ( entity->getId()+1 );
+		return Base[entity->getId()];
+	}
+		/// remove all the unregistered axioms from the axiom set LIST
+	void compact ( AxiomList& list )
+	{
+		if ( likely(list.nRemoved == 0) )
+			return;
+		iterator q = list.Axioms.begin();
+		for ( const_iterator p = list.Axioms.begin(), p_end = list.Axioms.end(); p != p_end; ++p )
+			if ( isRegistered(*p) )
+				*q++ = *p;
+		list.Axioms.erase ( q, list.Axioms.end() );
+		list.nRemoved = 0;
+	}
+		/// add an axiom AX to an axiom set LIST
+	void add ( AxiomList& list, TDLAxiom* ax )
 	{
-		for ( iterator p = axioms.begin(), p_end = axioms.end(); p != p_end; ++p )
-			if ( *p == ax )
-			{
-				*p = axioms.back();
-				axioms.pop_back();
-				break;
-			}
+		// AX might still be there if it was removed before
+		compact(list);
+		list.Axioms.push_back(ax);
 	}
+		/// remove an axiom AX from an axiom set LIST; the axiom should be unregistered before compaction
+	void remove ( AxiomList& list ) { ++list.nRemoved; }
 		/// add axiom AX to the non-local set with top-locality value TOP
 	void checkNonLocal ( TDLAxiom* ax, bool top )
 	{
@@ -77,21 +118,27 @@ protected:	// methods
 		/// register an axiom
 	void registerAx ( TDLAxiom* ax )
 	{
+		if ( isRegistered(ax) )
+			return;
 		for ( TSignature::iterator p = ax->getSignature().begin(), p_end = ax->getSignature().end(); p != p_end; ++p )
-			add ( Base[*p], ax );
+			add ( getList(*p), ax );
 		// check whether the axiom is non-local
 		checkNonLocal ( ax, /*top=*/false );
 		checkNonLocal ( ax, /*top=*/true );
+		setRegistered ( ax, true );
 		++nRegistered;
 	}
 		/// unregister an axiom AX
 	void unregisterAx ( TDLAxiom* ax )
 	{
+		if ( !isRegistered(ax) )
+			return;
+		setRegistered ( ax, false );
 		for ( TSignature::iterator p = ax->getSignature().begin(), p_end = ax->getSignature().end(); p != p_end; ++p )
-			remove ( Base[*p], ax );
-		// remove from the non-locality
-		remove ( NonLocal[false], ax );
-		remove ( NonLocal[true], ax );
+			remove(getList(*p));
+		// remove from the non-locality; it is safe to count axioms that are not there
+		remove(NonLocal[false]);
+		remove(NonLocal[true]);
 		++nUnregistered;
 	}
 
@@ -114,23 +161,66 @@ public:		// interface
 		/// preprocess given set of axioms
 	void preprocessOntology ( const AxiomVec& axioms )
 	{
+		// allocate the lists for all the entities of the ontology at once
+		unsigned int maxId = 0;
+		for ( const_iterator p = axioms.begin(), p_end = axioms.end(); p != p_end; ++p )
+			for ( TSignature::iterator q = (*p)->getSignature().begin(), q_end = (*p)->getSignature().end(); q != q_end; ++q )
+				maxId = std::max ( maxId, (*q)->getId() );
+		if ( maxId >= Base.size() )
+			Base.resize(maxId+1);
 		for ( const_iterator p = axioms.begin(), p_end = axioms.end(); p != p_end; ++p )
 			processAx(*p);
+	}
+		/// register all the axioms from [BEGIN,END) regardless of their Used status
+	void preprocessAxioms ( const_iterator begin, const_iterator end )
+	{
+		for ( const_iterator p = begin; p != end; ++p )
+			registerAx(*p);
 	}
 		/// clear internal structures
 	void clear ( void )
 	{
 		Base.clear();
-		NonLocal[0].clear();
-		NonLocal[1].clear();
+		NonLocal[0] = AxiomList();
+		NonLocal[1] = AxiomList();
+		Registered.clear();
 	}
 
 	// get the set by the index
 
 		/// given an entity, return a set of all axioms that tontain this entity in a signature
-	const AxiomVec& getAxioms ( const TNamedEntity* entity ) { return Base[entity]; }
+	const AxiomVec& getAxioms ( const TNamedEntity* entity )
+	{
+		if ( entity->getId() >= Base.size() )
+			return EmptyAxioms;
+		AxiomList& list = Base[entity->getId()];
+		compact(list);
+		return list.Axioms;
+	}
 		/// get the non-local axioms with top-locality value TOP
-	const AxiomVec& getNonLocal ( bool top ) const { return NonLocal[!top]; }
+	const AxiomVec& getNonLocal ( bool top )
+	{
+		compact(NonLocal[!top]);
+		return NonLocal[!top].Axioms;
+	}
+
+		/// @return true iff some of the registered axioms is non-local wrt SIG
+	bool hasNonLocal ( const TSignature& sig )
+	{
+		// axioms that are non-local wrt the empty signature are non-local wrt any signature
+		if ( !getNonLocal(sig.topCLocal()).empty() )
+			return true;
+		// the other axioms could be non-local only if they share some entities with SIG
+		Checker->setSignatureValue(sig);
+		for ( TSignature::iterator p = sig.begin(), p_end = sig.end(); p != p_end; ++p )
+		{
+			const AxiomVec& Axioms = getAxioms(*p);
+			for ( const_iterator q = Axioms.begin(), q_end = Axioms.end(); q != q_end; ++q )
+				if ( !Checker->local(*q) )
+					return true;
+		}
+		return false;
+	}
 
 	// access to statistics
 
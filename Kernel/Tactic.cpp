@@ -234,11 +234,11 @@ bool DlSatTester :: commonTacticBodySingleton ( const DLVertex& cur )
 	encounterNominal = true;
 
 	const TIndividual* C = static_cast<const TIndividual*>(cur.getConcept());
-	fpp_assert ( C->node != NULL );
+	fpp_assert ( getNominalNode(C) != NULL );
 
 	// if node for C was purged due to merge -- find proper one
 	DepSet dep = curConcept.getDep();
-	DlCompletionTree* realNode = C->node->resolvePBlocker(dep);
+	DlCompletionTree* realNode = getNominalNode(C)->resolvePBlocker(dep);
 
 	if ( realNode != curNode )	// check if o-rule is applicable
 		// apply o-rule: merge 2 nodes
@@ -350,6 +350,17 @@ bool DlSatTester :: processOrEntry ( void )
 	const char* reason = NULL;
 	DepSet dep;
 
+	// register the choice; the previous alternative (if any) failed
+	if ( gatherBranchStat )
+	{
+		DLHeap[C].incChoices(isPositive(C.bp()));
+		if ( p != p_end )
+		{
+			BipolarPointer prev = (p_end-1)->bp();
+			DLHeap[prev].incFails(isPositive(prev));
+		}
+	}
+
 	if ( bcOr->isLastOrEntry() )
 	{
 		// cumulative dep-set will be used
@@ -499,7 +510,7 @@ bool DlSatTester :: commonTacticBodySome ( const DLVertex& cur )	// for ER.C con
 				return false;
 
 	// check for the case \ER.{o}
-	if ( tBox.testHasNominals() && isPositive(C) )
+	if ( sessionHasNominals() && isPositive(C) )
 	{
 		const DLVertex& nom = DLHeap[C];
 		if ( nom.Type() == dtPSingleton || nom.Type() == dtNSingleton )
@@ -629,10 +640,10 @@ bool DlSatTester :: commonTacticBodyValue ( const TRole* R, const TIndividual* n
 
 	incStat(nSomeCalls);
 
-	fpp_assert ( nom->node != NULL );
+	fpp_assert ( getNominalNode(nom) != NULL );
 
 	// if node for NOM was purged due to merge -- find proper one
-	DlCompletionTree* realNode = nom->node->resolvePBlocker(dep);
+	DlCompletionTree* realNode = getNominalNode(nom)->resolvePBlocker(dep);
 
 	// check if merging will lead to clash because of disjoint roles
 	if ( R->isDisjoint() && checkDisjointRoleClash ( curNode, realNode, R, dep ) )
@@ -1333,25 +1344,27 @@ bool DlSatTester :: mergeLabels ( const CGLabel& from, DlCompletionTree* to, con
 	// arrays for simple- and complex concepts in the merged-to vector
 	CWDArray& sc(lab.getLabel(dtPConcept));
 	CWDArray& cc(lab.getLabel(dtForall));
+	// restorers for the updated dep-sets
+	TRareSaveStack& stack = *CGraph.getRareStack();
 
 	// due to merging, all the concepts in the TO label
 	// should be updated to the new dep-set DEP
 	for ( p = sc.begin(), p_end = sc.end(); p < p_end; ++p )
-		CGraph.saveRareCond ( sc.updateDepSet ( p->bp(), dep ) );
+		CGraph.saveRareCond ( sc.updateDepSet ( stack, p->bp(), dep ) );
 	for ( p = cc.begin(), p_end = cc.end(); p < p_end; ++p )
-		CGraph.saveRareCond ( cc.updateDepSet ( p->bp(), dep ) );
+		CGraph.saveRareCond ( cc.updateDepSet ( stack, p->bp(), dep ) );
 
 	// if the concept is already exists in the node label --
 	// we still need to update it with a new dep-set (due to merging)
 	// note that DEP is already there
 	for ( p = from.begin_sc(), p_end = from.end_sc(); p < p_end; ++p )
 		if ( findConcept ( sc, *p ) )
-			CGraph.saveRareCond ( sc.updateDepSet ( p->bp(), p->getDep() ) );
+			CGraph.saveRareCond ( sc.updateDepSet ( stack, p->bp(), p->getDep() ) );
 		else
 			switchResult ( insertToDoEntry ( to, ConceptWDep(*p,dep), DLHeap[*p].Type(), "M" ) );
 	for ( p = from.begin_cc(), p_end = from.end_cc(); p < p_end; ++p )
 		if ( findConcept ( cc, *p ) )
-			CGraph.saveRareCond ( cc.updateDepSet ( p->bp(), p->getDep() ) );
+			CGraph.saveRareCond ( cc.updateDepSet ( stack, p->bp(), p->getDep() ) );
 		else
 			switchResult ( insertToDoEntry ( to, ConceptWDep(*p,dep), DLHeap[*p].Type(), "M" ) );
 
@@ -95,6 +95,43 @@ bool Taxonomy :: processSynonym ( void )
 	return true;
 }
 
+/// remove NODE from the hierarchy, linking its children to its parents directly
+void
+Taxonomy :: unlinkNode ( TaxonomyVertex* node )
+{
+	const TaxVertexVec parents ( node->begin(/*upDirection=*/true), node->end(/*upDirection=*/true) );
+	const TaxVertexVec children ( node->begin(/*upDirection=*/false), node->end(/*upDirection=*/false) );
+	node->remove();
+
+	for ( TaxVertexVec::const_iterator c = children.begin(), c_end = children.end(); c != c_end; ++c )
+	{
+		// mark all the remaining ancestors of a child; parents of NODE are incomparable,
+		// so a parent is the direct one for the child iff it is not marked
+		clearVisited();
+		markAncestors(*c);
+		for ( TaxVertexVec::const_iterator p = parents.begin(), p_end = parents.end(); p != p_end; ++p )
+			if ( !isVisited(*p) )
+			{
+				(*c)->addNeighbour ( /*upDirection=*/true, *p );
+				(*p)->addNeighbour ( /*upDirection=*/false, *c );
+			}
+	}
+	clearVisited();
+}
+
+/// remove ENTRY from the taxonomy; keep the rest of the hierarchy intact
+void
+Taxonomy :: removeEntry ( const ClassifiableEntry* entry )
+{
+	TaxonomyVertex* v = entry->getTaxVertex();
+	// the vertex remains if it has other entries or is TOP/BOTTOM
+	if ( v->hasSynonyms() )
+		v->removeSynonym(entry);
+	else if ( v != getTopVertex() && v != getBottomVertex() )
+		unlinkNode(v);
+	const_cast<ClassifiableEntry*>(entry)->setTaxVertex(NULL);
+}
+
 /// call this method after taxonomy is built
 void
 Taxonomy :: finalise ( void )
@@ -21,6 +21,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 // taxonomy graph for DL
 
+#include <set>
+
 #include "taxVertex.h"
 
 class SaveLoadManager;
@@ -30,6 +32,8 @@ class Taxonomy
 protected:	// typedefs
 		/// type for a vector of TaxVertex
 	typedef std::vector<TaxonomyVertex*> TaxVertexVec;
+		/// set of vertices visited by a traversal that doesn't use labels
+	typedef std::set<const TaxonomyVertex*> VisitedSet;
 
 protected:	// members
 		/// array of taxonomy vertices
@@ -63,6 +67,10 @@ public:		// classification interface
 	void addCurrentToSynonym ( TaxonomyVertex* syn );
 		/// remove node from the taxonomy; assume no references to the node
 	void removeNode ( TaxonomyVertex* node ) { node->setInUse(false); }
+		/// remove NODE from the hierarchy, linking its children to its parents directly
+	void unlinkNode ( TaxonomyVertex* node );
+		/// remove ENTRY from the taxonomy; keep the rest of the hierarchy intact
+	void removeEntry ( const ClassifiableEntry* entry );
 		/// insert current node either directly or as a synonym
 	void finishCurrentNode ( void );
 
@@ -82,6 +90,15 @@ public:		// classification interface
 	void deFinalise ( void );
 
 protected:	// methods
+		/// mark NODE and all its ancestors as visited
+	void markAncestors ( TaxonomyVertex* node )
+	{
+		if ( isVisited(node) )
+			return;
+		setVisited(node);
+		for ( TaxonomyVertex::iterator p = node->begin(/*upDirection=*/true), p_end = node->end(/*upDirection=*/true); p != p_end; ++p )
+			markAncestors(*p);
+	}
 		/// apply ACTOR to subgraph starting from NODE as defined by flags
 	template<bool onlyDirect, bool upDirection, class Actor>
 	void getRelativesInfoRec ( TaxonomyVertex* node, Actor& actor )
@@ -102,6 +119,23 @@ protected:	// methods
 		for ( TaxonomyVertex::iterator p = node->begin(upDirection), p_end = node->end(upDirection); p != p_end; ++p )
 			getRelativesInfoRec<onlyDirect, upDirection> ( *p, actor );
 	}
+		/// apply ACTOR to subgraph starting from NODE as defined by flags; keep visited nodes in VISITED
+	template<bool onlyDirect, bool upDirection, class Actor>
+	void getRelativesInfoRec ( TaxonomyVertex* node, Actor& actor, VisitedSet& visited ) const
+	{
+		// recursive applicability checking; label node as visited
+		if ( !visited.insert(node).second )
+			return;
+
+		// if current node processed OK and there is no need to continue -- exit
+		// if node is NOT processed for some reasons -- go to another level
+		if ( actor.apply(*node) && onlyDirect )
+			return;
+
+		// apply method to the proper neighbours with proper parameters
+		for ( TaxonomyVertex::iterator p = node->begin(upDirection), p_end = node->end(upDirection); p != p_end; ++p )
+			getRelativesInfoRec<onlyDirect, upDirection> ( *p, actor, visited );
+	}
 
 public:		// interface
 		/// init c'tor
@@ -151,6 +185,18 @@ public:		// interface
 
 		clearVisited();
 	}
+		/// the same as getRelativesInfo(), but doesn't change the taxonomy, so could be run concurrently
+	template<bool needCurrent, bool onlyDirect, bool upDirection, class Actor>
+	void getRelativesInfoConst ( TaxonomyVertex* node, Actor& actor ) const
+	{
+		if ( needCurrent )
+			if ( actor.apply(*node) && onlyDirect )
+				return;
+
+		VisitedSet visited;
+		for ( TaxonomyVertex::iterator p = node->begin(upDirection), p_end = node->end(upDirection); p != p_end; ++p )
+			getRelativesInfoRec<onlyDirect, upDirection> ( *p, actor, visited );
+	}
 
 	// taxonomy info access
 
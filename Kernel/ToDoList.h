@@ -108,24 +108,32 @@ protected:	// classes
 	class queueQueue
 	{
 	protected:	// types
-			/// type for restore the whole queue
+			/// type for undo an insertion into the middle of the queue
 		class QueueRestorer: public TRestorer
 		{
 		protected:	// members
-				/// copy of a queue
-			growingArray<ToDoEntry> Wait;
 				/// pointer to a queue to restore
 			queueQueue* queue;
 				/// start pointer
 			unsigned int sp;
+				/// position of the inserted entry
+			unsigned int pos;
 
 		public:		// interface
-				/// init c'tor
-			QueueRestorer ( queueQueue* q ) : Wait(q->Wait), queue(q), sp(q->sPointer) {}
+				/// init c'tor: entry is inserted to the position N of the queue Q
+			QueueRestorer ( queueQueue* q, unsigned int n ) : queue(q), sp(q->sPointer), pos(n) {}
 				/// empty d'tor
 			virtual ~QueueRestorer ( void ) {}
-				/// restore: copy the queue back, adjust pointers
-			virtual void restore ( void ) { queue->Wait = Wait; queue->sPointer = sp; }
+				/// restore: remove the inserted entry, adjust pointers
+			virtual void restore ( void )
+			{
+				growingArray<ToDoEntry>& Wait = queue->Wait;
+				unsigned int n = Wait.size()-1;
+				for ( unsigned int i = pos; i < n; ++i )
+					Wait[i] = Wait[i+1];
+				Wait.resize(n);
+				queue->sPointer = sp;
+			}
 		};
 
 	protected:	// members
@@ -154,7 +162,6 @@ protected:	// classes
 			}
 
 			// here we need to put e on the proper place
-			stack->push(new QueueRestorer(this));
 			unsigned int n = Wait.size();
 			Wait.add(e);	// will be rewritten
 			while ( n > sPointer && Wait[n-1].Node->getNominalLevel() > Node->getNominalLevel() )
@@ -163,6 +170,7 @@ protected:	// classes
 				--n;
 			}
 			Wait[n] = e;
+			stack->push(new(*stack) QueueRestorer(this,n));
 		}
 			/// clear queue
 		void clear ( void ) { sPointer = 0; Wait.clear(); }
@@ -124,7 +124,7 @@ DlCompletionGraph :: purgeNode ( DlCompletionTree* p, const DlCompletionTree* ro
 	if ( p->isPBlocked() )
 		return;
 
-	saveRareCond ( p->setPBlocked ( root, dep ) );
+	saveRareCond ( p->setPBlocked ( RareStack, root, dep ) );
 
 	// update successors
 	for ( DlCompletionTree::const_edge_iterator q = p->begin(); q != p->end(); ++q )
@@ -141,6 +141,32 @@ DlCompletionGraph :: purgeEdge ( DlCompletionTreeArc* e, const DlCompletionTree*
 		purgeNode ( e->getArcEnd(), root, dep );	// purge blockable successor
 }
 
+void
+DlCompletionGraph :: trim ( void )
+{
+	// every node but the root has usually a pair of arcs
+	CTEdgeHeap.shrink(2*retainedSize);
+
+	if ( NodeBase.size() <= retainedSize )
+		return;
+
+	// nodes are never in use here, so just delete the ones above the retained size
+	for ( iterator p = NodeBase.begin()+retainedSize, p_end = NodeBase.end(); p != p_end; ++p )
+		delete *p;
+	nodeBaseType ( NodeBase.begin(), NodeBase.begin()+retainedSize ).swap(NodeBase);
+	nodeId = retainedSize;	// keep node IDs equal to their positions in NodeBase
+
+	// the retained nodes might keep large labels as well
+	for ( iterator p = NodeBase.begin(), p_end = NodeBase.end(); p != p_end; ++p )
+		(*p)->release();
+
+	// the rest of the structures are proportional to the graph size
+	nodeBaseType().swap(SavedNodes);
+	std::vector<LabelIndexEntry>().swap(LabelIndex);
+	std::vector<bool>().swap(CGPFlag);
+	RareStack.shrink();
+}
+
 // save/restore
 
 void DlCompletionGraph :: save ( void )
@@ -93,6 +93,23 @@ protected:	// members
 		/// stack for usual saving/restoring
 	TSaveStack<SaveState> Stack;
 
+	// anywhere blocking support
+
+		/// IDs of nodes that got some concept into their label; entries might be out-dated
+	struct LabelIndexEntry
+	{
+			/// IDs of the nodes
+		std::vector<unsigned int> ids;
+			/// true iff IDs are sorted and unique
+		bool sorted;
+			/// empty c'tor
+		LabelIndexEntry ( void ) : sorted(true) {}
+	}; // LabelIndexEntry
+		/// index of nodes by concepts in their labels
+	std::vector<LabelIndexEntry> LabelIndex;
+		/// keys of the non-empty entries of the LabelIndex
+	std::vector<unsigned int> LabelIndexKeys;
+
 	// helpers for the output
 
 		/// bitmap to remember which node was printed
@@ -106,8 +123,19 @@ protected:	// members
 	unsigned int nNodeSaves;
 		/// number of node' saves
 	unsigned int nNodeRestores;
+		/// number of blocking tests
+	unsigned int nBlockingTests;
+		/// number of nodes that became d-blocked
+	unsigned int nBlockedNodes;
 		/// maximal size of the graph
 	unsigned int maxGraphSize;
+		/// maximal number of edges in the graph
+	unsigned int maxEdgesSize;
+
+	// memory policy
+
+		/// number of nodes to keep allocated between tests; 0 means all of them
+	unsigned int retainedSize;
 
 	// flags
 
@@ -136,6 +164,53 @@ protected:	// methods
 		NodeBase.resize(NodeBase.size()*2);
 		initNodeArray ( NodeBase.begin()+NodeBase.size()/2, NodeBase.end() );
 	}
+		/// update the maximal graph size with the current one
+	void updateMaxSize ( void )
+	{
+		if ( maxGraphSize < endUsed )
+			maxGraphSize = endUsed;
+		if ( maxEdgesSize < CTEdgeHeap.size() )
+			maxEdgesSize = CTEdgeHeap.size();
+	}
+		/// release the memory of unused nodes and edges above the retained size
+	void trim ( void );
+		/// @return key of the concept BP in the label index
+	static unsigned int labelIndexKey ( BipolarPointer bp ) { return bp > 0 ? 2*bp : 1-2*bp; }
+		/// remove out-dated IDs from the ENTRY of a concept BP; sort the rest
+	void compactLabelIndexEntry ( LabelIndexEntry& entry, BipolarPointer bp );
+		/// remember that the label of the NODE contains concept BP
+	void addToLabelIndex ( const DlCompletionTree* node, BipolarPointer bp )
+	{
+		unsigned int key = labelIndexKey(bp);
+		if ( key >= LabelIndex.size() )
+			LabelIndex.resize(key+1);
+		LabelIndexEntry& entry = LabelIndex[key];
+		if ( entry.ids.empty() )
+			LabelIndexKeys.push_back(key);
+		else if ( node->getId() <= entry.ids.back() )	// node was reused or got BP again after restore
+			entry.sorted = false;
+		entry.ids.push_back(node->getId());
+		// keep the entry size proportional to the number of nodes in use
+		if ( entry.ids.size() > 2*endUsed+64 )
+			compactLabelIndexEntry ( entry, bp );
+	}
+		/// clear the label index
+	void clearLabelIndex ( void )
+	{
+		for ( std::vector<unsigned int>::iterator p = LabelIndexKeys.begin(), p_end = LabelIndexKeys.end(); p != p_end; ++p )
+		{
+			LabelIndexEntry& entry = LabelIndex[*p];
+			// release memory kept by the large entries
+			if ( entry.ids.capacity() > 1024 )
+				std::vector<unsigned int>().swap(entry.ids);
+			else
+				entry.ids.clear();
+			entry.sorted = true;
+		}
+		LabelIndexKeys.clear();
+	}
+		/// @return sorted IDs of the nodes that might have BP in their labels
+	const std::vector<unsigned int>& getIndexedNodes ( BipolarPointer bp );
 		/// init root node
 	void initRoot ( void )
 	{
@@ -157,7 +232,7 @@ protected:	// methods
 		bool isPredEdge, const DepSet& dep );
 
 		/// invalidate EDGE, save restoring info
-	void invalidateEdge ( DlCompletionTreeArc* edge ) { saveRareCond(edge->save()); }
+	void invalidateEdge ( DlCompletionTreeArc* edge ) { saveRareCond(edge->save(RareStack)); }
 
 	//----------------------------------------------
 	// inequality relation methods
@@ -184,7 +259,7 @@ protected:	// methods
 		saveNode ( node, branchingLevel );
 		node->clearAffected();
 		if ( node->isBlocked() )
-			saveRareCond(node->setUBlocked());
+			saveRareCond(node->setUBlocked(RareStack));
 		if ( useAnywhereBlocking )
 			findDAnywhereBlocker(node);
 		else
@@ -203,7 +278,8 @@ protected:	// methods
 		/// mark NODE as a d-blocked by a BLOCKER
 	void setNodeDBlocked ( DlCompletionTree* node, const DlCompletionTree* blocker )
 	{
-		saveRareCond(node->setDBlocked(blocker));
+		++nBlockedNodes;
+		saveRareCond(node->setDBlocked(RareStack,blocker));
 		propagateIBlockedStatus ( node, node );
 	}
 		/// mark NODE as an i-blocked by a BLOCKER
@@ -222,7 +298,7 @@ protected:	// methods
 		if ( node == blocker )
 			return;
 
-		saveRareCond(node->setIBlocked(blocker));
+		saveRareCond(node->setIBlocked(RareStack,blocker));
 		propagateIBlockedStatus ( node, blocker );
 	}
 		/// propagate i-blocked status to all children of NODE
@@ -269,6 +345,8 @@ public:		// interface
 		, branchingLevel(InitBranchingLevelValue)
 		, IRLevel(initIRLevel)
 		, maxGraphSize(0)
+		, maxEdgesSize(0)
+		, retainedSize(0)
 	{
 		initNodeArray ( NodeBase.begin(), NodeBase.end() );
 		clearStatistics();
@@ -290,6 +368,8 @@ public:		// interface
 		useLazyBlocking = useLB;
 		useAnywhereBlocking = useAB;
 	}
+		/// set the number of nodes to keep allocated between tests; 0 means no limit
+	void setRetainedSize ( unsigned int n ) { retainedSize = n; }
 		/// set blocking method for a session
 	void setBlockingMethod ( bool hasInverse, bool hasQCR )
 	{
@@ -300,6 +380,8 @@ public:		// interface
 	void addConceptToNode ( DlCompletionTree* node, const ConceptWDep& c, DagTag tag )
 	{
 		node->addConcept(c,tag);
+		if ( useAnywhereBlocking )
+			addToLabelIndex ( node, c.bp() );
 
 		if ( useLazyBlocking )
 			node->setAffected();
@@ -394,12 +476,14 @@ public:		// interface
 	{
 		nNodeSaves = 0;
 		nNodeRestores = 0;
-		if ( maxGraphSize < endUsed )
-			maxGraphSize = endUsed;
+		nBlockingTests = 0;
+		nBlockedNodes = 0;
+		updateMaxSize();
 	}
-		/// mark all heap elements as unused
+		/// mark all heap elements as unused; release the memory above the retained size
 	void clear ( void )
 	{
+		updateMaxSize();
 		CTEdgeHeap.clear();
 		endUsed = 0;
 		branchingLevel = InitBranchingLevelValue;
@@ -407,10 +491,19 @@ public:		// interface
 		RareStack.clear();
 		Stack.clear();
 		SavedNodes.clear();
+		clearLabelIndex();
+		if ( retainedSize > 0 )
+			trim();
 		initRoot();
 	}
 		/// get number of nodes in the CGraph
 	size_t maxSize ( void ) const { return maxGraphSize; }
+		/// get number of edges in the CGraph
+	size_t maxEdges ( void ) const { return maxEdgesSize; }
+		/// get number of nodes allocated by the CGraph
+	size_t allocatedSize ( void ) const { return NodeBase.size(); }
+		/// get number of edges allocated by the CGraph
+	size_t allocatedEdges ( void ) const { return CTEdgeHeap.capacity(); }
 
 		/// save rarely appeared info if P is non-NULL
 	void saveRareCond ( TRestorer* p ) { if (p) RareStack.push(p); }
@@ -434,7 +527,7 @@ public:		// interface
 		if ( ret == NULL )
 			ret = createEdge ( from, to, isPredEdge, R, dep );
 		else
-			saveRareCond(ret->addDep(dep));
+			saveRareCond(ret->addDep(RareStack,dep));
 
 		return ret;
 	}
@@ -512,6 +605,10 @@ public:		// interface
 	unsigned int getNNodeSaves ( void ) const { return nNodeSaves; }
 		/// get number of nodes restored during session
 	unsigned int getNNodeRestores ( void ) const { return nNodeRestores; }
+		/// get number of blocking tests made during session
+	unsigned int getNBlockingTests ( void ) const { return nBlockingTests; }
+		/// get number of nodes d-blocked during session
+	unsigned int getNBlockedNodes ( void ) const { return nBlockedNodes; }
 
 	// print
 
@@ -531,7 +628,7 @@ DlCompletionGraph :: nonMergable ( const DlCompletionTree* p, const DlCompletion
 inline void
 DlCompletionGraph :: updateIR ( DlCompletionTree* p, const DlCompletionTree* q, const DepSet& toAdd )
 {
-	saveRareCond ( p->updateIR ( q, toAdd ) );
+	saveRareCond ( p->updateIR ( RareStack, q, toAdd ) );
 }
 
 inline void
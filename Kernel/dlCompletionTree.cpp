@@ -131,13 +131,13 @@ bool DlCompletionTree :: nonMergable ( const DlCompletionTree* node, DepSet& dep
 }
 
 /// update IR of the current node with IR from NODE and additional clash-set; @return restorer
-TRestorer* DlCompletionTree :: updateIR ( const DlCompletionTree* node, const DepSet& toAdd )
+TRestorer* DlCompletionTree :: updateIR ( TRareSaveStack& stack, const DlCompletionTree* node, const DepSet& toAdd )
 {
 	if ( node->IR.empty() )
 		return NULL;	// nothing to do
 
 	// save current state
-	TRestorer* ret = new IRRestorer(this);
+	TRestorer* ret = new(stack) IRRestorer(this);
 
 	// copy all elements from NODE's IR to current node.
 	// FIXME!! do not check if some of them are already in there
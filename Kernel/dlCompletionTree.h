@@ -25,7 +25,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "globaldef.h"
 #include "dlCompletionTreeArc.h"
 #include "tSaveList.h"
-#include "tRestorer.h"
+#include "tRareSaveStack.h"
 #include "CGLabel.h"
 #include "logging.h"
 
@@ -332,6 +332,8 @@ protected:	// methods
 public:		// methods
 		/// init newly created node with starting LEVEL
 	void init ( unsigned int level );
+		/// release all the memory kept by the node; it should be init()-ed before the next use
+	void release ( void );
 		/// c'tor: create an empty node
 	DlCompletionTree ( unsigned int newId ) : id(newId) {}
 		/// d'tor: delete node
@@ -344,12 +346,12 @@ public:		// methods
 	unsigned int getId ( void ) const { return id; }
 		/// check if the node is cached (IE need not to be expanded)
 	bool isCached ( void ) const { return cached; }
-		/// set cached status of given node
-	TRestorer* setCached ( bool val )
+		/// set cached status of given node; restorer is allocated in STACK
+	TRestorer* setCached ( TRareSaveStack& stack, bool val )
 	{
 		if ( cached == val )
 			return NULL;
-		TRestorer* ret = new CacheRestorer(this);
+		TRestorer* ret = new(stack) CacheRestorer(this);
 		cached = val;
 		return ret;
 	}
@@ -537,10 +539,10 @@ public:		// methods
 	// re-building blocking hierarchy
 	//----------------------------------------------
 
-		/// set node blocked
-	TRestorer* setBlocked ( const DlCompletionTree* blocker, bool permanently, bool directly )
+		/// set node blocked; restorer is allocated in STACK
+	TRestorer* setBlocked ( TRareSaveStack& stack, const DlCompletionTree* blocker, bool permanently, bool directly )
 	{
-		TRestorer* ret = new UnBlock(this);
+		TRestorer* ret = new(stack) UnBlock(this);
 		Blocker = blocker;
 		pBlocked = permanently;
 		dBlocked = directly;
@@ -548,15 +550,15 @@ public:		// methods
 		return ret;
 	}
 		/// mark node d-blocked
-	TRestorer* setDBlocked ( const DlCompletionTree* blocker ) { return setBlocked ( blocker, false, true ); }
+	TRestorer* setDBlocked ( TRareSaveStack& stack, const DlCompletionTree* blocker ) { return setBlocked ( stack, blocker, false, true ); }
 		/// mark node i-blocked
-	TRestorer* setIBlocked ( const DlCompletionTree* blocker ) { return setBlocked ( blocker, false, false ); }
+	TRestorer* setIBlocked ( TRareSaveStack& stack, const DlCompletionTree* blocker ) { return setBlocked ( stack, blocker, false, false ); }
 		/// mark node unblocked
-	TRestorer* setUBlocked ( void ) { return setBlocked ( NULL, true, true ); }
+	TRestorer* setUBlocked ( TRareSaveStack& stack ) { return setBlocked ( stack, NULL, true, true ); }
 		/// mark node purged
-	TRestorer* setPBlocked ( const DlCompletionTree* blocker, const DepSet& dep )
+	TRestorer* setPBlocked ( TRareSaveStack& stack, const DlCompletionTree* blocker, const DepSet& dep )
 	{
-		TRestorer* ret = new UnBlock(this);
+		TRestorer* ret = new(stack) UnBlock(this);
 		Blocker = blocker;
 		if ( isNominalNode() )
 			pDep = dep;
@@ -599,7 +601,7 @@ public:		// methods
 		/// check if the current node is in IR with NODE; if so, write the clash-set to DEP
 	bool nonMergable ( const DlCompletionTree* node, DepSet& dep ) const;
 		/// update IR of the current node with IR from NODE and additional dep-set; @return restorer
-	TRestorer* updateIR ( const DlCompletionTree* node, const DepSet& toAdd );
+	TRestorer* updateIR ( TRareSaveStack& stack, const DlCompletionTree* node, const DepSet& toAdd );
 #endif
 
 	//----------------------------------------------
@@ -660,4 +662,14 @@ inline void DlCompletionTree :: init ( unsigned int level )
 	pDep.clear();
 }
 
+inline void DlCompletionTree :: release ( void )
+{
+	Label.release();
+	saves.clear();
+#ifdef RKG_IR_IN_NODE_LABEL
+	IR.release();
+#endif
+	ArcCollection().swap(Neighbour);
+}
+
 #endif // DLCOMPLETIONTREE_H
@@ -25,7 +25,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "DeletelessAllocator.h"
 #include "DepSet.h"
 #include "tRole.h"
-#include "tRestorer.h"
+#include "tRareSaveStack.h"
 
 //#include "SmallObj.h"
 
@@ -146,24 +146,24 @@ public:		// interface
 	// saving/restoring
 	//----------------------------------------------
 
-		/// save and invalidate arc (together with reverse arc)
-	TRestorer* save ( void )
+		/// save and invalidate arc (together with reverse arc); restorer is allocated in STACK
+	TRestorer* save ( TRareSaveStack& stack )
 	{
 		if ( Role == NULL )	// don't invalidate edge twice
 			return NULL;
 
-		TRestorer* ret = new TCTEdgeRestorer(this);
+		TRestorer* ret = new(stack) TCTEdgeRestorer(this);
 		Role = NULL;
 		Reverse->Role = NULL;
 		return ret;
 	}
 
-		/// add dep-set to an edge; return restorer
-	TRestorer* addDep ( const DepSet& dep )
+		/// add dep-set to an edge; return restorer allocated in STACK
+	TRestorer* addDep ( TRareSaveStack& stack, const DepSet& dep )
 	{
 		if ( dep.empty() )
 			return NULL;
-		TRestorer* ret = new TCTEdgeDepRestorer(this);
+		TRestorer* ret = new(stack) TCTEdgeDepRestorer(this);
 		depSet.add(dep);
 		return ret;
 	}
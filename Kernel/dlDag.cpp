@@ -22,24 +22,28 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "tDataEntry.h"
 #include "tConcept.h"
 
+const double DLDag :: minFailRateDiff = 0.2;
+
 DLDag :: DLDag ( const ifOptionSet* Options )
 	: indexAnd(*this)
 	, indexAll(*this)
 	, indexLE(*this)
 	, finalDagSize(0)
 	, nCacheHits(0)
+	, useFailRate(false)
 	, useDLVCache(true)
 {
-	Heap.push_back ( new DLVertex (dtBad) );	// empty vertex -- bpINVALID
-	Heap.push_back ( new DLVertex (dtTop) );
+	Heap.push_back ( new(*this) DLVertex (dtBad) );	// empty vertex -- bpINVALID
+	Heap.push_back ( new(*this) DLVertex (dtTop) );
 
 	readConfig ( Options );
 }
 
 DLDag :: ~DLDag ( void )
 {
+	// the memory would be freed by the arena
 	for ( HeapType::iterator p = Heap.begin(), p_end = Heap.end(); p < p_end; ++p )
-		delete *p;
+		(*p)->~DLVertex();
 }
 
 void
@@ -59,9 +63,14 @@ DLDag :: removeQuery ( void )
 		default:
 			break;
 		}
-		delete v;
+		removeFromIndex ( v->Type(), i );
+		deleteVertex(v);
 	}
 	Heap.resize(finalDagSize);
+	// ANDs are listed in the order of their positions
+	while ( !listAnds.empty() && listAnds.back() >= finalDagSize )
+		listAnds.pop_back();
+	Arena.rollbackChildren(finalChildMark);
 }
 
 void DLDag :: readConfig ( const ifOptionSet* Options )
@@ -285,6 +294,18 @@ bool DLDag :: less ( BipolarPointer p1, BipolarPointer p2 ) const
 
 	const DLVertex& v1 = (*this)[p1];
 	const DLVertex& v2 = (*this)[p2];
+
+	// try first the alternative that fails less often; note that p1 and p2 are negated alternatives
+	// the rates are used only if both are reliable and differ significantly; otherwise the static order is in use
+	if ( useFailRate && v1.getChoices(isNegative(p1)) >= minFailRateChoices && v2.getChoices(isNegative(p2)) >= minFailRateChoices )
+	{
+		double rate1 = v1.getFailRate(isNegative(p1));
+		double rate2 = v2.getFailRate(isNegative(p2));
+		if ( rate1 + minFailRateDiff < rate2 )
+			return true;
+		if ( rate2 + minFailRateDiff < rate1 )
+			return false;
+	}
 /*
 	// prefer non-cyclical
 	if ( !v1.isInCycle(false) && v2.isInCycle(false) )
@@ -25,6 +25,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "globaldef.h"	// for statistic printed
 #include "fpp_assert.h"
 #include "dlVertex.h"
+#include "dlVertexArena.h"
 #include "dlVHash.h"
 #include "ifOptions.h"
 #include "tRole.h"
@@ -44,6 +45,8 @@ public:		// types
 	typedef dlVHashTable HashTable;
 
 protected:	// members
+		/// memory for the vertices and their children
+	DLVertexArena Arena;
 		/// body of DAG
 	HeapType Heap;
 		/// all the AND nodes (needs to recompute)
@@ -53,6 +56,8 @@ protected:	// members
 
 		/// DAG size after the whole ontology is loaded
 	size_t finalDagSize;
+		/// position in the children pool after the whole ontology is loaded
+	DLVertexArena::ChildMark finalChildMark;
 		/// cache efficiency -- statistic purposes
 	unsigned int nCacheHits;
 
@@ -72,10 +77,17 @@ protected:	// members
 	bool sortAscend;
 		/// prefer non-generating rules in OR orderings
 	bool preferNonGen;
+		/// order OR alternatives by their failure rate first
+	bool useFailRate;
 
 		/// flag whether cache should be used
 	bool useDLVCache;
 
+		/// min number of choices of an OR alternative to use its failure rate
+	static const DLVertexBranchStat::BranchType minFailRateChoices = 32;
+		/// min difference of failure rates that changes the order of OR alternatives
+	static const double minFailRateDiff;
+
 private:	// no copy
 		/// no copy c'tor
 	DLDag ( const DLDag& );
@@ -161,6 +173,18 @@ protected:	// methods
 		default:		break;	// nothing to do
 		}
 	}
+		/// remove VALUE from the index corresponding to DLVertex's tag
+	void removeFromIndex ( DagTag tag, BipolarPointer value )
+	{
+		switch(tag)
+		{
+		case dtAnd:		indexAnd.removeElement(value); break;
+		case dtIrr:
+		case dtForall:	indexAll.removeElement(value); break;
+		case dtLE:		indexLE.removeElement(value); break;
+		default:		break;	// nothing to do
+		}
+	}
 
 #ifdef RKG_USE_SORTED_REASONING
 	// internal sort interface
@@ -184,11 +208,24 @@ public:		// interface
 
 	// construction methods
 
+		/// get memory for a new vertex; use new(dag) DLVertex(...) instead
+	void* allocVertex ( void ) { return Arena.allocVertex(); }
+		/// return memory of the destroyed vertex P to the arena
+	void freeVertex ( void* p ) { Arena.freeVertex(p); }
+		/// destroy vertex V that was created by new(dag) and not added to DAG
+	void deleteVertex ( DLVertex* v )
+	{
+		v->~DLVertex();
+		freeVertex(v);
+	}
 		/// get index of given vertex; include vertex to DAG if necessary
 	BipolarPointer add ( DLVertex* v );
 		/// add vertex to the end of DAG and calculate it's statistic if necessary
 	BipolarPointer directAdd ( DLVertex* v )
 	{
+		// keep children in the flat pool
+		if ( v->nArgs() != 0 )
+			v->moveChildren(Arena.allocChildren(v->nArgs()));
 		Heap.push_back(v);
 		// return an index of just added entry
 		return Heap.size()-1;
@@ -236,7 +273,7 @@ public:		// interface
 		/// replace existing vertex at index I with a vertex V
 	void replaceVertex ( BipolarPointer i, DLVertex* v, TNamedEntry* C )
 	{
-		delete Heap[getValue(i)];
+		deleteVertex(Heap[getValue(i)]);
 		Heap[getValue(i)] = v;
 		v->setConcept(C);
 	}
@@ -246,7 +283,12 @@ public:		// interface
 		/// get approximation of the size after query is added
 	size_t maxSize ( void ) const { return size() + ( size() < 220 ? 10 : size()/20 ); }
 		/// set the final DAG size
-	void setFinalSize ( void ) { finalDagSize = size(); setExpressionCache(false); }
+	void setFinalSize ( void )
+	{
+		finalDagSize = size();
+		finalChildMark = Arena.getChildMark();
+		setExpressionCache(false);
+	}
 		/// resize DAG to its original size (to clear intermediate query)
 	void removeQuery ( void );
 
@@ -260,6 +302,10 @@ public:		// interface
 	void setSatOrder ( void ) { setOrderOptions(orSortSat); }
 		/// gather statistics necessary for the OR ordering
 	void gatherStatistic ( void );
+		/// set whether the failure rates of OR alternatives are used in OR ordering
+	void setFailRateOrder ( bool value ) { useFailRate = value; }
+		/// re-sort OR vertices wrt the updated failure rates
+	void updateFailRateOrder ( void ) { if ( useFailRate ) Recompute(); }
 
 	// cache interface
 
@@ -307,6 +353,11 @@ public:		// interface
 	bool haveSameSort ( unsigned int p, unsigned int q ) { return true; }
 #endif
 
+	// statistic
+
+		/// @return number of cache hits during the DAG construction
+	unsigned int getNCacheHits ( void ) const { return nCacheHits; }
+
 	// output interface
 
 		/// print DAG size and number of cache hits, together with DAG usage
@@ -345,8 +396,23 @@ DLDag :: add ( DLVertex* v )
 
 	// node was found in cache
 	++nCacheHits;
-	delete v;
+	deleteVertex(v);
 	return ret;
 }
 
+inline void*
+DLVertex :: operator new ( size_t size ATTR_UNUSED, DLDag& dag )
+{
+#ifdef ENABLE_CHECKING
+	fpp_assert ( size == sizeof(DLVertex) );
+#endif
+	return dag.allocVertex();
+}
+
+inline void
+DLVertex :: operator delete ( void* p, DLDag& dag )
+{
+	dag.freeVertex(p);
+}
+
 #endif
@@ -0,0 +1,232 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <algorithm>
+
+#include "dlDagHash.h"
+#include "tRole.h"
+
+dlDagHash :: dlDagHash ( const DLDag& dag )
+	: Dag(dag)
+	, Shallow(dag.size(),1)
+	, Deep(dag.size(),1)
+	, Number(dag.size(),0)
+	, LowLink(dag.size(),0)
+	, onStack(dag.size(),false)
+	, nVisited(0)
+	, Mark(dag.size(),0)
+	, curMark(0)
+{
+	// invalid entry has no hash
+	Shallow[0] = Deep[0] = 0;
+
+	// deep hashes of the names are determined by the SCCs of the name dependency graph
+	for ( unsigned int i = 1; i < dag.size(); ++i )
+		if ( isCNameTag(dag[i].Type()) && Number[i] == 0 )
+			buildSCC(i);
+
+	// all the other entries are hashed via their arguments
+	for ( unsigned int i = 1; i < dag.size(); ++i )
+		getDeep(i);
+}
+
+dlDagHash::HashValue
+dlDagHash :: headHash ( const DLVertex& v )
+{
+	HashValue h = mix(v.Type()+1);
+	if ( v.getRole() != NULL )
+		h = combine ( combine ( h, v.getRole()->isDataRole() ), hashString(v.getRole()->getName()) );
+	if ( v.getProjRole() != NULL )
+		h = combine ( h, hashString(v.getProjRole()->getName()) );
+	// number restriction or the automaton state
+	h = combine ( h, v.getNumberLE() );
+	if ( isNameEntry(v.Type()) )
+		h = combine ( h, hashString(v.getConcept()->getName()) );
+	return h;
+}
+
+dlDagHash::HashValue
+dlDagHash :: argHash ( const DLVertex& v, HashValue h, bool deep )
+{
+	switch ( v.Type() )
+	{
+	case dtAnd:
+	case dtSplitConcept:
+	{
+		// arguments of AND are re-sorted during reasoning, so their order is ignored
+		HashValue sum = 0;
+		for ( DLVertex::const_iterator p = v.begin(), p_end = v.end(); p < p_end; ++p )
+		{
+			HashValue arg = ref ( *p, deep ? getDeep(getValue(*p)) : getShallow(getValue(*p)) );
+			if ( arg == 0 )
+				return 0;
+			sum = addToSet ( sum, arg );
+		}
+		return valid(combine(h,sum));
+	}
+
+	case dtForall:
+	case dtLE:
+	case dtProj:
+	case dtChoose:
+	{
+		HashValue arg = ref ( v.getC(), deep ? getDeep(getValue(v.getC())) : getShallow(getValue(v.getC())) );
+		return arg == 0 ? 0 : valid(combine(h,arg));
+	}
+
+	default:	// no arguments
+		return valid(h);
+	}
+}
+
+dlDagHash::HashValue
+dlDagHash :: getShallow ( unsigned int i )
+{
+	if ( Shallow[i] != 1 )
+		return Shallow[i];
+
+	const DLVertex& v = Dag[i];
+	HashValue h;
+	if ( v.Type() == dtDataExpr )	// facets are not named, so there is no stable hash
+		h = 0;
+	else if ( isNameEntry(v.Type()) )
+		h = valid(headHash(v));
+	else	// non-name entries are acyclic
+		h = argHash ( v, headHash(v), /*deep=*/false );
+
+	return Shallow[i] = h;
+}
+
+dlDagHash::HashValue
+dlDagHash :: getDeep ( unsigned int i )
+{
+	if ( Deep[i] != 1 )
+		return Deep[i];
+
+	const DLVertex& v = Dag[i];
+	// all names are hashed already, so it is either data or a complex expression
+	fpp_assert ( !isCNameTag(v.Type()) );
+	HashValue h;
+	if ( isNameEntry(v.Type()) || v.Type() == dtDataExpr )
+		h = getShallow(i);
+	else
+		h = argHash ( v, headHash(v), /*deep=*/true );
+
+	return Deep[i] = h;
+}
+
+void
+dlDagHash :: collectNames ( BipolarPointer p, IndexVector& names )
+{
+	unsigned int i = getValue(p);
+	if ( Mark[i] == curMark )
+		return;
+	Mark[i] = curMark;
+
+	const DLVertex& v = Dag[i];
+	if ( isCNameTag(v.Type()) )
+	{
+		names.push_back(i);
+		return;
+	}
+
+	switch ( v.Type() )
+	{
+	case dtAnd:
+	case dtSplitConcept:
+		for ( DLVertex::const_iterator q = v.begin(), q_end = v.end(); q < q_end; ++q )
+			collectNames ( *q, names );
+		break;
+
+	case dtForall:
+	case dtLE:
+	case dtProj:
+	case dtChoose:
+		collectNames ( v.getC(), names );
+		break;
+
+	default:	// no arguments
+		break;
+	}
+}
+
+void
+dlDagHash :: buildSCC ( unsigned int i )
+{
+	Number[i] = LowLink[i] = ++nVisited;
+	Stack.push_back(i);
+	onStack[i] = true;
+
+	// names the definition of I depends on
+	IndexVector deps;
+	++curMark;
+	if ( isValid(Dag[i].getC()) )
+		collectNames ( Dag[i].getC(), deps );
+
+	for ( IndexVector::const_iterator p = deps.begin(), p_end = deps.end(); p != p_end; ++p )
+		if ( Number[*p] == 0 )
+		{
+			buildSCC(*p);
+			LowLink[i] = std::min ( LowLink[i], LowLink[*p] );
+		}
+		else if ( onStack[*p] )
+			LowLink[i] = std::min ( LowLink[i], Number[*p] );
+
+	if ( LowLink[i] == Number[i] )
+		hashSCC(i);
+}
+
+void
+dlDagHash :: hashSCC ( unsigned int i )
+{
+	// get all the names of the SCC; they are kept on the stack to detect the inner references
+	IndexVector SCC;
+	do
+	{
+		SCC.push_back(Stack.back());
+		Stack.pop_back();
+	} while ( SCC.back() != i );
+
+	// the names together with their definitions, and all the names the SCC depends on
+	HashValue inner = 0, outer = 0;
+	bool stable = true;
+	IndexVector deps;
+	++curMark;
+	for ( IndexVector::const_iterator p = SCC.begin(), p_end = SCC.end(); p != p_end; ++p )
+	{
+		BipolarPointer body = Dag[*p].getC();
+		HashValue def = isValid(body) ? ref ( body, getShallow(getValue(body)) ) : 1;
+		stable &= def != 0;
+		inner = addToSet ( inner, combine ( getShallow(*p), def ) );
+		if ( isValid(body) )
+			collectNames ( body, deps );
+	}
+	for ( IndexVector::const_iterator p = deps.begin(), p_end = deps.end(); p != p_end; ++p )
+		if ( !onStack[*p] )	// outer SCC; it is processed already
+		{
+			stable &= Deep[*p] != 0;
+			outer = addToSet ( outer, Deep[*p] );
+		}
+
+	HashValue h = combine ( combine ( inner, outer ), SCC.size() );
+	for ( IndexVector::const_iterator p = SCC.begin(), p_end = SCC.end(); p != p_end; ++p )
+	{
+		Deep[*p] = stable ? valid(combine(getShallow(*p),h)) : 0;
+		onStack[*p] = false;
+	}
+}
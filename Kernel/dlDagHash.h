@@ -0,0 +1,130 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef DLDAGHASH_H
+#define DLDAGHASH_H
+
+#include <vector>
+
+#include "dlDag.h"
+
+/**
+ * Stable hashes of DAG entries. The hash doesn't depend on the positions of
+ * the entries in the DAG, so the same expression gets the same hash in every
+ * session. Named entries are hashed together with the (possibly cyclic)
+ * definitions of all the names they depend on, so the hash changes if any
+ * of them is changed. Entries that depend on data expressions have no hash.
+ */
+class dlDagHash
+{
+public:		// types
+		/// type of the hash value; 0 means "no stable hash"
+	typedef unsigned long long HashValue;
+
+protected:	// types
+		/// vector of hash values
+	typedef std::vector<HashValue> HashVector;
+		/// vector of DAG indices
+	typedef std::vector<unsigned int> IndexVector;
+
+protected:	// members
+		/// DAG to hash
+	const DLDag& Dag;
+		/// structural hashes, where names are represented by themselves; 1 means "not yet computed"
+	HashVector Shallow;
+		/// hashes that take definitions of the names into account; 1 means "not yet computed"
+	HashVector Deep;
+
+	// SCC computation over the name dependency graph
+
+		/// DFS number of a name; 0 means "not yet visited"
+	IndexVector Number;
+		/// smallest DFS number reachable from a name
+	IndexVector LowLink;
+		/// stack of the names of the SCCs being built
+	IndexVector Stack;
+		/// flags whether the name is on the stack
+	std::vector<bool> onStack;
+		/// last used DFS number
+	unsigned int nVisited;
+		/// mark of the current walk via the non-name entries
+	IndexVector Mark;
+		/// current value of the mark
+	unsigned int curMark;
+
+protected:	// methods
+		/// mix the bits of a hash value H
+	static HashValue mix ( HashValue h )
+	{
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ULL;
+		h ^= h >> 33;
+		return h;
+	}
+		/// add value V to the hash SEED
+	static HashValue combine ( HashValue seed, HashValue v ) { return mix ( seed ^ ( v + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2) ) ); }
+		/// @return hash of the string STR
+	static HashValue hashString ( const char* str )
+	{
+		HashValue h = 0xcbf29ce484222325ULL;
+		for ( ; *str; ++str )
+			h = ( h ^ static_cast<unsigned char>(*str) ) * 0x100000001b3ULL;
+		return h;
+	}
+		/// make sure that the hash H of an existing entry is neither 0 nor 1
+	static HashValue valid ( HashValue h ) { return h < 2 ? h+2 : h; }
+		/// @return hash of a reference to P given the hash H of the entry
+	static HashValue ref ( BipolarPointer p, HashValue h ) { return h == 0 ? 0 : valid(combine(h,isPositive(p))); }
+
+		/// @return true iff an entry with the tag TAG is represented by its name
+	static bool isNameEntry ( DagTag tag ) { return isCNameTag(tag) || tag == dtDataType || tag == dtDataValue; }
+		/// @return hash of the entry V without its arguments
+	static HashValue headHash ( const DLVertex& v );
+		/// @return hash H of the entry V updated with the (DEEP or shallow) hashes of its arguments
+	HashValue argHash ( const DLVertex& v, HashValue h, bool deep );
+		/// @return hash of the I-th entry where names are represented by themselves
+	HashValue getShallow ( unsigned int i );
+		/// @return hash of the I-th entry wrt definitions of names
+	HashValue getDeep ( unsigned int i );
+
+		/// add all the names the entry P depends on directly to NAMES
+	void collectNames ( BipolarPointer p, IndexVector& names );
+		/// build the SCC of the names starting from the name I; set Deep for all the names in it
+	void buildSCC ( unsigned int i );
+		/// set deep hash of all the names in the SCC on the top of the stack with the root I
+	void hashSCC ( unsigned int i );
+
+public:		// interface
+		/// init c'tor: compute hashes of all the entries of the DAG
+	explicit dlDagHash ( const DLDag& dag );
+		/// empty d'tor
+	~dlDagHash ( void ) {}
+
+		/// @return stable hash of the DAG entry P; 0 if there is no stable hash
+	HashValue get ( BipolarPointer p ) const { return isValid(p) ? ref ( p, Deep[getValue(p)] ) : 0; }
+		/// @return hash of the string STR
+	static HashValue get ( const char* str ) { return valid(hashString(str)); }
+		/// @return the hash H updated with the value V
+	static HashValue add ( HashValue h, HashValue v ) { return valid(combine(h,v)); }
+		/// @return the hash of an unordered set H updated with the value V
+	static HashValue addToSet ( HashValue h, HashValue v ) { return h + mix(v); }
+}; // dlDagHash
+
+#endif
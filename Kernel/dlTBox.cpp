@@ -24,6 +24,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "globaldef.h"
 #include "ReasonerNom.h"
+#include "ReasonerPool.h"
+#include "RoleAssertionIndex.h"
+#include "ABoxPartition.h"
 #include "DLConceptTaxonomy.h"
 #include "procTimer.h"
 #include "dumpLisp.h"
@@ -36,6 +39,9 @@ TBox :: TBox ( const ifOptionSet* Options, const std::string& TopORoleName, cons
 	: DLHeap(Options)
 	, stdReasoner(NULL)
 	, nomReasoner(NULL)
+	, pReasonerPool(NULL)
+	, pRAIndex(NULL)
+	, pABoxPartition(NULL)
 	, pMonitor(NULL)
 	, pTax(NULL)
 	, pTaxCreator(NULL)
@@ -51,10 +57,14 @@ TBox :: TBox ( const ifOptionSet* Options, const std::string& TopORoleName, cons
 	, Axioms(*this)
 	, Splits(NULL)
 	, T_G(bpTOP)	// initialise GCA's concept with Top
+	, RCCache(65536)	// evicted entries only lead to extra aux concepts
 	, nC(0)
 	, nR(0)
 	, auxConceptID(0)
 	, testTimeout(0)
+	, nThreads(1)
+	, retainedGraphSize(0)
+	, nAdaptiveTests(0)
 	, useNodeCache(true)
 	, duringClassification(false)
 	, useSortedReasoning(true)
@@ -63,6 +73,7 @@ TBox :: TBox ( const ifOptionSet* Options, const std::string& TopORoleName, cons
 	, Consistent(true)
 	, preprocTime(0)
 	, consistTime(0)
+	, classifyTime(0)
 {
 	readConfig ( Options );
 	initTopBottom ();
@@ -80,10 +91,6 @@ TBox :: ~TBox ( void )
 	for ( TSimpleRules::iterator q = SimpleRules.begin(), q_end = SimpleRules.end(); q < q_end; ++q )
 		delete *q;
 
-	// empty R-C cache
-	for ( TRCCache::iterator r = RCCache.begin(), r_end = RCCache.end(); r < r_end; ++r )
-		deleteTree(r->first);
-
 	// remove all concepts
 	delete pTop;
 	delete pBottom;
@@ -91,6 +98,9 @@ TBox :: ~TBox ( void )
 	delete pQuery;
 
 	// remove aux structures
+	delete pReasonerPool;
+	delete pRAIndex;
+	delete pABoxPartition;
 	delete stdReasoner;
 	delete nomReasoner;
 	delete pTax;
@@ -196,20 +206,50 @@ void TBox :: prepareReasoning ( void )
 	DLHeap.setSatOrder();
 }
 
-/// prepare features for SAT(P), or SUB(P,Q) test
-void TBox :: prepareFeatures ( const TConcept* pConcept, const TConcept* qConcept )
+/// fill features LF for SAT(P), or SUB(P,Q) test
+void TBox :: fillQueryFeatures ( LogicFeatures& lf, const TConcept* pConcept, const TConcept* qConcept ) const
 {
-	auxFeatures = GCIFeatures;
+	lf = GCIFeatures;
 	if ( pConcept != NULL )
-		updateAuxFeatures(pConcept->posFeatures);
+		updateFeatures ( lf, pConcept->posFeatures );
 	if ( qConcept != NULL )
-		updateAuxFeatures(qConcept->negFeatures);
-	if ( auxFeatures.hasSingletons() )
-		updateAuxFeatures(NCFeatures);
+		updateFeatures ( lf, qConcept->negFeatures );
+	if ( lf.hasSingletons() )
+		updateFeatures ( lf, NCFeatures );
+}
+
+/// prepare features for SAT(P), or SUB(P,Q) test
+void TBox :: prepareFeatures ( const TConcept* pConcept, const TConcept* qConcept )
+{
+	fillQueryFeatures ( auxFeatures, pConcept, qConcept );
 	curFeature = &auxFeatures;
 
+	// nominal reasoner could use only a part of the ABox
+	if ( curFeature->hasSingletons() && nomReasoner != NULL )
+		static_cast<NominalReasoner*>(nomReasoner)->setSessionScope ( pConcept, qConcept );
+
 	// set blocking method for the current reasoning session
 	getReasoner()->setBlockingMethod ( isIRinQuery(), isNRinQuery() );
+
+	if ( useAdaptiveOrder )
+		adaptReasoningOrder();
+}
+
+void
+TBox :: adaptReasoningOrder ( void )
+{
+	// statistic changes slowly, so re-order after 2^k-th tests only; stop when it is stable enough
+	++nAdaptiveTests;
+	if ( nAdaptiveTests < 16 || nAdaptiveTests > 65536 || ( nAdaptiveTests & (nAdaptiveTests-1) ) != 0 )
+		return;
+
+	DLHeap.updateFailRateOrder();
+
+	unsigned long applied[ToDoPriorMatrix::opLast] = { 0 }, clashes[ToDoPriorMatrix::opLast] = { 0 };
+	stdReasoner->addOperationStat ( applied, clashes );
+	if ( nomReasoner )
+		nomReasoner->addOperationStat ( applied, clashes );
+	PriorityMatrix.adaptPriorities ( applied, clashes );
 }
 
 void
@@ -259,6 +299,8 @@ TBox :: performConsistencyCheck ( void )
 		// make a cache for TOP if it is not there
 		if ( DLHeap.getCache(bpTOP) == NULL )
 			initConstCache(bpTOP);
+		// independent parts of the ABox are checked separately
+		buildABoxPartition();
 
 		ret = static_cast<NominalReasoner*>(nomReasoner)->consistentNominalCloud();
 	}
@@ -371,11 +413,114 @@ bool TBox :: isSameIndividuals ( const TIndividual* a, const TIndividual* b )
 		return true;
 	if ( !isIndividual(a) || !isIndividual(b) )
 		throw EFaCTPlusPlus("Individuals are expected in the isSameIndividuals() query");
-	if ( a->node == NULL || b->node == NULL )	// fresh individuals couldn't be the same
+	if ( a->getTaxVertex() == NULL || b->getTaxVertex() == NULL )	// fresh individuals couldn't be the same
 		return false;
 	return a->getTaxVertex() == b->getTaxVertex();
 }
 
+/// make the completion graph nodes of all the individuals available to the queries that read them
+void
+TBox :: initIndividualNodes ( void )
+{
+	// only a nominal cloud of the whole ABox has nodes for all the individuals
+	if ( nomReasoner != NULL && pABoxPartition != NULL )
+		static_cast<NominalReasoner*>(nomReasoner)->initWholeABoxCloud();
+}
+
+/// build the index of role assertions between individuals
+void
+TBox :: buildRoleAssertionIndex ( void )
+{
+	delete pRAIndex;
+	pRAIndex = new RoleAssertionIndex();
+
+	// individuals could be merged by nominals and synonyms
+	bool canMerge = nNominalReferences > 0 || !SameI.empty();
+	for ( i_iterator pi = i_begin(); pi != i_end(); ++pi )
+	{
+		canMerge |= (*pi)->isSynonym();
+		pRAIndex->addIndividual(*pi);
+	}
+
+	for ( RoleMaster::iterator r = ORM.begin(), r_end = ORM.end(); r < r_end; ++r )
+		if ( !(*r)->isSynonym() )
+			pRAIndex->addRole(*r);
+
+	// number restrictions could merge individuals; self-restrictions add new edges
+	for ( BipolarPointer i = 2; i < static_cast<BipolarPointer>(DLHeap.size()); ++i )
+	{
+		const DLVertex& v = DLHeap[i];
+		if ( v.Type() == dtLE && !v.getRole()->isDataRole() )
+			canMerge = true;
+		else if ( v.Type() == dtIrr )
+			pRAIndex->addSelfRole(v.getRole());
+	}
+
+	for ( RelatedCollection::const_iterator p = RelatedI.begin(), p_end = RelatedI.end(); p < p_end; ++p )
+		pRAIndex->addAssertion(*p);
+
+	pRAIndex->finalise(canMerge);
+}
+
+/// split the ABox into independent components if the TBox can't connect them
+void
+TBox :: buildABoxPartition ( void )
+{
+	delete pABoxPartition;
+	pABoxPartition = NULL;
+
+	// nominals and the universal role could relate any individuals
+	if ( nNominalReferences > 0 )
+		return;
+	for ( BipolarPointer i = 2; i < static_cast<BipolarPointer>(DLHeap.size()); ++i )
+	{
+		const TRole* R = DLHeap[i].getRole();
+		if ( R != NULL && !R->isDataRole() && R->isTop() )
+			return;
+	}
+
+	ABoxPartition* partition = new ABoxPartition();
+	for ( i_iterator pi = i_begin(); pi != i_end(); ++pi )
+		partition->addIndividual(*pi);
+	for ( i_iterator pi = i_begin(); pi != i_end(); ++pi )
+		if ( (*pi)->isSynonym() )
+			partition->connect ( *pi, resolveSynonym(*pi) );
+	for ( RelatedCollection::const_iterator p = RelatedI.begin(), p_end = RelatedI.end(); p < p_end; ++p )
+		partition->connect ( resolveSynonym((*p)->a), resolveSynonym((*p)->b) );
+	for ( DifferentIndividuals::const_iterator r = Different.begin(), r_end = Different.end(); r != r_end; ++r )
+		for ( SingletonVector::const_iterator q = r->begin(), q_end = r->end(); q != q_end; ++q )
+			partition->connect ( resolveSynonym(r->front()), resolveSynonym(*q) );
+	partition->finalise();
+	// RelatedI contains every assertion together with its inverse
+	for ( RelatedCollection::const_iterator p = RelatedI.begin(), p_end = RelatedI.end(); p < p_end; p += 2 )
+		partition->addRelated(*p);
+	for ( DifferentIndividuals::const_iterator r = Different.begin(), r_end = Different.end(); r != r_end; ++r )
+		partition->addDifferent(*r);
+
+	// a single component is the whole ABox
+	if ( partition->size() > 1 )
+		pABoxPartition = partition;
+	else
+		delete partition;
+}
+
+/// put into INDS all the individuals, keeping the ones from the same ABox component together
+void
+TBox :: getIndividualsByComponent ( ConceptVector& inds ) const
+{
+	if ( pABoxPartition == NULL )
+	{
+		inds.assign ( i_begin(), i_end() );
+		return;
+	}
+
+	for ( unsigned int n = 0; n < pABoxPartition->size(); ++n )
+		inds.insert ( inds.end(), pABoxPartition->getMembers(n).begin(), pABoxPartition->getMembers(n).end() );
+	for ( i_const_iterator pi = i_begin(); pi != i_end(); ++pi )
+		if ( (*pi)->isSynonym() )
+			inds.push_back(*pi);
+}
+
 /// check if 2 roles are disjoint
 bool
 TBox :: isDisjointRoles ( const TRole* R, const TRole* S )
@@ -433,6 +578,9 @@ void TBox :: readConfig ( const ifOptionSet* Options )
 	addBoolOption(useBackjumping);
 	addBoolOption(useLazyBlocking);
 	addBoolOption(useAnywhereBlocking);
+	addBoolOption(useAdaptiveOrder);
+	DLHeap.setFailRateOrder(useAdaptiveOrder);
+	addBoolOption(gatherStatistics);
 
 	if ( Axioms.initAbsorptionFlags(Options->getText("absorptionFlags")) )
 		throw EFaCTPlusPlus ( "Incorrect absorption flags given" );
@@ -441,6 +589,16 @@ void TBox :: readConfig ( const ifOptionSet* Options )
 	if ( LLM.isWritable(llAlways) )
 		LL << "Init testTimeout = " << testTimeout << "\n";
 
+	int n = Options->getInt("nThreads");
+	nThreads = n > 1 ? static_cast<unsigned int>(n) : 1;
+	if ( LLM.isWritable(llAlways) )
+		LL << "Init nThreads = " << nThreads << "\n";
+
+	n = Options->getInt("retainedGraphSize");
+	retainedGraphSize = n > 0 ? static_cast<unsigned int>(n) : 0;
+	if ( LLM.isWritable(llAlways) )
+		LL << "Init retainedGraphSize = " << retainedGraphSize << "\n";
+
 	PriorityMatrix.initPriorities ( Options->getText("IAOEFLG"), "IAOEFLG" );
 
 #ifdef RKG_USE_FAIRNESS
@@ -564,6 +722,24 @@ TBox :: writeReasoningResult ( std::ostream& o, float time ) const
 	Print(o);
 }
 
+void
+TBox :: gatherStatistic ( TReasoningStatistic& stat ) const
+{
+	if ( stdReasoner )
+		stdReasoner->gatherStatistic(stat);
+	if ( nomReasoner )
+		nomReasoner->gatherStatistic(stat);
+	if ( pReasonerPool )
+		pReasonerPool->gatherStatistic(stat);
+
+	stat.add ( TReasoningStatistic::rsDagSize, DLHeap.size() );
+	stat.add ( TReasoningStatistic::rsDagCacheHits, DLHeap.getNCacheHits() );
+
+	stat.add ( TReasoningStatistic::rsPreprocTime, preprocTime );
+	stat.add ( TReasoningStatistic::rsConsistTime, consistTime );
+	stat.add ( TReasoningStatistic::rsClassifyTime, classifyTime );
+}
+
 void TBox :: PrintDagEntry ( std::ostream& o, BipolarPointer p ) const
 {
 	fpp_assert ( isValid (p) );
@@ -30,6 +30,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "RoleMaster.h"
 #include "LogicFeature.h"
 #include "dlDag.h"
+#include "dlDagHash.h"
 #include "ifOptions.h"
 #include "PriorityMatrix.h"
 #include "tRelated.h"
@@ -40,8 +41,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "tKBFlags.h"
 #include "tSplitVars.h"
 #include "tSplitExpansionRules.h"
+#include "tRCCache.h"
+#include "tReasoningStatistic.h"
 
 class DlSatTester;
+class TReasonerPool;
+class RoleAssertionIndex;
+class ABoxPartition;
 class Taxonomy;
 class DLConceptTaxonomy;
 class dumpInterface;
@@ -65,6 +71,9 @@ class TBox
 	friend class ReasoningKernel;
 	friend class TAxiom;	// FIXME!! while TConcept can't get rid of told cycles
 	friend class DLConceptTaxonomy;
+	friend class TReasonerPool;
+	friend class DlSatWorker;
+	friend class NominalWorker;
 
 public:		// type interface
 		/// vector of CONCEPT-like elements
@@ -132,8 +141,6 @@ protected:	// types
 	}; // TSimpleRule
 		/// all simple rules in KB
 	typedef std::vector<TSimpleRule*> TSimpleRules;
-		/// R-C cache for the \forall R.C replacement in GCIs
-	typedef std::vector<std::pair<DLTree*,TConcept*> > TRCCache;
 
 protected:	// typedefs
 		/// RW concept iterator
@@ -164,6 +171,12 @@ protected:	// members
 		nomReasoner->ACT;			\
 		stdReasoner->ACT; } while(0)
 
+		/// pool of reasoners for the parallel subsumption tests; NULL if tests are sequential
+	TReasonerPool* pReasonerPool;
+		/// index of the role assertions entailed by the told ones; built by the realisation
+	RoleAssertionIndex* pRAIndex;
+		/// components of the ABox that could be reasoned about separately; NULL if the ABox is a whole
+	ABoxPartition* pABoxPartition;
 		/// progress monitor
 	TProgressMonitor* pMonitor;
 
@@ -265,6 +278,10 @@ protected:	// members
 	ToDoPriorMatrix PriorityMatrix;
 		/// single SAT/SUB test timeout in milliseconds
 	unsigned long testTimeout;
+		/// number of threads used for the subsumption tests during classification
+	unsigned int nThreads;
+		/// number of completion graph nodes kept allocated between tests; 0 means no limit
+	unsigned int retainedGraphSize;
 
 	//---------------------------------------------------------------------------
 	// Reasoner's members: there are many reasoner classes, some members are shared
@@ -278,6 +295,12 @@ protected:	// members
 	bool useLazyBlocking;
 		/// flag for switching between Anywhere and Ancestor blockings
 	bool useAnywhereBlocking;
+		/// flag to adjust OR ordering and rule priorities wrt the statistic of the early tests
+	bool useAdaptiveOrder;
+		/// flag to count tactic operations for the reasoning statistic
+	bool gatherStatistics;
+		/// number of tests performed in the adaptive mode
+	unsigned long nAdaptiveTests;
 		/// flag to use caching during completion tree construction
 	bool useNodeCache;
 		/// let reasoner know that we are in the classificaton (for splits)
@@ -320,6 +343,8 @@ protected:	// members
 	float preprocTime;
 		/// time spend for consistency checking
 	float consistTime;
+		/// time spend for classification and realisation
+	float classifyTime;
 
 private:	// no copy
 		/// no copy c'tor
@@ -456,7 +481,7 @@ protected:	// methods
 		// input check: only simple roles are allowed in the reflexivity construction
 		if ( !R->isSimple() )
 			throw EFPPNonSimpleRole(R->getName());
-		return inverse ( DLHeap.add ( new DLVertex ( dtIrr, R ) ) );
+		return inverse ( DLHeap.add ( new(DLHeap) DLVertex ( dtIrr, R ) ) );
 	}
 		/// create node for AND expression T
 	BipolarPointer and2dag ( const DLTree* t );
@@ -464,10 +489,10 @@ protected:	// methods
 	bool fillANDVertex ( DLVertex* v, const DLTree* t );
 		/// create forall node for data role
 	BipolarPointer dataForall2dag ( const TRole* R, BipolarPointer C )
-		{ return DLHeap.add ( new DLVertex ( dtForall, 0, R, C ) ); }
+		{ return DLHeap.add ( new(DLHeap) DLVertex ( dtForall, 0, R, C ) ); }
 		/// create atmost node for data role
 	BipolarPointer dataAtMost2dag ( unsigned int n, const TRole* R, BipolarPointer C )
-		{ return DLHeap.add ( new DLVertex ( dtLE, n, R, C ) ); }
+		{ return DLHeap.add ( new(DLHeap) DLVertex ( dtLE, n, R, C ) ); }
 		/// @return a pointer to concept representation
 	BipolarPointer concept2dag ( TConcept* p )
 	{
@@ -527,15 +552,9 @@ protected:	// methods
 	}
 
 		/// get aux concept obtained from C=\AR.~D by forall replacement
-	TConcept* getRCCache ( const DLTree* C ) const
-	{
-		for ( TRCCache::const_iterator p = RCCache.begin(), p_end = RCCache.end(); p < p_end; ++p )
-			if ( equalTrees ( C, p->first ) )
-				return p->second;
-		return NULL;
-	}
+	TConcept* getRCCache ( const DLTree* C ) const { return RCCache.get(C); }
 		/// add CN as a cache entry for C=\AR.~D>
-	void setRCCache ( DLTree* C, TConcept* CN ) { RCCache.push_back(std::make_pair(C,CN)); }
+	void setRCCache ( DLTree* C, TConcept* CN ) { RCCache.add(C,CN); }
 
 		/// check if TBox contains too many GCIs to switch strategy
 	bool isGalenLikeTBox ( void ) const { return isLikeGALEN; }
@@ -725,6 +744,12 @@ protected:	// methods
 	void setNameSigMap ( NameSigMap* p ) { pName2Sig = p; }
 		/// creating taxonomy for given TBox; include individuals if necessary
 	void createTaxonomy ( bool needIndividuals );
+		/// build the index of role assertions between individuals
+	void buildRoleAssertionIndex ( void );
+		/// split the ABox into independent components if the TBox can't connect them
+	void buildABoxPartition ( void );
+		/// put into INDS all the individuals, keeping the ones from the same ABox component together
+	void getIndividualsByComponent ( ConceptVector& inds ) const;
 		/// distribute all elements in [begin,end) range wtr theif tags
 	template<class Iterator>
 	unsigned int fillArrays ( Iterator begin, Iterator end )
@@ -752,6 +777,8 @@ protected:	// methods
 
 		return n;
 	}
+		/// classify all individuals using the results of their parallel tests against the concept taxonomy
+	void realiseInParallel ( void );
 		/// classify all concepts from given COLLECTION with given CD value
 	void classifyConcepts ( const ConceptVector& collection, bool curCompletelyDefined, const char* type );
 		/// classify single concept
@@ -910,17 +937,21 @@ protected:	// methods
 		KBFeatures |= p->negFeatures;
 		clearRelevanceInfo();
 	}
-		/// update AUX features with the given one; update roles if necessary
-	void updateAuxFeatures ( const LogicFeatures& lf )
+		/// update features LF with the given ones ADD; update roles if necessary
+	static void updateFeatures ( LogicFeatures& lf, const LogicFeatures& add )
 	{
-		if ( !lf.empty() )
+		if ( !add.empty() )
 		{
-			auxFeatures |= lf;
-			auxFeatures.mergeRoles();
+			lf |= add;
+			lf.mergeRoles();
 		}
 	}
+		/// fill features LF for SAT(P), or SUB(P,Q) test
+	void fillQueryFeatures ( LogicFeatures& lf, const TConcept* pConcept, const TConcept* qConcept ) const;
 		/// prepare features for SAT(P), or SUB(P,Q) test
 	void prepareFeatures ( const TConcept* pConcept, const TConcept* qConcept );
+		/// re-order OR alternatives and rule priorities wrt the branching and clash statistic gathered so far
+	void adaptReasoningOrder ( void );
 		/// clear current features
 	void clearFeatures ( void ) { curFeature = NULL; }
 
@@ -942,6 +973,10 @@ protected:	// methods
 
 		/// init pointer2int maps
 	void initPointerMaps ( SaveLoadManager& m ) const;
+		/// @return hash of the role R wrt DAG hashes HASH; 0 if there is no stable hash
+	dlDagHash::HashValue getRoleHash ( const TRole* R, const dlDagHash& hash ) const;
+		/// @return hash of the KB parts every model cache depends on (GCIs, roles, simple rules); 0 if there is no stable hash
+	dlDagHash::HashValue getModelCacheContext ( const dlDagHash& hash ) const;
 
 public:
 		/// init c'tor
@@ -1144,12 +1179,11 @@ public:
 		else
 			return KBFeatures.hasInverseRole();
 	}
+		/// check if the features LF contains number restrictions.
+	static bool hasNR ( const LogicFeatures& lf )
+		{ return lf.hasFunctionalRestriction() || lf.hasNumberRestriction() || lf.hasQNumberRestriction(); }
 		/// check if the relevant part of KB contains number restrictions.
-	bool isNRinQuery ( void ) const
-	{
-		const LogicFeatures* p = curFeature ? curFeature : &KBFeatures;
-		return p->hasFunctionalRestriction() || p->hasNumberRestriction() || p->hasQNumberRestriction();
-	}
+	bool isNRinQuery ( void ) const { return hasNR ( curFeature ? *curFeature : KBFeatures ); }
 		/// check if the relevant part of KB contains singletons
 	bool testHasNominals ( void ) const
 	{
@@ -1199,7 +1233,20 @@ public:
 		/// perform classification (assuming KB is consistent)
 	void performClassification ( void ) { createTaxonomy ( /*needIndividuals=*/false ); }
 		/// perform realisation (assuming KB is consistent)
-	void performRealisation ( void ) { createTaxonomy ( /*needIndividuals=*/true ); }
+	void performRealisation ( void )
+	{
+		createTaxonomy ( /*needIndividuals=*/true );
+		buildRoleAssertionIndex();
+	}
+		/// @return partition of the ABox into the independent components; NULL if there is only one
+	const ABoxPartition* getABoxPartition ( void ) const { return pABoxPartition; }
+		/// get the index of the role assertions; build it if the realisation was loaded
+	const RoleAssertionIndex& getRoleAssertionIndex ( void )
+	{
+		if ( pRAIndex == NULL )
+			buildRoleAssertionIndex();
+		return *pRAIndex;
+	}
 		/// reclassify taxonomy wrt changed sets
 	void reclassify ( const std::set<const TNamedEntity*>& MPlus, const std::set<const TNamedEntity*>& MMinus );
 
@@ -1214,6 +1261,12 @@ public:
 	void setProgressMonitor ( TProgressMonitor* pMon ) { pMonitor = pMon; }
 		/// check that reasoning progress was cancelled by external application
 	bool isCancelled ( void ) const { return pMonitor != NULL && pMonitor->isCancelled(); }
+		/// @return true iff SUB(P,Q) test could be performed by a reasoner pool
+	bool canTestInParallel ( const TConcept* p, const TConcept* q ) const;
+		/// @return reasoner pool for the parallel tests, creating it if necessary; NULL if the tests are sequential
+	TReasonerPool* getReasonerPool ( void );
+		/// @return true iff individuals could be realised in parallel after all the concepts are classified
+	bool canRealiseInParallel ( void ) const;
 		/// set verbose output (ie, default progress monitor, concept and role taxonomies) wrt given VALUE
 	void setVerboseOutput ( bool value ) { verboseOutput = value; }
 
@@ -1255,6 +1308,8 @@ public:
 	bool isSatisfiable ( const TConcept* C );
 		/// check that 2 individuals are the same
 	bool isSameIndividuals ( const TIndividual* a, const TIndividual* b );
+		/// make the completion graph nodes of all the individuals available to the queries that read them
+	void initIndividualNodes ( void );
 		/// check if 2 roles are disjoint
 	bool isDisjointRoles ( const TRole* R, const TRole* S );
 		/// check if the role R is irreflexive
@@ -1292,6 +1347,8 @@ public:
 
 		/// dump query processing TIME, reasoning statistics and a (preprocessed) TBox
 	void writeReasoningResult ( std::ostream& o, float time ) const;
+		/// add reasoning statistic of all the reasoners, DAG and reasoning phases to STAT
+	void gatherStatistic ( TReasoningStatistic& stat ) const;
 		/// print TBox as a whole
 	void Print ( std::ostream& o ) const
 	{
@@ -1320,6 +1377,10 @@ public:
 	void SaveTaxonomy ( SaveLoadManager& m, const std::set<const TNamedEntry*>& excluded );
 		/// load taxonomy with names (used in the incremental)
 	void LoadTaxonomy ( SaveLoadManager& m );
+		/// save model caches of the DAG entries together with their stable hashes
+	void SaveModelCaches ( SaveLoadManager& m ) const;
+		/// set model caches saved in another session to the unchanged DAG entries; @return number of the caches set
+	unsigned int LoadModelCaches ( SaveLoadManager& m );
 }; // TBox
 
 #endif
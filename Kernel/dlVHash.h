@@ -19,55 +19,82 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef _DLVHASH_H
 #define _DLVHASH_H
 
-#include <map>
-#include <list>
+#include <vector>
 #include "dlVertex.h"
 #include "tRole.h"
 
-/// naive and simple hash table for DL Verteces
+/// open-addressing hash table for DL Verteces
 class dlVHashTable
 {
 protected:	// types
-		/// hashed IDs of the DL verteces
-	typedef std::list<BipolarPointer> HashLeaf;
+		/// type of the hash value
+	typedef unsigned int HashValue;
+		/// entry of the table: position of the vertex in DAG with its hash value
+	struct HashEntry
+	{
+			/// position of the vertex in DAG; bpINVALID for the empty entry
+		BipolarPointer pos;
+			/// cached hash of the vertex
+		HashValue hash;
+			/// empty c'tor
+		HashEntry ( void ) : pos(bpINVALID), hash(0) {}
+	}; // HashEntry
 		/// hash table by itself
-	typedef std::map<BipolarPointer, HashLeaf> HashTable;
+	typedef std::vector<HashEntry> HashTable;
 
 protected:	// members
 		/// host DAG that contains actual nodes;
 	const DLDag& host;
-		/// HT for nodes
+		/// HT for nodes; the size is always a power of 2
 	HashTable Table;
+		/// number of the elements in the table
+	size_t nElements;
 
 protected:	// methods
-		/// get a (very simple) hash of the vertex
-	static BipolarPointer hash ( const DLVertex& v )
+		/// mix the bits of a hash value H
+	static HashValue mix ( HashValue h )
+	{
+		h ^= h >> 16;
+		h *= 0x85ebca6bU;
+		h ^= h >> 13;
+		h *= 0xc2b2ae35U;
+		h ^= h >> 16;
+		return h;
+	}
+		/// add value V to the hash SEED
+	static HashValue combine ( HashValue seed, HashValue v ) { return mix ( seed ^ ( v + 0x9e3779b9U + (seed << 6) + (seed >> 2) ) ); }
+		/// get a hash of the vertex
+	static HashValue hash ( const DLVertex& v )
 	{
-		BipolarPointer sum = 0;
-		if ( v.getRole() != NULL )
-			sum += v.getRole()->getId();
-		if ( v.getProjRole() != NULL )
-			sum += v.getProjRole()->getId();
-		sum += v.getC();
-		sum += v.getNumberLE();
+		HashValue h = v.Type();
+		h = combine ( h, v.getRole() != NULL ? v.getRole()->getId() : 0 );
+		h = combine ( h, v.getProjRole() != NULL ? v.getProjRole()->getId() : 0 );
+		h = combine ( h, v.getC() );
+		h = combine ( h, v.getNumberLE() );
+		// AND's children are re-sorted after the vertex is added, so the hash doesn't depend on the order
+		HashValue sum = 0;
 		for ( DLVertex::const_iterator p = v.begin(), p_end = v.end(); p < p_end; ++p )
-			sum += *p;
-		return sum;
+			sum += mix(*p);
+		return combine ( h, sum );
 	}
 
-		/// insert new POSition into a given LEAF
-	void insert ( HashLeaf& leaf, BipolarPointer pos ) { leaf.push_back(pos); }
-		/// locate vertex V in a given LEAF
-	BipolarPointer locate ( const HashLeaf& leaf, const DLVertex& v ) const;
+		/// get the index of an entry next to I
+	size_t next ( size_t i ) const { return (i+1) & (Table.size()-1); }
+		/// insert new POSition with hash H into the table; the table should have free entries
+	void insert ( BipolarPointer pos, HashValue h );
+		/// enlarge the table to keep the load factor below 3/4
+	void grow ( void );
 
 public:		// interface
 		/// empty c'tor
-	dlVHashTable ( const DLDag& dag ) : host(dag) {}
+	dlVHashTable ( const DLDag& dag ) : host(dag), nElements(0) {}
 		/// empty d'tor
 	~dlVHashTable ( void ) {}
 
 		/// add an element (given by a POSition) to hash
 	void addElement ( BipolarPointer pos );
+		/// remove an element (given by a POSition) from hash; the vertex should still be in DAG
+	void removeElement ( BipolarPointer pos );
 		/// locate given vertice in the hash
 	BipolarPointer locate ( const DLVertex& v ) const;
 }; // dlVHashTable
@@ -21,27 +21,78 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 // implementation of DLVertex Hash; to be included after DLDag definition
 
-inline BipolarPointer
-dlVHashTable :: locate ( const HashLeaf& leaf, const DLVertex& v ) const
+inline void
+dlVHashTable :: insert ( BipolarPointer pos, HashValue h )
 {
-	for ( HashLeaf::const_iterator p = leaf.begin(), p_end = leaf.end(); p != p_end; ++p )
-		if ( v == host[*p] )
-			return *p;
+	size_t i = h & (Table.size()-1);
+	while ( Table[i].pos != bpINVALID )
+		i = next(i);
+	Table[i].pos = pos;
+	Table[i].hash = h;
+}
 
-	return bpINVALID;
+inline void
+dlVHashTable :: grow ( void )
+{
+	HashTable old;
+	old.swap(Table);
+	Table.resize ( old.empty() ? 64 : old.size()*2 );
+	// re-insert all the elements using the cached hash values
+	for ( HashTable::const_iterator p = old.begin(), p_end = old.end(); p != p_end; ++p )
+		if ( p->pos != bpINVALID )
+			insert ( p->pos, p->hash );
 }
 
 inline BipolarPointer
 dlVHashTable :: locate ( const DLVertex& v ) const
 {
-	HashTable::const_iterator p = Table.find(hash(v));
-	return p == Table.end() ? bpINVALID : locate ( p->second, v );
+	if ( Table.empty() )
+		return bpINVALID;
+
+	HashValue h = hash(v);
+	for ( size_t i = h & (Table.size()-1); Table[i].pos != bpINVALID; i = next(i) )
+		// vertices removed from the DAG might still be in the table, so check the position first
+		if ( Table[i].hash == h && static_cast<size_t>(Table[i].pos) < host.size() && v == host[Table[i].pos] )
+			return Table[i].pos;
+
+	return bpINVALID;
 }
 
 inline void
 dlVHashTable :: addElement ( BipolarPointer pos )
 {
-	insert ( Table[hash(host[pos])], pos );
+	if ( (nElements+1)*4 > Table.size()*3 )
+		grow();
+	insert ( pos, hash(host[pos]) );
+	++nElements;
+}
+
+inline void
+dlVHashTable :: removeElement ( BipolarPointer pos )
+{
+	if ( Table.empty() )
+		return;
+
+	size_t i = hash(host[pos]) & (Table.size()-1);
+	while ( Table[i].pos != pos )
+	{
+		if ( Table[i].pos == bpINVALID )	// not in the table
+			return;
+		i = next(i);
+	}
+
+	// backward-shift deletion: move up the entries whose probe sequence goes through I
+	for ( size_t j = next(i); Table[j].pos != bpINVALID; j = next(j) )
+	{
+		size_t k = Table[j].hash & (Table.size()-1);
+		// entry J stays if its home K is cyclically in (I,J]
+		if ( i <= j ? ( i < k && k <= j ) : ( i < k || k <= j ) )
+			continue;
+		Table[i] = Table[j];
+		i = j;
+	}
+	Table[i] = HashEntry();
+	--nElements;
 }
 
 #endif
@@ -39,6 +39,7 @@ bool DLVertex :: addChild ( BipolarPointer p )
 	{
 clash:	// clash found: clear all stuff; returns true
 		Child.resize(0);
+		syncChildren();
 		Op = dtBad;
 		return true;
 	}
@@ -53,6 +54,7 @@ clash:	// clash found: clear all stuff; returns true
 	if ( q == q_end )	// finish
 	{
 		Child.push_back(p);
+		syncChildren();
 		return false;
 	}
 
@@ -70,6 +72,7 @@ clash:	// clash found: clear all stuff; returns true
 		*q=*(q-1);	// copy the tail
 
 	*q = p;
+	syncChildren();
 
 	// FIXME: add some simplification (about AR.C1, AR.c2 etc)
 	return false;
@@ -89,18 +92,18 @@ void DLVertex :: sortEntry ( const DLDag& dag )
 
 	register BipolarPointer x;	// value of moved element
 	register int j;
-	unsigned int size = Child.size();
+	unsigned int size = nChildren;
 
 	for ( register unsigned int i = 1; i < size; ++i )
 	{
-		x = Child[i];
+		x = Children[i];
 
 		// put x to the place s.t. SxL, where S <= x < L wrt dag.less()
-		for ( j = i-1; j >= 0 && dag.less ( x, Child[j] ); --j )
-			Child[j+1] = Child[j];
+		for ( j = i-1; j >= 0 && dag.less ( x, Children[j] ); --j )
+			Children[j+1] = Children[j];
 
 		// insert new element on it's place
-		Child[j+1] = x;
+		Children[j+1] = x;
 	}
 }
 
@@ -21,6 +21,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <vector>
 #include <iostream>
+#include <iterator>
+#include <algorithm>
 #include <cstring>	// memset
 
 #include "globaldef.h"
@@ -276,6 +278,39 @@ public:		// interface
 	void incUsage ( bool pos ) { if ( pos ) ++posUsage; else ++negUsage; }
 }; // DLVertexUsage
 
+/// statistic of the vertex being an OR alternative; used in the adaptive OR ordering
+class DLVertexBranchStat
+{
+public:		// types
+		/// type for a statistic
+	typedef unsigned int BranchType;
+
+protected:	// members
+		/// number of times pos- and neg entry was chosen as an OR alternative
+	BranchType posChoices, negChoices;
+		/// number of times the chosen pos- and neg alternative failed
+	BranchType posFails, negFails;
+
+public:		// interface
+		/// empty c'tor
+	DLVertexBranchStat ( void ) : posChoices(0), negChoices(0), posFails(0), negFails(0) {}
+		/// empty d'tor
+	virtual ~DLVertexBranchStat ( void ) {}
+
+		/// register that the entry wrt POS was chosen as an OR alternative
+	void incChoices ( bool pos ) { if ( pos ) ++posChoices; else ++negChoices; }
+		/// register that the chosen alternative wrt POS failed
+	void incFails ( bool pos ) { if ( pos ) ++posFails; else ++negFails; }
+		/// @return number of times the entry wrt POS was chosen as an OR alternative
+	BranchType getChoices ( bool pos ) const { return pos ? posChoices : negChoices; }
+		/// @return estimated probability that the entry wrt POS fails being chosen as an OR alternative
+	double getFailRate ( bool pos ) const
+	{
+		// unknown alternatives are neither good nor bad
+		return pos ? (posFails+1.0)/(posChoices+2.0) : (negFails+1.0)/(negChoices+2.0);
+	}
+}; // DLVertexBranchStat
+
 class DLVertexSort
 {
 protected:	// members
@@ -302,6 +337,7 @@ public:		// interface
 class DLVertex
 	: public DLVertexCache
 	, public DLVertexStatistic
+	, public DLVertexBranchStat
 #ifdef RKG_PRINT_DAG_USAGE
 	, public DLVertexUsage
 #endif
@@ -315,6 +351,8 @@ private:	// prevent copying
 	DLVertex ( const DLVertex& v );
 		/// no assignment
 	DLVertex& operator = ( const DLVertex& v );
+		/// vertices are released only by the DAG that owns their memory
+	static void operator delete ( void* ) {}
 
 protected:	// typedefs
 		/// base type for array of BPs
@@ -322,13 +360,17 @@ protected:	// typedefs
 
 public:		// typedefs
 		/// RO access to the elements of node
-	typedef BaseType::const_iterator const_iterator;
+	typedef const BipolarPointer* const_iterator;
 		/// RO access to the elements of node in reverse order
-	typedef BaseType::const_reverse_iterator const_reverse_iterator;
+	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
 protected:	// members
-		/// set of arguments (CEs, numbers for NR)
+		/// set of arguments (CEs, numbers for NR) while the vertex is being built
 	BaseType Child;
+		/// arguments of the vertex; points to Child or to the DAG children pool
+	BipolarPointer* Children;
+		/// number of the arguments
+	unsigned int nChildren;
 		/// pointer to concept-like entry (for PConcept, etc)
 	TNamedEntry* Concept;
 		/// pointer to role (for E\A, NR)
@@ -340,10 +382,20 @@ protected:	// members
 		/// n if available
 	unsigned int n;
 
+protected:	// methods
+		/// make the arguments point to the content of Child
+	void syncChildren ( void )
+	{
+		Children = Child.empty() ? NULL : &Child[0];
+		nChildren = Child.size();
+	}
+
 public:		// interface
 		/// c'tor for Top/CN/And (before adding any operands)
 	explicit DLVertex ( DagTag op )
 		: DLVertexTagDFS(op)
+		, Children(NULL)
+		, nChildren(0)
 		, Concept(NULL)
 		, Role(NULL)
 		, ProjRole(NULL)
@@ -353,6 +405,8 @@ public:		// interface
 		/// c'tor for Refl/Irr
 	DLVertex ( DagTag op, const TRole* R )
 		: DLVertexTagDFS(op)
+		, Children(NULL)
+		, nChildren(0)
 		, Concept(NULL)
 		, Role(R)
 		, ProjRole(NULL)
@@ -362,6 +416,8 @@ public:		// interface
 		/// c'tor for CN/DE; C is an operand
 	DLVertex ( DagTag op, BipolarPointer c )
 		: DLVertexTagDFS(op)
+		, Children(NULL)
+		, nChildren(0)
 		, Concept(NULL)
 		, Role(NULL)
 		, ProjRole(NULL)
@@ -371,6 +427,8 @@ public:		// interface
 		/// c'tor for <= n R_C; and for \A R{n}_C; Note order C, n, R->pointer
 	DLVertex ( DagTag op, BipolarPointer m, const TRole* R, BipolarPointer c )
 		: DLVertexTagDFS(op)
+		, Children(NULL)
+		, nChildren(0)
 		, Concept(NULL)
 		, Role(R)
 		, ProjRole(NULL)
@@ -380,6 +438,8 @@ public:		// interface
 		/// c'tor for ProjFrom R C ProjR
 	DLVertex ( const TRole* R, BipolarPointer c, const TRole* ProjR )
 		: DLVertexTagDFS(dtProj)
+		, Children(NULL)
+		, nChildren(0)
 		, Concept(NULL)
 		, Role(R)
 		, ProjRole(ProjR)
@@ -389,6 +449,11 @@ public:		// interface
 		/// d'tor (empty)
 	virtual ~DLVertex ( void ) {}
 
+		/// allocate a vertex in the arena of the DAG
+	static void* operator new ( size_t size, DLDag& dag );
+		/// release the memory if the c'tor of the vertex fails
+	static void operator delete ( void* p, DLDag& dag );
+
 		/// compare 2 CEs
 	bool operator == ( const DLVertex& v ) const
 	{
@@ -397,7 +462,8 @@ public:		// interface
 			   (ProjRole == v.ProjRole) &&
 			   (C == v.C) &&
 			   (n == v.n) &&
-			   (Child == v.Child);
+			   (nChildren == v.nChildren) &&
+			   std::equal ( begin(), end(), v.begin() );
 	}
 		/// compare 2 CEs
 	bool operator != ( const DLVertex& v ) const { return !(*this == v); }
@@ -411,14 +477,16 @@ public:		// interface
 	unsigned int getState ( void ) const { return n; }
 
 		/// return pointer to the first concept name of the entry
-	const_iterator begin ( void ) const { return Child.begin(); }
+	const_iterator begin ( void ) const { return Children; }
 		/// return pointer after the last concept name of the entry
-	const_iterator end ( void ) const { return Child.end(); }
+	const_iterator end ( void ) const { return Children + nChildren; }
 
 		/// return pointer to the last concept name of the entry; WARNING!! works for AND only
-	const_reverse_iterator rbegin ( void ) const { return Child.rbegin(); }
+	const_reverse_iterator rbegin ( void ) const { return const_reverse_iterator(end()); }
 		/// return pointer before the first concept name of the entry; WARNING!! works for AND only
-	const_reverse_iterator rend ( void ) const { return Child.rend(); }
+	const_reverse_iterator rend ( void ) const { return const_reverse_iterator(begin()); }
+		/// get number of the concept names of the entry
+	unsigned int nArgs ( void ) const { return nChildren; }
 
 		/// return pointer to Role for the Role-like verteces
 	const TRole* getRole ( void ) const { return Role; }
@@ -435,6 +503,13 @@ public:		// interface
 	void setChild ( BipolarPointer p ) { C = p; }
 		/// adds a child to 'AND' vertex; returns TRUE if contradiction found
 	bool addChild ( BipolarPointer p );
+		/// move children of a vertex to the (preallocated) DAG pool P
+	void moveChildren ( BipolarPointer* p )
+	{
+		std::copy ( Child.begin(), Child.end(), p );
+		Children = p;
+		BaseType().swap(Child);
+	}
 
 	// methods for choosing ordering in the OR fields
 
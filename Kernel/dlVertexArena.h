@@ -0,0 +1,162 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef DLVERTEXARENA_H
+#define DLVERTEXARENA_H
+
+#include <vector>
+#include <cstdlib>
+#include <new>
+
+#include "dlVertex.h"
+
+/**
+ * Arena for the DAG: vertices are allocated in large chunks in the order
+ * they are added to the DAG, and children of all vertices are kept in a
+ * flat pool. The memory is released all at once when the arena is destroyed.
+ */
+class DLVertexArena
+{
+public:		// types
+		/// position in the children pool; used to roll back the query children
+	struct ChildMark
+	{
+			/// number of chunks in use
+		size_t nChunks;
+			/// number of entries used in the last chunk
+		size_t used;
+	}; // ChildMark
+
+protected:	// types
+		/// chunk of memory
+	struct Chunk
+	{
+			/// start of the chunk
+		char* start;
+			/// capacity of the chunk
+		size_t size;
+	}; // Chunk
+		/// vector of chunks
+	typedef std::vector<Chunk> ChunkVector;
+
+protected:	// constants
+		/// number of vertices in a single chunk
+	static const size_t VertexChunkSize = 1024;
+		/// number of children in a single chunk
+	static const size_t ChildChunkSize = 8192;
+
+protected:	// members
+		/// chunks keeping vertices
+	ChunkVector VertexChunks;
+		/// number of vertices used in the last vertex chunk
+	size_t nVertices;
+		/// slots of the deleted vertices to be reused
+	std::vector<void*> FreeVertices;
+		/// chunks keeping children
+	ChunkVector ChildChunks;
+		/// number of children used in the last child chunk
+	size_t nChildren;
+
+private:	// no copy
+		/// no copy c'tor
+	DLVertexArena ( const DLVertexArena& );
+		/// no assignment
+	DLVertexArena& operator= ( const DLVertexArena& );
+
+protected:	// methods
+		/// add a new chunk of SIZE bytes to CHUNKS
+	static char* newChunk ( ChunkVector& chunks, size_t size )
+	{
+		Chunk c;
+		c.start = static_cast<char*>(std::malloc(size));
+		if ( unlikely(c.start == NULL) )
+			throw std::bad_alloc();
+		c.size = size;
+		chunks.push_back(c);
+		return c.start;
+	}
+		/// free all the chunks in CHUNKS starting from the N-th one
+	static void freeChunks ( ChunkVector& chunks, size_t n )
+	{
+		for ( size_t i = n; i < chunks.size(); ++i )
+			std::free(chunks[i].start);
+		chunks.resize(n);
+	}
+
+public:		// interface
+		/// empty c'tor
+	DLVertexArena ( void ) : nVertices(VertexChunkSize), nChildren(0) {}
+		/// d'tor: free all the memory; vertices should be destroyed already
+	~DLVertexArena ( void )
+	{
+		freeChunks ( VertexChunks, 0 );
+		freeChunks ( ChildChunks, 0 );
+	}
+
+	// vertices
+
+		/// get memory for a new vertex
+	void* allocVertex ( void )
+	{
+		if ( !FreeVertices.empty() )
+		{
+			void* ret = FreeVertices.back();
+			FreeVertices.pop_back();
+			return ret;
+		}
+		if ( nVertices == VertexChunkSize )
+		{
+			newChunk ( VertexChunks, VertexChunkSize*sizeof(DLVertex) );
+			nVertices = 0;
+		}
+		return VertexChunks.back().start + sizeof(DLVertex)*nVertices++;
+	}
+		/// return memory of a destroyed vertex P to the arena
+	void freeVertex ( void* p ) { FreeVertices.push_back(p); }
+
+	// children
+
+		/// get memory for N children
+	BipolarPointer* allocChildren ( size_t n )
+	{
+		if ( ChildChunks.empty() || n > ChildChunks.back().size/sizeof(BipolarPointer) - nChildren )
+		{
+			newChunk ( ChildChunks, ( n > ChildChunkSize ? n : ChildChunkSize ) * sizeof(BipolarPointer) );
+			nChildren = 0;
+		}
+		BipolarPointer* ret = reinterpret_cast<BipolarPointer*>(ChildChunks.back().start) + nChildren;
+		nChildren += n;
+		return ret;
+	}
+		/// get the current position in the children pool
+	ChildMark getChildMark ( void ) const
+	{
+		ChildMark mark;
+		mark.nChunks = ChildChunks.size();
+		mark.used = nChildren;
+		return mark;
+	}
+		/// release all the children allocated after MARK
+	void rollbackChildren ( const ChildMark& mark )
+	{
+		freeChunks ( ChildChunks, mark.nChunks );
+		nChildren = mark.used;
+	}
+}; // DLVertexArena
+
+#endif
@@ -261,6 +261,19 @@ bool equalTrees ( const DLTree* t1, const DLTree* t2 )
 		   equalTrees ( t1->Right(), t2->Right() );
 }
 
+unsigned int hashTree ( const DLTree* t )
+{
+	if ( t == NULL )
+		return 0;
+
+	// use the same lexeme parts as the equality check
+	unsigned int h = static_cast<unsigned int>(t->Element().getToken()) * 0x9e3779b1U;
+	h ^= t->Element().getData() + 0x7f4a7c15U + (h << 6) + (h >> 2);
+	h ^= hashTree(t->Left()) + 0x7f4a7c15U + (h << 6) + (h >> 2);
+	h ^= hashTree(t->Right()) * 31 + 0x7f4a7c15U + (h << 6) + (h >> 2);
+	return h;
+}
+
 bool isSubTree ( const DLTree* t1, const DLTree* t2 )
 {
 	if ( t1 == NULL || t1->Element() == TOP )
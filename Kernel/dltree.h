@@ -35,6 +35,8 @@ extern bool isSNF ( const DLTree* t );
 
 	// checks if two trees are the same (syntactically)
 extern bool equalTrees ( const DLTree* t1, const DLTree* t2 );
+	// structural hash of the tree; equal trees have equal hashes
+extern unsigned int hashTree ( const DLTree* t );
 	// check whether t1=(and c1..cn), t2 = (and d1..dm) and ci = dj for all i
 extern bool isSubTree ( const DLTree* t1, const DLTree* t2 );
 
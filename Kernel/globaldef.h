@@ -59,6 +59,12 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 // uncomment this to support fairness constraints
 //#define RKG_USE_FAIRNESS
 
+// uncomment this to use tree-based sets instead of bitsets in Ian's model cache
+//#define RKG_USE_TREE_SETS_IN_CACHE
+
+// uncomment this to use shared-tail lists for all dep-sets instead of bitsets for small levels
+//#define RKG_USE_LIST_DEPSET
+
 // uncomment the following line if IR is defined as a list of elements in node label
 #define RKG_IR_IN_NODE_LABEL
 
@@ -61,6 +61,8 @@ public:		// interface
 	void resize ( size_t n ) { reserve(n); last = n; }
 		/// clear the array
 	void clear ( void ) { last = 0; }
+		/// clear the array and release all its memory
+	void release ( void ) { std::vector<C>().swap(Body); last = 0; }
 		/// get the count of elements
 	size_t size ( void ) const { return last; }
 
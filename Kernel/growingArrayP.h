@@ -100,6 +100,19 @@ public:		// interface
 	void resize ( size_t n ) { ensureHeapSize(n); last = n; }
 		/// get the number of elements
 	size_t size ( void ) const { return last; }
+		/// get the number of allocated objects
+	size_t capacity ( void ) const { return Base.size(); }
+		/// delete all the unused objects except for the first N ones
+	void shrink ( size_t n )
+	{
+		if ( n < last )
+			n = last;
+		if ( n >= Base.size() )
+			return;
+		for ( riterator p = Base.rbegin(), p_end = Base.rend()-n; p != p_end; ++p )
+			delete *p;
+		baseType ( Base.begin(), Base.begin()+n ).swap(Base);
+	}
 		/// check if heap is empty
 	bool empty ( void ) const { return last == 0; }
 		/// mark all array elements as unused
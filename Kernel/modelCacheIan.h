@@ -22,7 +22,11 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "modelCacheSingleton.h"
 #include "dlCompletionTree.h"
 #include "dlDag.h"
-#include "tSetAsTree.h"
+#ifdef RKG_USE_TREE_SETS_IN_CACHE
+#	include "tSetAsTree.h"
+#else
+#	include "tSetAsBitset.h"
+#endif
 
 class SaveLoadManager;
 
@@ -35,7 +39,11 @@ class modelCacheIan: public modelCacheInterface
 friend class DLConceptTaxonomy;
 protected:	// types
 		/// define the type of an index set
+#ifdef RKG_USE_TREE_SETS_IN_CACHE
 	typedef TSetAsTree IndexSet;
+#else
+	typedef TSetAsBitset IndexSet;
+#endif
 		/// node label iterator
 	typedef DlCompletionTree::const_label_iterator l_iterator;
 		/// edges iterator
@@ -226,6 +234,8 @@ public:
 	void Save ( SaveLoadManager& m ) const;
 		/// load internal state of the Kernel from a file NAME
 	void Load ( SaveLoadManager& m );
+		/// load the cache saved in another session; CMAP and RMAP translate concept and role indices. @return false if some index is unknown
+	bool Load ( SaveLoadManager& m, const std::vector<unsigned int>& cMap, const std::vector<unsigned int>& rMap );
 }; // modelCacheIan
 
 #endif
@@ -78,6 +78,8 @@ public:		// interface
 	void updateNominalStatus ( const modelCacheInterface* p ) { hasNominalNode |= p->hasNominalNode; }
 		/// state the precense of a nominals in cache wrt FLAG
 	void setFlagNominals ( bool flag ) { hasNominalNode = flag; }
+		/// @return true iff the model contains nominals
+	bool hasNominals ( void ) const { return hasNominalNode; }
 
 	// mergable part
 
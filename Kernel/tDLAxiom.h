@@ -165,10 +165,6 @@ protected:	// members
 	const TOntologyAtom* Atom;
 		/// flag to show whether it is used (to support retraction)
 	bool used;
-		/// flag to show whether or not the axiom is in the module
-	bool inModule;
-		/// flag to show whether or not the axiom is in the search space for the optimised modularization algorithm
-	bool inSearchSpace;
 
 protected:	// methods
 		/// build signature of an axiom
@@ -177,11 +173,10 @@ protected:	// methods
 public:		// interface
 		/// empty c'tor
 	TDLAxiom ( void )
-		: sig(NULL)
+		: id(0)
+		, sig(NULL)
 		, Atom(NULL)
 		, used(true)
-		, inModule(false)
-		, inSearchSpace(false)
 		{}
 		/// d'tor: delete signature if it was created
 	virtual ~TDLAxiom ( void );
@@ -200,17 +195,6 @@ public:		// interface
 		/// get the value of the used flag
 	bool isUsed ( void ) const { return used; }
 
-	// modularity management
-
-		/// set the inModule flag
-	void setInModule ( bool flag ) { inModule = flag; }
-		/// get the value of the inModule flag
-	bool isInModule ( void ) const { return inModule; }
-		/// set the isSearchSpace flag
-	void setInSS ( bool flag ) { inSearchSpace = flag; }
-		/// get the value of the isSearchSpace flag
-	bool isInSS ( void ) const { return inSearchSpace; }
-
 	// signature access
 
 	const TSignature& getSignature ( void )
@@ -258,10 +258,12 @@ protected:	// members
 	std::string Name;
 		/// translated version of it
 	TNamedEntry* entry;
+		/// dense id of the entity, unique within its expression manager; used to represent signatures as bit vectors
+	unsigned int Id;
 
 public:		// interface
 		/// c'tor: initialise name
-	TNamedEntity ( const std::string& name ) : Name(name), entry(NULL) {}
+	TNamedEntity ( const std::string& name ) : Name(name), entry(NULL), Id(0) {}
 		/// empty d'tor
 	virtual ~TNamedEntity ( void ) {}
 
@@ -269,6 +271,10 @@ public:		// interface
 	const char* getName ( void ) const { return Name.c_str(); }
 		/// get access to the element itself
 	const TNamedEntity* getEntity ( void ) const { return this; }
+		/// set the id of the entity
+	void setId ( unsigned int id ) { Id = id; }
+		/// get the id of the entity
+	unsigned int getId ( void ) const { return Id; }
 
 		/// set entry
 	void setEntry ( TNamedEntry* e ) { entry = e; }
@@ -65,6 +65,8 @@ public:		// interface
 	unsigned int level ( void ) const { return Level; }
 		/// get pointer to the Tail DSE
 	TDepSetElement* tail ( void ) const { return Tail; }
+		/// get the containing manager
+	TDepSetManager* getManager ( void ) const { return Manager; }
 		/// merge this element with ELEM; use Manager for this
 	TDepSetElement* merge ( TDepSetElement* elem );
 		/// Print given dep-set to a standart stream
@@ -19,7 +19,12 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "tExpressionManager.h"
 
 TExpressionManager :: TExpressionManager ( void )
-	: CTop(new TDLConceptTop)
+	: nEntities(0)
+	, NS_C(new TEntityCreator<TDLConceptName>(nEntities))
+	, NS_I(new TEntityCreator<TDLIndividualName>(nEntities))
+	, NS_OR(new TEntityCreator<TDLObjectRoleName>(nEntities))
+	, NS_DR(new TEntityCreator<TDLDataRoleName>(nEntities))
+	, CTop(new TDLConceptTop)
 	, CBottom(new TDLConceptBottom)
 	, DTop(new TDLDataTop)
 	, DBottom(new TDLDataBottom)
@@ -59,6 +64,12 @@ TExpressionManager :: clear ( void )
 	for ( std::vector<TDLExpression*>::iterator p = RefRecorder.begin(), p_end = RefRecorder.end(); p < p_end; ++p )
 		delete *p;
 	RefRecorder.clear();
+	// named top/bottom roles are kept, so renumber them together with the new entities
+	nEntities = 0;
+	renumberEntity(ORTop);
+	renumberEntity(ORBottom);
+	renumberEntity(DRTop);
+	renumberEntity(DRBottom);
 }
 
 /// clear the TNamedEntry cache for all elements of all name-sets
@@ -29,6 +29,28 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 class TExpressionManager
 {
 protected:	// types
+		/// creator of the named entities that gives every new entity the next id of the manager
+	template<class T>
+	class TEntityCreator: public TNameCreator<T>
+	{
+	protected:	// members
+			/// number of entities of the host expression manager
+		unsigned int& nEntities;
+
+	public:		// interface
+			/// init c'tor
+		TEntityCreator ( unsigned int& n ) : TNameCreator<T>(), nEntities(n) {}
+			/// empty d'tor
+		virtual ~TEntityCreator ( void ) {}
+
+			/// create new entity with the next id
+		virtual T* makeEntry ( const std::string& name ) const
+		{
+			T* ret = new T(name);
+			ret->setId(nEntities++);
+			return ret;
+		}
+	}; // TEntityCreator
 		/// cache for the one-of expressions
 	class TOneOfCache: public THeadTailCache<TDLConceptExpression, const TDLIndividualExpression>
 	{
@@ -71,6 +93,8 @@ protected:	// types
 	}; // TInverseRoleCache
 
 protected:	// members
+		/// number of the named entities (concepts, individuals and roles) created so far; the id of the next one
+	unsigned int nEntities;
 		/// nameset for concepts
 	TNameSet<TDLConceptName> NS_C;
 		/// nameset for individuals
@@ -114,6 +138,16 @@ protected:	// methods
 		/// record the reference; @return the argument
 	template<class T>
 	T* record ( T* arg ) { RefRecorder.push_back(arg); return arg; }
+		/// give a named entity E the next id; @return E
+	template<class T>
+	T* newEntity ( T* e ) { e->setId(nEntities++); return e; }
+		/// give the next id to an expression E if it is a named entity
+	void renumberEntity ( TDLExpression* e )
+	{
+		TNamedEntity* entity = dynamic_cast<TNamedEntity*>(e);
+		if ( entity != NULL )
+			entity->setId(nEntities++);
+	}
 		/// clear the TNamedEntry cache for all elements of a name-set NS
 	template<class T>
 	void clearNameCache ( TNameSet<T>& ns )
@@ -139,13 +173,13 @@ public:		// interface
 	void setTopBottomRoles ( const char* topORoleName, const char* botORoleName, const char* topDRoleName, const char* botDRoleName )
 	{
 		delete ORTop;
-		ORTop = new TDLObjectRoleName(topORoleName);
+		ORTop = newEntity(new TDLObjectRoleName(topORoleName));
 		delete ORBottom;
-		ORBottom = new TDLObjectRoleName(botORoleName);
+		ORBottom = newEntity(new TDLObjectRoleName(botORoleName));
 		delete DRTop;
-		DRTop = new TDLDataRoleName(topDRoleName);
+		DRTop = newEntity(new TDLDataRoleName(topDRoleName));
 		delete DRBottom;
-		DRBottom = new TDLDataRoleName(botDRoleName);
+		DRBottom = newEntity(new TDLDataRoleName(botDRoleName));
 	}
 		/// @return true iff R is a top object role
 	bool isUniversalRole ( const TDLObjectRoleExpression* R ) const { return R == ORTop; }
@@ -19,6 +19,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef THEADTAILCACHE_H
 #define THEADTAILCACHE_H
 
+#include <map>
+
 /// Template class for the cache element. Assumes that new elements of a HEADTYPE
 /// are constructed using a single argument of a TAILTYPE. Uniqueness of a tails
 /// leads to the uniqueness of a constructed object
@@ -20,7 +20,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #define TNAMESET_H
 
 #include <string>
-#include <map>
+#include <vector>
+#include <cstring>
 
 /// base class for creating Named Entries; template parameter should be derived from TNamedEntry
 template<class T>
@@ -37,23 +38,128 @@ public:		// interface
 }; // TNameCreator
 
 
-/// Implementation of NameSets by binary trees; template parameter should be derived from TNamedEntry
+/// storage for the names of a name set: strings are kept in large chunks and never moved
+class TNameArena
+{
+protected:	// constants
+		/// size of a single chunk
+	static const size_t ChunkSize = 64*1024;
+
+protected:	// members
+		/// all the chunks
+	std::vector<char*> Chunks;
+		/// free space in the last chunk
+	size_t nFree;
+
+private:	// no copy
+		/// no copy c'tor
+	TNameArena ( const TNameArena& );
+		/// no assignment
+	TNameArena& operator = ( const TNameArena& );
+
+public:		// interface
+		/// empty c'tor
+	TNameArena ( void ) : nFree(0) {}
+		/// d'tor
+	~TNameArena ( void ) { clear(); }
+
+		/// @return persistent copy of the string STR of length LEN
+	const char* intern ( const char* str, size_t len )
+	{
+		char* ret;
+		if ( len+1 > ChunkSize/4 )	// long strings are kept in separate chunks
+		{
+			ret = new char[len+1];
+			Chunks.insert ( Chunks.begin(), ret );
+		}
+		else
+		{
+			if ( len+1 > nFree )
+			{
+				Chunks.push_back(new char[ChunkSize]);
+				nFree = ChunkSize;
+			}
+			ret = Chunks.back() + ChunkSize - nFree;
+			nFree -= len+1;
+		}
+		std::memcpy ( ret, str, len );
+		ret[len] = '\0';
+		return ret;
+	}
+		/// free all the strings
+	void clear ( void )
+	{
+		for ( std::vector<char*>::iterator p = Chunks.begin(), p_end = Chunks.end(); p != p_end; ++p )
+			delete [] *p;
+		Chunks.clear();
+		nFree = 0;
+	}
+}; // TNameArena
+
+/// Implementation of NameSets by open-addressing hash table; template parameter should be derived from TNamedEntry
 template<class T>
 class TNameSet
 {
 protected:	// types
-		/// base type
-	typedef std::map <std::string, T*> NameTree;
-		/// RO iterator
-	typedef typename NameTree::const_iterator const_iterator;
+		/// type of the hash value
+	typedef unsigned int HashValue;
+		/// entry of the hash table
+	struct NameEntry
+	{
+			/// name of the element; points to the name arena
+		const char* first;
+			/// element itself; NULL for the empty entry
+		T* second;
+			/// length of the name
+		unsigned int len;
+			/// hash of the name
+		HashValue hash;
+			/// empty c'tor
+		NameEntry ( void ) : first(NULL), second(NULL), len(0), hash(0) {}
+	}; // NameEntry
+		/// hash table by itself
+	typedef std::vector<NameEntry> NameTable;
 
 public:		// types
-		/// RW iterator
-	typedef typename NameTree::iterator iterator;
+		/// RW iterator: skips empty entries of the table
+	class iterator
+	{
+	protected:	// members
+			/// current entry
+		NameEntry* cur;
+			/// end of the table
+		NameEntry* last;
+
+	protected:	// methods
+			/// skip empty entries
+		void skip ( void )
+		{
+			while ( cur != last && cur->second == NULL )
+				++cur;
+		}
+
+	public:		// interface
+			/// init c'tor
+		iterator ( NameEntry* p, NameEntry* end ) : cur(p), last(end) { skip(); }
+			/// access to the entry
+		NameEntry* operator -> ( void ) const { return cur; }
+			/// access to the entry
+		NameEntry& operator * ( void ) const { return *cur; }
+			/// move to the next element
+		iterator& operator ++ ( void ) { ++cur; skip(); return *this; }
+			/// equality
+		bool operator == ( const iterator& p ) const { return cur == p.cur; }
+			/// inequality
+		bool operator != ( const iterator& p ) const { return cur != p.cur; }
+	}; // iterator
 
 protected:	// members
-		/// Base holding all names
-	NameTree Base;
+		/// hash table of all names; the size is always a power of 2
+	NameTable Base;
+		/// storage for the names
+	TNameArena Names;
+		/// number of the elements in the table
+	unsigned int nElems;
 		/// creator of new name
 	TNameCreator<T>* Creator;
 
@@ -63,25 +169,78 @@ private:	// no copy
 		/// no assignment
 	TNameSet& operator = ( const TNameSet& );
 
+protected:	// methods
+		/// @return hash of the string STR of length LEN (FNV-1a)
+	static HashValue hashName ( const char* str, size_t len )
+	{
+		HashValue h = 2166136261U;
+		for ( const char* p = str, *p_end = str+len; p != p_end; ++p )
+		{
+			h ^= static_cast<unsigned char>(*p);
+			h *= 16777619U;
+		}
+		return h;
+	}
+		/// @return index of the entry with the name ID (or of the empty entry where it should be)
+	size_t locate ( const std::string& id, HashValue h ) const
+	{
+		size_t mask = Base.size()-1, i = h & mask;
+		for ( ; Base[i].second != NULL; i = (i+1) & mask )
+			if ( Base[i].hash == h && Base[i].len == id.size() && std::memcmp ( Base[i].first, id.data(), id.size() ) == 0 )
+				break;
+		return i;
+	}
+		/// put entry E to a table that doesn't contain it
+	void put ( const NameEntry& e )
+	{
+		size_t mask = Base.size()-1, i = e.hash & mask;
+		while ( Base[i].second != NULL )
+			i = (i+1) & mask;
+		Base[i] = e;
+	}
+		/// double the size of the table
+	void grow ( void )
+	{
+		NameTable old ( Base.size() ? 2*Base.size() : 64 );
+		old.swap(Base);
+		for ( typename NameTable::const_iterator p = old.begin(), p_end = old.end(); p != p_end; ++p )
+			if ( p->second != NULL )
+				put(*p);
+	}
+
 public:		// interface
 		/// c'tor (empty)
-	TNameSet ( void ) : Creator(new TNameCreator<T>) {}
+	TNameSet ( void ) : Base(64), nElems(0), Creator(new TNameCreator<T>) {}
 		/// c'tor (with given Name Creating class)
-	TNameSet ( TNameCreator<T>* p ) : Creator(p) {}
+	TNameSet ( TNameCreator<T>* p ) : Base(64), nElems(0), Creator(p) {}
 		/// d'tor (delete all entries)
 	virtual ~TNameSet ( void ) { clear(); delete Creator; }
 
 		/// return pointer to existing id or NULL if no such id defined
-	T* get ( const std::string& id ) const
-	{
-		const_iterator p = Base.find(id);
-		return p == Base.end() ? NULL : p->second;
-	}
+	T* get ( const std::string& id ) const { return Base[locate(id,hashName(id.data(),id.size()))].second; }
 		/// unconditionally add new element with name ID to the set; return new element
 	T* add ( const std::string& id )
 	{
+		HashValue h = hashName(id.data(),id.size());
+		size_t i = locate(id,h);
 		T* pne = Creator->makeEntry(id);
-		Base[id] = pne;
+		if ( Base[i].second != NULL )	// replace the existing entry
+		{
+			Base[i].second = pne;
+			return pne;
+		}
+		// keep the load factor below 1/2
+		if ( 2*(nElems+1) > Base.size() )
+		{
+			grow();
+			i = locate(id,h);
+		}
+		NameEntry& e = Base[i];
+		e.first = Names.intern ( id.data(), id.size() );
+		e.second = pne;
+		e.len = id.size();
+		e.hash = h;
+		++nElems;
 		return pne;
 	}
 		/// Insert id to a nameset (if necessary); @return pointer to id structure created by external creator
@@ -95,28 +254,42 @@ public:		// interface
 		/// remove given entry from the set
 	void remove ( const std::string& id )
 	{
-		iterator p = Base.find(id);
+		size_t mask = Base.size()-1, i = locate(id,hashName(id.data(),id.size()));
 
-		if ( p != Base.end () )	// founs such Id
+		if ( Base[i].second == NULL )	// no such Id
+			return;
+
+		delete Base[i].second;
+		--nElems;
+		// shift the following entries back to keep the probe sequences unbroken
+		for ( size_t j = (i+1) & mask; Base[j].second != NULL; j = (j+1) & mask )
 		{
-			delete p->second;
-			Base.erase(p);
+			size_t home = Base[j].hash & mask;
+			// move entry J to I if its home position is not in (I,J]
+			if ( ( j > i && ( home <= i || home > j ) ) || ( j < i && home <= i && home > j ) )
+			{
+				Base[i] = Base[j];
+				i = j;
+			}
 		}
+		Base[i] = NameEntry();
 	}
 		/// clear name set
 	void clear ( void )
 	{
-		for ( iterator p = Base.begin(); p != Base.end(); ++p )
+		for ( iterator p = begin(), p_end = end(); p != p_end; ++p )
 			delete p->second;
 
-		Base.clear();
+		NameTable(64).swap(Base);
+		Names.clear();
+		nElems = 0;
 	}
 		/// get size of a name set
-	unsigned int size ( void ) const { return Base.size(); }
+	unsigned int size ( void ) const { return nElems; }
 		/// RW begin iterator
-	iterator begin ( void ) { return Base.begin(); }
+	iterator begin ( void ) { return iterator ( &Base[0], &Base[0]+Base.size() ); }
 		/// RW end iterator
-	iterator end ( void ) { return Base.end(); }
+	iterator end ( void ) { return iterator ( &Base[0]+Base.size(), &Base[0]+Base.size() ); }
 }; // TNameSet
 
 #endif
@@ -21,6 +21,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <vector>
 #include "tDLAxiom.h"
+#include "eFaCTPlusPlus.h"
 #include "tExpressionManager.h"
 #include "tSplitVars.h"
 
@@ -44,24 +45,35 @@ protected:	// members
 	size_t axiomToProcess;
 		/// true iff ontology was changed
 	bool changed;
+		/// true iff ontology is locked against changes
+	bool locked;
 
 public:
 	TSplitVars Splits;
 
 public:		// interface
 		/// empty c'tor
-	TOntology ( void ) : axiomId(0), axiomToProcess(0), changed(false) {}
+	TOntology ( void ) : axiomId(0), axiomToProcess(0), changed(false), locked(false) {}
 		/// d'tor
 	~TOntology ( void ) { clear(); }
 
 		/// @return true iff the ontology was changed since its last load
 	bool isChanged ( void ) const { return changed; }
+		/// @return true iff the ontology is locked against changes
+	bool isLocked ( void ) const { return locked; }
+		/// lock/unlock the ontology against changes
+	void setLocked ( bool value ) { locked = value; }
 		/// set the processed marker to the end of the ontology
 	void setProcessed ( void ) { axiomToProcess = Axioms.size(); Retracted.clear(); changed = false; }
 
 		/// add given axiom to the ontology
 	TDLAxiom* add ( TDLAxiom* p )
 	{
+		if ( unlikely(locked) )
+		{
+			delete p;
+			throw EFaCTPlusPlus("Can't add an axiom to a frozen ontology");
+		}
 		p->setId(++axiomId);
 		Axioms.push_back(p);
 		changed = true;
@@ -70,18 +82,14 @@ public:		// interface
 		/// retract given axiom to the ontology
 	void retract ( TDLAxiom* p )
 	{
+		if ( unlikely(locked) )
+			throw EFaCTPlusPlus("Can't retract an axiom from a frozen ontology");
 //		if ( p->getId() <= Axioms.size() && Axioms[p->getId()-1] == p )
 		{
 			changed = true;
 			p->setUsed(false);
 			Retracted.push_back(p);
 		}
-	}
-		/// mark all the axioms as not in the module
-	void clearModuleInfo ( void )
-	{
-		for ( iterator p = Axioms.begin(), p_end = Axioms.end(); p < p_end; ++p )
-			(*p)->setInModule(false);
 	}
 		/// safe clear the ontology (do not remove axioms)
 	void safeClear ( void ) { Axioms.clear(); }
@@ -0,0 +1,147 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TRCCACHE_H
+#define TRCCACHE_H
+
+#include <vector>
+
+#include "dltree.h"
+
+class TConcept;
+
+/// bounded cache DLTree -> TConcept* with structural hashing; the oldest entries are evicted first
+class TRCCache
+{
+protected:	// types
+		/// entry of the cache
+	struct Entry
+	{
+			/// cached tree (owned by the cache)
+		DLTree* tree;
+			/// concept corresponding to the tree
+		TConcept* concept;
+			/// hash of the tree
+		unsigned int hash;
+			/// index of the next entry in the same bucket
+		unsigned int next;
+	}; // Entry
+		/// all entries
+	typedef std::vector<Entry> EntryVector;
+		/// heads of the bucket lists; the size is always a power of 2
+	typedef std::vector<unsigned int> BucketVector;
+
+protected:	// constants
+		/// index of no entry
+	enum { NoEntry = 0xFFFFFFFFU };
+
+protected:	// members
+		/// entries in the order of their addition (cyclic when the cache is full)
+	EntryVector Entries;
+		/// heads of the bucket lists
+	BucketVector Buckets;
+		/// max number of entries in the cache
+	unsigned int maxSize;
+		/// index of the entry to be evicted next when the cache is full
+	unsigned int oldest;
+
+private:	// no copy
+		/// no copy c'tor
+	TRCCache ( const TRCCache& );
+		/// no assignment
+	TRCCache& operator = ( const TRCCache& );
+
+protected:	// methods
+		/// @return reference to the head of the bucket for a hash H
+	unsigned int& bucket ( unsigned int h ) { return Buckets[h & (Buckets.size()-1)]; }
+		/// link entry I into its bucket
+	void link ( unsigned int i )
+	{
+		unsigned int& head = bucket(Entries[i].hash);
+		Entries[i].next = head;
+		head = i;
+	}
+		/// unlink entry I from its bucket
+	void unlink ( unsigned int i )
+	{
+		unsigned int* p = &bucket(Entries[i].hash);
+		while ( *p != i )
+			p = &Entries[*p].next;
+		*p = Entries[i].next;
+	}
+		/// double the number of buckets and relink all entries
+	void rehash ( void )
+	{
+		Buckets.assign ( 2*Buckets.size(), NoEntry );
+		for ( unsigned int i = 0; i < Entries.size(); ++i )
+			link(i);
+	}
+
+public:		// interface
+		/// init c'tor: create a cache with at most SIZE entries
+	explicit TRCCache ( unsigned int size ) : Buckets(16,NoEntry), maxSize(size), oldest(0) {}
+		/// d'tor: delete all cached trees
+	~TRCCache ( void ) { clear(); }
+
+		/// @return concept cached for the tree C; NULL if there is none
+	TConcept* get ( const DLTree* C ) const
+	{
+		unsigned int h = hashTree(C);
+		for ( unsigned int i = Buckets[h & (Buckets.size()-1)]; i != NoEntry; i = Entries[i].next )
+			if ( Entries[i].hash == h && equalTrees ( C, Entries[i].tree ) )
+				return Entries[i].concept;
+		return NULL;
+	}
+		/// add concept CN as a cache entry for a tree C; C is owned by the cache afterwards
+	void add ( DLTree* C, TConcept* CN )
+	{
+		unsigned int i;
+		if ( Entries.size() < maxSize )
+		{
+			i = Entries.size();
+			Entries.push_back(Entry());
+		}
+		else	// evict the oldest entry
+		{
+			i = oldest;
+			oldest = (oldest+1) % maxSize;
+			unlink(i);
+			deleteTree(Entries[i].tree);
+		}
+		Entries[i].tree = C;
+		Entries[i].concept = CN;
+		Entries[i].hash = hashTree(C);
+		link(i);
+		// keep the average bucket length below 1
+		if ( Entries.size() > Buckets.size() )
+			rehash();
+	}
+		/// remove all entries from the cache
+	void clear ( void )
+	{
+		for ( EntryVector::iterator p = Entries.begin(), p_end = Entries.end(); p != p_end; ++p )
+			deleteTree(p->tree);
+		Entries.clear();
+		Buckets.assign ( 16, NoEntry );
+		oldest = 0;
+	}
+		/// @return number of the cached entries
+	size_t size ( void ) const { return Entries.size(); }
+}; // TRCCache
+
+#endif
@@ -20,31 +20,98 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #define TRARESAVESTACK_H
 
 #include <vector>
+#include <cstdlib>
+#include <new>
 
 #include "globaldef.h"
+#include "fpp_assert.h"
 #include "tRestorer.h"
 
 /**
  *	Stack for Saving/Restoring rarely changing information.
  *	Uses self-contained Restorer as a way to update state of object.
+ *	Restorers are allocated in the chunks owned by the stack; as they are
+ *	restored in the reverse order, the memory is reused without any
+ *	allocations after the first few tests.
  */
 class TRareSaveStack
 {
 protected:	// typedefs
+		/// restorer together with the position of the memory top before its allocation
+	struct RestorerEntry
+	{
+			/// restorer
+		TRestorer* p;
+			/// memory top before the restorer was allocated
+		size_t mark;
+	}; // RestorerEntry
 		/// vector of restorers
-	typedef std::vector<TRestorer*> TBaseType;
+	typedef std::vector<RestorerEntry> TBaseType;
+		/// vector of memory chunks
+	typedef std::vector<char*> ChunkVector;
+
+protected:	// constants
+		/// size of a single memory chunk
+	static const size_t ChunkSize = 16384;
+		/// alignment of the restorers
+	static const size_t Align = 2*sizeof(void*);
 
 protected:	// members
 		/// heap of saved objects
 	TBaseType Base;
+		/// memory chunks for restorers
+	ChunkVector Chunks;
+		/// memory top: (chunk number)*ChunkSize + (offset in the chunk)
+	size_t top;
+		/// memory top before the last allocation
+	size_t lastMark;
 		/// current level
 	unsigned int curLevel;
 
+private:	// no copy
+		/// no copy c'tor
+	TRareSaveStack ( const TRareSaveStack& );
+		/// no assignment
+	TRareSaveStack& operator = ( const TRareSaveStack& );
+
+protected:	// methods
+		/// destroy the restorer P; the memory is kept by the stack
+	static void destroy ( TRestorer* p ) { p->~TRestorer(); }
+
 public:		// interface
 		/// empty c'tor: stack will most likely be empty
-	TRareSaveStack ( void ) : curLevel(InitBranchingLevelValue) {}
+	TRareSaveStack ( void ) : top(0), lastMark(0), curLevel(InitBranchingLevelValue) {}
 		/// d'tor
-	~TRareSaveStack ( void ) { clear(); }
+	~TRareSaveStack ( void )
+	{
+		clear();
+		for ( ChunkVector::iterator p = Chunks.begin(), p_end = Chunks.end(); p != p_end; ++p )
+			std::free(*p);
+	}
+
+		/// get SIZE bytes of memory for a restorer
+	void* allocate ( size_t size )
+	{
+#	ifdef ENABLE_CHECKING
+		fpp_assert ( size <= ChunkSize );
+#	endif
+		size = (size+Align-1) & ~(Align-1);
+		lastMark = top;
+		// move to the next chunk if the current one is not enough
+		if ( top%ChunkSize + size > ChunkSize )
+			top += ChunkSize - top%ChunkSize;
+		size_t n = top/ChunkSize;
+		if ( n == Chunks.size() )
+		{
+			char* chunk = static_cast<char*>(std::malloc(ChunkSize));
+			if ( unlikely(chunk == NULL) )
+				throw std::bad_alloc();
+			Chunks.push_back(chunk);
+		}
+		void* ret = Chunks[n] + top%ChunkSize;
+		top += size;
+		return ret;
+	}
 
 	// stack operations
 
@@ -52,11 +119,14 @@ public:		// interface
 	void incLevel ( void ) { ++curLevel; }
 		/// check that stack is empty
 	bool empty ( void ) const { return Base.empty(); }
-		/// add a new object to the stack
+		/// add a new object to the stack; P should be the last allocated restorer
 	void push ( TRestorer* p )
 	{
 		p->setLevel(curLevel);
-		Base.push_back(p);
+		RestorerEntry entry;
+		entry.p = p;
+		entry.mark = lastMark;
+		Base.push_back(entry);
 	}
 		/// get all object from the top of the stack with levels >= LEVEL
 	void restore ( unsigned int level )
@@ -64,24 +134,43 @@ public:		// interface
 		curLevel = level;
 		while ( !Base.empty() )
 		{
-			TRestorer* cur = Base.back();
-			if ( cur->level() <= level )
+			const RestorerEntry& cur = Base.back();
+			if ( cur.p->level() <= level )
 				break;
 
 			// need to restore: restore last element, remove it from stack
-			cur->restore();
-			delete cur;
+			cur.p->restore();
+			destroy(cur.p);
+			top = cur.mark;
 			Base.pop_back();
 		}
+		lastMark = top;
+	}
+		/// release all the memory chunks but the first one; the stack should be empty
+	void shrink ( void )
+	{
+		fpp_assert ( empty() );
+		for ( ChunkVector::iterator p = Chunks.begin() + ( Chunks.empty() ? 0 : 1 ), p_end = Chunks.end(); p != p_end; ++p )
+			std::free(*p);
+		if ( Chunks.size() > 1 )
+			Chunks.erase ( Chunks.begin() + 1, Chunks.end() );
+		top = lastMark = 0;
 	}
 		/// clear stack
 	void clear ( void )
 	{
 		for ( TBaseType::iterator p = Base.begin(), p_end = Base.end(); p < p_end; ++p )
-			delete *p;
+			destroy(p->p);
 		Base.clear();
+		top = lastMark = 0;
 		curLevel = InitBranchingLevelValue;
 	}
 }; // TRareSaveStack
 
+inline void*
+TRestorer :: operator new ( size_t size, TRareSaveStack& stack )
+{
+	return stack.allocate(size);
+}
+
 #endif
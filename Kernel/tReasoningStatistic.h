@@ -0,0 +1,210 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TREASONINGSTATISTIC_H
+#define TREASONINGSTATISTIC_H
+
+#include <ostream>
+
+/// machine-readable reasoning statistic: a fixed set of named counters and timers
+class TReasoningStatistic
+{
+public:		// types
+		/// statistic elements; counters go first, then the gauges (current values) and timers (in seconds).
+		/// Most of the tactic, save/restore and caching counters are gathered only with the gatherStatistics option
+	enum Element
+	{
+		// reasoning tests
+		rsSatTests = 0,
+		rsSubTests,
+		// tactic operations
+		rsTacticCalls,
+		rsUseless,
+		rsIdCalls,
+		rsSingletonCalls,
+		rsOrCalls,
+		rsOrBrCalls,
+		rsAndCalls,
+		rsSomeCalls,
+		rsAllCalls,
+		rsFuncCalls,
+		rsLeCalls,
+		rsGeCalls,
+		rsNNCalls,
+		rsMergeCalls,
+		rsAutoEmptyLookups,
+		rsAutoTransLookups,
+		rsSRuleAdd,
+		rsSRuleFire,
+		// save/restore
+		rsStateSaves,
+		rsStateRestores,
+		rsBackjumps,
+		rsNodeSaves,
+		rsNodeRestores,
+		rsLookups,
+		rsFairnessViolations,
+		// model caching
+		rsCacheTry,
+		rsCacheFailedNoCache,
+		rsCacheFailedShallow,
+		rsCacheFailed,
+		rsCachedSat,
+		rsCachedUnsat,
+		// blocking
+		rsBlockingTests,
+		rsBlockedNodes,
+		// DAG
+		rsDagSize,			// gauge
+		rsDagCacheHits,
+		// completion graph memory (gauges)
+		rsGraphPeakNodes,
+		rsGraphPeakEdges,
+		rsGraphNodes,
+		rsGraphEdges,
+		// timers
+		rsSatTime,
+		rsSubTime,
+		rsPreprocTime,
+		rsConsistTime,
+		rsClassifyTime,
+		// number of elements
+		rsLast
+	};
+
+protected:	// members
+		/// values of all the elements
+	double Values[rsLast];
+
+public:		// interface
+		/// empty c'tor: all values are 0
+	TReasoningStatistic ( void ) { clear(); }
+		/// copy c'tor
+	TReasoningStatistic ( const TReasoningStatistic& stat ) { *this = stat; }
+		/// assignment
+	TReasoningStatistic& operator = ( const TReasoningStatistic& stat )
+	{
+		for ( unsigned int i = 0; i < rsLast; ++i )
+			Values[i] = stat.Values[i];
+		return *this;
+	}
+		/// empty d'tor
+	~TReasoningStatistic ( void ) {}
+
+		/// set all values to 0
+	void clear ( void )
+	{
+		for ( unsigned int i = 0; i < rsLast; ++i )
+			Values[i] = 0;
+	}
+		/// add VALUE to the element E
+	void add ( Element e, double value ) { Values[e] += value; }
+		/// turn the current values into the ones gathered since the values of STAT were taken
+	TReasoningStatistic& operator -= ( const TReasoningStatistic& stat )
+	{
+		// value might decrease if the KB was reloaded in between; keep the new one in this case
+		for ( unsigned int i = 0; i < rsLast; ++i )
+			if ( !isGauge(i) && Values[i] >= stat.Values[i] )
+				Values[i] -= stat.Values[i];
+		return *this;
+	}
+
+	// access
+
+		/// @return value of the element E
+	double get ( Element e ) const { return Values[e]; }
+		/// @return value of the I-th element
+	double operator [] ( unsigned int i ) const { return Values[i]; }
+		/// @return number of elements
+	static unsigned int size ( void ) { return rsLast; }
+		/// @return true iff the I-th element is a gauge, ie its value is not accumulated
+	static bool isGauge ( unsigned int i ) { return i == rsDagSize || ( i >= rsGraphPeakNodes && i < rsSatTime ); }
+		/// @return true iff the I-th element is a timer
+	static bool isTimer ( unsigned int i ) { return i >= rsSatTime && i < rsLast; }
+		/// @return name of the I-th element; NULL if there is no such element
+	static const char* getName ( unsigned int i )
+	{
+		static const char* const Names[rsLast] =
+		{
+			"sat.tests",
+			"sub.tests",
+			"tactic.calls",
+			"tactic.useless",
+			"tactic.id",
+			"tactic.singleton",
+			"tactic.or",
+			"tactic.or.branching",
+			"tactic.and",
+			"tactic.some",
+			"tactic.all",
+			"tactic.func",
+			"tactic.le",
+			"tactic.ge",
+			"tactic.nn",
+			"tactic.merge",
+			"automaton.empty.lookups",
+			"automaton.trans.lookups",
+			"simple.rule.add",
+			"simple.rule.fire",
+			"state.saves",
+			"state.restores",
+			"backjumps",
+			"node.saves",
+			"node.restores",
+			"concept.lookups",
+			"fairness.violations",
+			"cache.tries",
+			"cache.fails.no.cache",
+			"cache.fails.shallow",
+			"cache.fails.merge",
+			"cache.hits.sat",
+			"cache.hits.unsat",
+			"blocking.tests",
+			"blocked.nodes",
+			"dag.size",
+			"dag.cache.hits",
+			"graph.nodes.peak",
+			"graph.edges.peak",
+			"graph.nodes.allocated",
+			"graph.edges.allocated",
+			"time.sat",
+			"time.sub",
+			"time.preprocessing",
+			"time.consistency",
+			"time.classification",
+		};
+		return i < rsLast ? Names[i] : NULL;
+	}
+
+		/// print all non-zero elements as "name value" lines
+	void Print ( std::ostream& o ) const
+	{
+		for ( unsigned int i = 0; i < rsLast; ++i )
+			if ( Values[i] != 0 )
+			{
+				o << getName(i) << " ";
+				if ( isTimer(i) )
+					o << Values[i];
+				else
+					o << static_cast<unsigned long>(Values[i]);
+				o << "\n";
+			}
+	}
+}; // TReasoningStatistic
+
+#endif
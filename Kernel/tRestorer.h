@@ -19,9 +19,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef TRESTORER_H
 #define TRESTORER_H
 
+#include <cstddef>
+
+class TRareSaveStack;
+
 /**
  *	Generic class for restore some property.
- *	Usually inherited class has a pointer to object to be restored and restore info
+ *	Usually inherited class has a pointer to object to be restored and restore info.
+ *	Restorers live in the memory of the save stack they are pushed to.
  */
 class TRestorer
 {
@@ -34,6 +39,13 @@ public:		// interface
 	TRestorer ( void ) {}
 		/// empty d'tor
 	virtual ~TRestorer ( void ) {}
+
+		/// allocate a restorer in the memory of the STACK
+	static void* operator new ( size_t size, TRareSaveStack& stack );
+		/// nothing to do if the c'tor of the restorer fails: the memory is reused by the STACK
+	static void operator delete ( void*, TRareSaveStack& ) {}
+		/// restorers are released only by the stack that owns their memory
+	static void operator delete ( void* ) {}
 		/// restore an object based on saved information
 	virtual void restore ( void ) = 0;
 
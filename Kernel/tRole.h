@@ -448,6 +448,14 @@ public:		// interface
 		TRoleVec RS;
 		fillsComposition ( RS, tree );
 		subCompositions.push_back(RS);
+	}
+		/// @return true iff there is a (non-trivial) role chain that implies the role
+	bool hasSubCompositions ( void ) const
+	{
+		for ( std::vector<TRoleVec>::const_iterator p = subCompositions.begin(), p_end = subCompositions.end(); p != p_end; ++p )
+			if ( !p->empty() )
+				return true;
+		return false;
 	}
 		/// get access to a RA for the role
 	const RoleAutomaton& getAutomaton ( void ) const { return A; }
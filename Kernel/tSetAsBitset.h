@@ -0,0 +1,313 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TSETASBITSET_H
+#define TSETASBITSET_H
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <climits>
+#include <ostream>
+
+#include "globaldef.h"
+#include "fpp_assert.h"
+
+/// implement model cache set as a sorted vector (for small sets) or a bitset (for large ones)
+class TSetAsBitset
+{
+protected:	// types
+		/// word of a bitset
+	typedef unsigned long Word;
+		/// sparse representation: sorted vector of elements
+	typedef std::vector<unsigned int> SparseType;
+		/// dense representation: bitset
+	typedef std::vector<Word> DenseType;
+
+protected:	// constants
+		/// number of bits in a word
+	static const unsigned int WordBits = sizeof(Word)*CHAR_BIT;
+		/// element that is returned when nothing is found
+	static const unsigned int NoElement = UINT_MAX;
+
+protected:	// members
+		/// elements of the set if it is sparse
+	SparseType Sparse;
+		/// bits of the set if it is dense
+	DenseType Dense;
+		/// maximal number of elements
+	unsigned int nElems;
+		/// true iff dense representation is in use
+	bool isDense;
+
+protected:	// methods
+		/// get number of words necessary to keep N bits
+	static size_t nWords ( unsigned int n ) { return (n+WordBits-1)/WordBits; }
+		/// get a mask for the element I in its word
+	static Word mask ( unsigned int i ) { return Word(1) << (i%WordBits); }
+		/// @return number of bits set in a word W
+	static unsigned int bitCount ( Word w )
+	{
+#	if defined(__GNUC__) && (__GNUC__ >= 4)
+		return __builtin_popcountl(w);
+#	else
+		unsigned int n = 0;
+		for ( ; w != 0; w &= w-1 )
+			++n;
+		return n;
+#	endif
+	}
+		/// @return the number of the lowest bit set in a non-zero W
+	static unsigned int lowestBit ( Word w )
+	{
+#	if defined(__GNUC__) && (__GNUC__ >= 4)
+		return __builtin_ctzl(w);
+#	else
+		unsigned int n = 0;
+		for ( ; (w & 1) == 0; w >>= 1 )
+			++n;
+		return n;
+#	endif
+	}
+
+		/// ensure that the bitset could keep element I
+	void ensureDenseSize ( unsigned int i )
+	{
+		if ( i/WordBits >= Dense.size() )
+			Dense.resize(i/WordBits+1);
+	}
+		/// set bit I in a bitset
+	void setBit ( unsigned int i ) { ensureDenseSize(i); Dense[i/WordBits] |= mask(i); }
+		/// switch to the dense representation
+	void makeDense ( void )
+	{
+		isDense = true;
+		Dense.assign ( nWords(nElems), 0 );
+		for ( SparseType::const_iterator p = Sparse.begin(), p_end = Sparse.end(); p != p_end; ++p )
+			setBit(*p);
+		SparseType().swap(Sparse);
+	}
+		/// switch to the dense representation if the sparse one takes more memory
+	void checkDensity ( void )
+	{
+		if ( !isDense && Sparse.size()*sizeof(unsigned int) > nWords(nElems)*sizeof(Word) )
+			makeDense();
+	}
+		/// check whether a sorted vector S intersects with a bitset B
+	static bool intersects ( const SparseType& s, const DenseType& b )
+	{
+		for ( SparseType::const_iterator p = s.begin(), p_end = s.end(); p != p_end; ++p )
+			if ( *p/WordBits < b.size() && ( b[*p/WordBits] & mask(*p) ) )
+				return true;
+		return false;
+	}
+		/// @return the smallest element that is not less than I; NoElement if there is none
+	unsigned int next ( unsigned int i ) const
+	{
+		if ( !isDense )
+		{
+			SparseType::const_iterator p = std::lower_bound ( Sparse.begin(), Sparse.end(), i );
+			return p == Sparse.end() ? NoElement : *p;
+		}
+
+		size_t n = i/WordBits;
+		if ( n >= Dense.size() )
+			return NoElement;
+		// remove bits lower than I in the 1st word
+		Word w = Dense[n] & ~(mask(i)-1);
+		while ( w == 0 )
+		{
+			if ( ++n == Dense.size() )
+				return NoElement;
+			w = Dense[n];
+		}
+		return n*WordBits + lowestBit(w);
+	}
+
+public:		// types
+		/// RO iterator over the elements of the set
+	class const_iterator
+	{
+	protected:	// members
+			/// set to iterate over
+		const TSetAsBitset* set;
+			/// current element
+		unsigned int cur;
+
+	public:		// interface
+			/// init c'tor: point to the first element of S not less than I
+		const_iterator ( const TSetAsBitset* s, unsigned int i ) : set(s), cur ( i == NoElement ? i : s->next(i) ) {}
+			/// get current element
+		unsigned int operator * ( void ) const { return cur; }
+			/// move to the next element
+		const_iterator& operator ++ ( void ) { cur = set->next(cur+1); return *this; }
+			/// equality
+		bool operator == ( const const_iterator& i ) const { return cur == i.cur; }
+			/// inequality
+		bool operator != ( const const_iterator& i ) const { return cur != i.cur; }
+	}; // const_iterator
+
+public:		// interface
+		/// empty c'tor taking max possible number of elements in the set
+	explicit TSetAsBitset ( unsigned int size ) : nElems(size), isDense(false) {}
+		/// copy c'tor
+	TSetAsBitset ( const TSetAsBitset& is ) : Sparse(is.Sparse), Dense(is.Dense), nElems(is.nElems), isDense(is.isDense) {}
+		/// assignment
+	TSetAsBitset& operator= ( const TSetAsBitset& is )
+	{
+		Sparse = is.Sparse;
+		Dense = is.Dense;
+		nElems = is.nElems;
+		isDense = is.isDense;
+		return *this;
+	}
+		/// empty d'tor
+	~TSetAsBitset ( void ) {}
+
+		/// adds given index to the set
+	void insert ( unsigned int i )
+	{
+#	ifdef ENABLE_CHECKING
+		fpp_assert ( i > 0 );
+#	endif
+		if ( isDense )
+		{
+			setBit(i);
+			return;
+		}
+		SparseType::iterator p = std::lower_bound ( Sparse.begin(), Sparse.end(), i );
+		if ( p == Sparse.end() || *p != i )
+		{
+			Sparse.insert ( p, i );
+			checkDensity();
+		}
+	}
+		/// completes the set with [1,n)
+	void completeSet ( void )
+	{
+		if ( !isDense )
+			makeDense();
+		for ( unsigned int i = 1; i < nElems; ++i )
+			setBit(i);
+	}
+		/// adds the given set to the current one
+	TSetAsBitset& operator |= ( const TSetAsBitset& is )
+	{
+		if ( is.empty() )
+			return *this;
+		if ( !isDense && is.isDense )
+			makeDense();
+		if ( isDense )
+		{
+			if ( is.isDense )
+			{
+				if ( Dense.size() < is.Dense.size() )
+					Dense.resize(is.Dense.size());
+				for ( size_t i = 0, n = is.Dense.size(); i < n; ++i )
+					Dense[i] |= is.Dense[i];
+			}
+			else
+				for ( SparseType::const_iterator p = is.Sparse.begin(), p_end = is.Sparse.end(); p != p_end; ++p )
+					setBit(*p);
+			return *this;
+		}
+		// both are sparse: merge the sorted vectors
+		SparseType result;
+		result.reserve ( Sparse.size() + is.Sparse.size() );
+		std::set_union ( Sparse.begin(), Sparse.end(), is.Sparse.begin(), is.Sparse.end(), std::back_inserter(result) );
+		Sparse.swap(result);
+		checkDensity();
+		return *this;
+	}
+		/// clear the set
+	void clear ( void )
+	{
+		SparseType().swap(Sparse);
+		DenseType().swap(Dense);
+		isDense = false;
+	}
+
+		/// check whether the set is empty
+	bool empty ( void ) const { return next(0) == NoElement; }
+		/// check whether I contains in the set
+	bool contains ( unsigned int i ) const
+	{
+		if ( isDense )
+			return i/WordBits < Dense.size() && ( Dense[i/WordBits] & mask(i) ) != 0;
+		return std::binary_search ( Sparse.begin(), Sparse.end(), i );
+	}
+		/// check whether the intersection between the current set and IS is nonempty
+	bool intersects ( const TSetAsBitset& is ) const
+	{
+		if ( isDense && is.isDense )
+		{
+			for ( size_t i = 0, n = std::min ( Dense.size(), is.Dense.size() ); i < n; ++i )
+				if ( Dense[i] & is.Dense[i] )
+					return true;
+			return false;
+		}
+		if ( isDense )
+			return intersects ( is.Sparse, Dense );
+		if ( is.isDense )
+			return intersects ( Sparse, is.Dense );
+
+		if ( Sparse.empty() || is.Sparse.empty() )
+			return false;
+
+		SparseType::const_iterator p1 = Sparse.begin(), p1_end = Sparse.end(), p2 = is.Sparse.begin(), p2_end = is.Sparse.end();
+		while ( p1 != p1_end && p2 != p2_end )
+			if ( *p1 == *p2 )
+				return true;
+			else if ( *p1 < *p2 )
+				++p1;
+			else
+				++p2;
+
+		return false;
+	}
+		/// prints the set in a human-readable form
+	void print ( std::ostream& o ) const
+	{
+		o << "{";
+		if ( !empty() )
+		{
+			const_iterator p = begin(), p_end = end();
+			o << *p;
+			while ( ++p != p_end )
+				o << ',' << *p;
+		}
+		o << "}";
+	}
+	const_iterator begin ( void ) const { return const_iterator ( this, 0 ); }
+	const_iterator end ( void ) const { return const_iterator ( this, NoElement ); }
+
+		/// size of a set
+	size_t size ( void ) const
+	{
+		if ( !isDense )
+			return Sparse.size();
+		size_t n = 0;
+		for ( DenseType::const_iterator p = Dense.begin(), p_end = Dense.end(); p != p_end; ++p )
+			n += bitCount(*p);
+		return n;
+	}
+		/// maximal size of a set
+	unsigned int maxSize ( void ) const { return nElems; }
+}; // TSetAsBitset
+
+#endif
@@ -38,11 +38,12 @@ public:		// interface
 		/// empty c'tor taking max possible number of elements in the set
 	explicit TSetAsTree ( unsigned int size ) : nElems(size) {}
 		/// copy c'tor
-	TSetAsTree ( const TSetAsTree& is ) : Base(is.Base) {}
+	TSetAsTree ( const TSetAsTree& is ) : Base(is.Base), nElems(is.nElems) {}
 		/// assignment
 	TSetAsTree& operator= ( const TSetAsTree& is )
 	{
 		Base = is.Base;
+		nElems = is.nElems;
 		return *this;
 	}
 		/// empty d'tor
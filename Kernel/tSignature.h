@@ -19,9 +19,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef TSIGNATURE_H
 #define TSIGNATURE_H
 
-#include <set>
+#include <vector>
+#include <climits>
 #include <algorithm>
-#include <iterator>
 
 #include "tDLExpression.h"
 
@@ -29,52 +29,79 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 class TSignature
 {
 public:		// types
-		/// set of entities as a base underlying type os a signature
-	typedef std::set<const TNamedEntity*> BaseType;
+		/// vector of entities as a base underlying type of a signature
+	typedef std::vector<const TNamedEntity*> BaseType;
 		/// RO iterator over a set of entities
 	typedef BaseType::const_iterator iterator;
 
+protected:	// types
+		/// word of a bit vector
+	typedef unsigned long BitWord;
+		/// bit vector indexed by the entity id
+	typedef std::vector<BitWord> BitVector;
+
+protected:	// constants
+		/// number of bits in the word
+	static const unsigned int nWordBits = sizeof(BitWord)*CHAR_BIT;
+		/// max size of a signature that is kept without the bit vector (eg, signatures of axioms)
+	static const size_t nSmallSize = 8;
+
 protected:	// members
-		/// set to keep all the elements in signature
-	BaseType Set;
+		/// all the elements of the signature in the order of addition
+	BaseType Elements;
+		/// bit I is set iff the entity with id I is in the signature; empty for small signatures
+	BitVector Bits;
 		/// true if concept TOP-locality; false if concept BOTTOM-locality
 	bool topCLocality;
 		/// true if role TOP-locality; false if role BOTTOM-locality
 	bool topRLocality;
 
 protected:	// methods
+		/// @return word number I of the bit vector
+	BitWord getWord ( size_t i ) const { return i < Bits.size() ? Bits[i] : 0; }
+		/// set the bit for an entity P
+	void setBit ( const TNamedEntity* p )
+	{
+		const size_t i = p->getId() / nWordBits;
+		if ( i >= Bits.size() )
+			Bits.resize ( i+1, 0 );
+		Bits[i] |= BitWord(1) << (p->getId() % nWordBits);
+	}
+		/// clear the bit for an entity P
+	void clearBit ( const TNamedEntity* p )
+	{
+		const size_t i = p->getId() / nWordBits;
+		if ( i < Bits.size() )
+			Bits[i] &= ~(BitWord(1) << (p->getId() % nWordBits));
+	}
 		/// @return true if *THIS \subseteq SIG (\subset if IMPROPER = false )
 	bool subset ( const TSignature& sig, bool improper ) const
 	{
-		iterator p = Set.begin(), p_end = Set.end(), q = sig.Set.begin(), q_end = sig.Set.end();
-		bool proper = false;
-		while ( p != p_end && q != q_end )
+		if ( size() > sig.size() || ( !improper && size() == sig.size() ) )
+			return false;
+		if ( Bits.empty() || sig.Bits.empty() )	// small signature: check its elements
 		{
-			if ( *p < *q )	// something in THIS doesn't exist in SIG
-				return false;
-			if ( *q < *p )
-				++q, proper = true;
-			else
-				++p, ++q;
+			for ( iterator p = begin(), p_end = end(); p != p_end; ++p )
+				if ( !sig.contains(*p) )
+					return false;
+			return true;
 		}
-		if ( p != p_end )	// extra stuff in THIS
-			return false;
-		// here THIS is empty
-		if ( q != q_end )	// there are extra elements in SIG
-			return improper;
-		// both are done; the answer depends on flags
-		return improper ? true : proper;
+		for ( size_t i = 0, n = Bits.size(); i < n; ++i )
+			if ( Bits[i] & ~sig.getWord(i) )	// something in THIS doesn't exist in SIG
+				return false;
+		return true;
 	}
 
 public:		// interface
 		/// empty c'tor
 	TSignature ( void ) : topCLocality(false), topRLocality(false) {}
 		/// copy c'tor
-	TSignature ( const TSignature& copy ) : Set(copy.Set), topCLocality(copy.topCLocality), topRLocality(copy.topRLocality) {}
+	TSignature ( const TSignature& copy ) : Elements(copy.Elements), Bits(copy.Bits), topCLocality(copy.topCLocality), topRLocality(copy.topRLocality) {}
 		/// assignment
 	TSignature& operator= ( const TSignature& copy )
 	{
-		Set = copy.Set;
+		Elements = copy.Elements;
+		Bits = copy.Bits;
 		topCLocality = copy.topCLocality;
 		topRLocality = copy.topRLocality;
 		return *this;
@@ -85,13 +112,33 @@ public:		// interface
 	// add names to signature
 
 		/// add pointer to named object to signature
-	void add ( const TNamedEntity* p ) { Set.insert(p); }
+	void add ( const TNamedEntity* p )
+	{
+		if ( contains(p) )
+			return;
+		Elements.push_back(p);
+		if ( !Bits.empty() )
+			setBit(p);
+		else if ( Elements.size() > nSmallSize )	// the signature is not small anymore: build the bit vector
+			for ( iterator q = begin(), q_end = end(); q != q_end; ++q )
+				setBit(*q);
+	}
 		/// add set of named entities to signature
-	void add ( const BaseType& aSet ) { Set.insert ( aSet.begin(), aSet.end() ); }
+	void add ( const BaseType& aSet )
+	{
+		for ( iterator p = aSet.begin(), p_end = aSet.end(); p != p_end; ++p )
+			add(*p);
+	}
 		/// add another signature to a given one
-	void add ( const TSignature& Sig ) { add(Sig.Set); }
+	void add ( const TSignature& Sig ) { add(Sig.Elements); }
 		/// remove given element from a signature
-	void remove ( const TNamedEntity* p ) { Set.erase(p); }
+	void remove ( const TNamedEntity* p )
+	{
+		if ( !contains(p) )
+			return;
+		Elements.erase ( std::find ( Elements.begin(), Elements.end(), p ) );
+		clearBit(p);
+	}
 		/// set new locality polarity
 	void setLocality ( bool topC, bool topR ) { topCLocality = topC; topRLocality = topR; }
 		/// set new locality polarity
@@ -100,9 +147,9 @@ public:		// interface
 	// comparison
 
 		/// check whether 2 signatures are the same
-	bool operator == ( const TSignature& sig ) const { return Set == sig.Set; }
+	bool operator == ( const TSignature& sig ) const { return size() == sig.size() && subset ( sig, /*improper=*/true ); }
 		/// check whether 2 signatures are different
-	bool operator != ( const TSignature& sig ) const { return Set != sig.Set; }
+	bool operator != ( const TSignature& sig ) const { return !(*this == sig); }
 		/// @return true if *THIS \subset SIG
 	bool operator < ( const TSignature& sig ) const { return subset ( sig, /*improper=*/false ); }
 		/// @return true if *THIS \subseteq SIG
@@ -112,7 +159,12 @@ public:		// interface
 		/// @return true if SIG \subseteq *THIS
 	bool operator >= ( const TSignature& sig ) const { return sig.subset ( *this, /*improper=*/true ); }
 		/// @return true iff signature contains given element
-	bool contains ( const TNamedEntity* p ) const { return Set.count(p) > 0; }
+	bool contains ( const TNamedEntity* p ) const
+	{
+		if ( Bits.empty() )	// small signature
+			return std::find ( Elements.begin(), Elements.end(), p ) != Elements.end();
+		return ( getWord(p->getId() / nWordBits) >> (p->getId() % nWordBits) ) & 1;
+	}
 		/// @return true iff signature contains given element
 	bool contains ( const TDLExpression* p ) const
 	{
@@ -124,14 +176,14 @@ public:		// interface
 		return false;
 	}
 		/// @return size of the signature
-	size_t size ( void ) const { return Set.size(); }
+	size_t size ( void ) const { return Elements.size(); }
 		/// clear the signature
-	void clear ( void ) { Set.clear(); }
+	void clear ( void ) { Elements.clear(); Bits.clear(); }
 
 		/// RO access to the elements of signature
-	iterator begin ( void ) const { return Set.begin(); }
+	iterator begin ( void ) const { return Elements.begin(); }
 		/// RO access to the elements of signature
-	iterator end ( void ) const { return Set.end(); }
+	iterator end ( void ) const { return Elements.end(); }
 
 		/// @return true iff concepts are treated as TOPs
 	bool topCLocal ( void ) const { return topCLocality; }
@@ -143,11 +195,25 @@ public:		// interface
 	bool botRLocal ( void ) const { return !topRLocality; }
 }; // TSignature
 
+/// @return all the elements of S1 that are in S2
 inline TSignature::BaseType
 intersect ( const TSignature& s1, const TSignature& s2 )
 {
 	TSignature::BaseType ret;
-	set_intersection(s1.begin(), s1.end(), s2.begin(), s2.end(), inserter(ret, ret.begin()));
+	for ( TSignature::iterator p = s1.begin(), p_end = s1.end(); p != p_end; ++p )
+		if ( s2.contains(*p) )
+			ret.push_back(*p);
+	return ret;
+}
+
+/// @return all the elements of S1 that are not in S2
+inline TSignature::BaseType
+difference ( const TSignature& s1, const TSignature& s2 )
+{
+	TSignature::BaseType ret;
+	for ( TSignature::iterator p = s1.begin(), p_end = s1.end(); p != p_end; ++p )
+		if ( !s2.contains(*p) )
+			ret.push_back(*p);
 	return ret;
 }
 
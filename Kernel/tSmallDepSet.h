@@ -0,0 +1,216 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2003-2013 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TSMALLDEPSET_H
+#define TSMALLDEPSET_H
+
+#include <climits>
+
+#include "globaldef.h"
+#include "tDepSet.h"
+
+/**
+ *  dep-set implementation that keeps small levels in a single word and
+ *  spills to the shared-tail lists (TDepSetElement) for the large ones.
+ *  The word is either a pointer to a DSE (lowest bit is 0) or a bitset
+ *  of levels, where level I is kept in bit I+1 and the lowest bit is 1.
+ *  The representation is canonical: the list is used iff level() >= MaxBitLevel.
+ */
+class TSmallDepSet
+{
+protected:	// types
+		/// type of the word keeping the dep-set
+	typedef unsigned long Word;
+
+protected:	// constants
+		/// all levels below this one are kept in a bitset
+	static const unsigned int MaxBitLevel = sizeof(Word)*CHAR_BIT-1;
+		/// tag of the bitset representation
+	static const Word BitTag = 1;
+
+protected:	// members
+		/// either the pointer to the DSE or the tagged bitset
+	Word dep;
+
+protected:	// methods
+		/// @return true iff the dep-set is a bitset
+	bool isBits ( void ) const { return (dep & BitTag) != 0; }
+		/// @return pointer to the DSE; valid only if the dep-set is a list
+	TDepSetElement* getList ( void ) const { return reinterpret_cast<TDepSetElement*>(dep); }
+		/// @return the bit of a level L in a bitset
+	static Word levelBit ( unsigned int l ) { return Word(2) << l; }
+		/// @return the number of the highest set bit of a non-zero W
+	static unsigned int highestBit ( Word w )
+	{
+#	if defined(__GNUC__) && (__GNUC__ >= 4)
+		return sizeof(Word)*CHAR_BIT-1-__builtin_clzl(w);
+#	else
+		unsigned int n = 0;
+		while ( w >>= 1 )
+			++n;
+		return n;
+#	endif
+	}
+		/// make the bitset out of the given list; all its levels should be small
+	static Word list2bits ( TDepSetElement* p )
+	{
+		Word ret = 0;
+		for ( ; p; p = p->tail() )
+			ret |= levelBit(p->level());
+		return ret ? ret | BitTag : 0;
+	}
+		/// make the shared list out of the given non-empty bitset, using MANAGER
+	static TDepSetElement* bits2list ( Word w, TDepSetManager* manager )
+	{
+		TDepSetElement* ret = NULL;
+		for ( unsigned int l = 0; l < MaxBitLevel; ++l )
+			if ( w & levelBit(l) )
+				ret = manager->get ( l, ret );
+		return ret;
+	}
+		/// set the dep-set to a list P, converting it to the bitset if possible
+	void setList ( TDepSetElement* p )
+	{
+		if ( p == NULL || p->level() < MaxBitLevel )
+			dep = list2bits(p);
+		else
+			dep = reinterpret_cast<Word>(p);
+	}
+
+public:		// interface
+		/// default c'tor: create empty dep-set
+	TSmallDepSet ( void ) : dep(0) {}
+		/// main c'tor
+	explicit TSmallDepSet ( TDepSetElement* depp ) { setList(depp); }
+		/// copy c'tor
+	TSmallDepSet ( const TSmallDepSet& d ) : dep(d.dep) {}
+		/// assignment
+	TSmallDepSet& operator = ( const TSmallDepSet& d ) { dep = d.dep; return *this; }
+		/// empty d'tor: no need to delete element as it is registered in manager
+	~TSmallDepSet ( void ) {}
+
+	// access methods
+
+		/// return latest branching point in the dep-set
+	unsigned int level ( void ) const
+	{
+		if ( dep == 0 )
+			return 0;
+		if ( isBits() )
+			return highestBit(dep)-1;
+		return getList()->level();
+	}
+	 	/// check if the dep-set is empty
+	bool empty ( void ) const { return dep == 0; }
+		/// check if the dep-set contains given level
+	bool contains ( unsigned int level ) const
+	{
+		if ( isBits() )
+			return level < MaxBitLevel && ( dep & levelBit(level) ) != 0;
+
+		for ( TDepSetElement* p = getList(); p; p = p->tail() )
+			if ( level > p->level() )		// missed one
+				return false;
+			else if ( level == p->level() )	// found one
+				return true;
+
+		// not found
+		return false;
+	}
+		/// check the equivalence of the two dep-sets
+	bool operator == ( const TSmallDepSet& ds ) const { return dep == ds.dep; }
+
+		/// Adds given dep-set to current dep-set
+	void add ( const TSmallDepSet& toAdd )
+	{
+		if ( toAdd.dep == 0 || dep == toAdd.dep )
+			return;
+		if ( dep == 0 )
+		{
+			dep = toAdd.dep;
+			return;
+		}
+		if ( isBits() && toAdd.isBits() )	// most common case
+		{
+			dep |= toAdd.dep;
+			return;
+		}
+		// at least one is a list: merge everything as lists
+		TDepSetElement* l1 = isBits() ? NULL : getList();
+		TDepSetElement* l2 = toAdd.isBits() ? NULL : toAdd.getList();
+		TDepSetManager* manager = l1 ? l1->getManager() : l2->getManager();
+		if ( l1 == NULL )
+			l1 = bits2list ( dep, manager );
+		if ( l2 == NULL )
+			l2 = bits2list ( toAdd.dep, manager );
+		dep = reinterpret_cast<Word>(l1->merge(l2));
+	}
+		/// Adds given dep-set to current dep-set
+	TSmallDepSet& operator += ( const TSmallDepSet& toAdd ) { add(toAdd); return *this; }
+		/// Remove all information from dep-set
+	void clear ( void ) { dep = 0; }
+		/// remove parts of the current dep-set that larger than given level
+	void restrict ( unsigned int level )
+	{
+		if ( empty() )
+			return;
+		if ( isBits() )
+		{
+			if ( level < MaxBitLevel )
+			{
+				// keep levels below LEVEL only
+				dep &= levelBit(level)-1;
+				if ( dep == BitTag )
+					dep = 0;
+			}
+			return;
+		}
+
+		TDepSetElement* p = getList();
+		// find part of the dep-set with level < given
+		while ( p && level <= p->level() )
+			p = p->tail();
+		setList(p);
+	}
+
+		/// Print given dep-set to a standart stream
+	template <class O>
+	void Print ( O& o ) const
+	{
+		if ( empty() )
+			return;
+		o << "{";
+		if ( isBits() )
+		{
+			bool first = true;
+			for ( unsigned int l = 0; l < MaxBitLevel; ++l )
+				if ( dep & levelBit(l) )
+				{
+					if ( !first )
+						o << ',';
+					o << l;
+					first = false;
+				}
+		}
+		else
+			getList()->Print(o);
+		o << "}";
+	}
+}; // TSmallDepSet
+
+#endif
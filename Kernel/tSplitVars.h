@@ -19,6 +19,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef TSPLITVARS_H
 #define TSPLITVARS_H
 
+#include <map>
 #include <vector>
 #include <set>
 
@@ -21,6 +21,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <set>
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <string.h>
 
@@ -185,6 +186,19 @@ public:
 		synonyms.push_back(p);
 		setVertexAsHost(p);
 	}
+		/// remove P from the label of the vertex; the vertex should have synonyms
+	void removeSynonym ( const ClassifiableEntry* p )
+	{
+		if ( p == sample )	// the first synonym becomes a primer
+		{
+			sample = synonyms.front();
+			synonyms.erase(synonyms.begin());
+		}
+		else
+			synonyms.erase ( std::find ( synonyms.begin(), synonyms.end(), p ) );
+	}
+		/// @return true iff the vertex has synonyms
+	bool hasSynonyms ( void ) const { return !synonyms.empty(); }
 		/// clears the vertex
 	void clear ( void )
 	{